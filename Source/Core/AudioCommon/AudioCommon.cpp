@@ -47,6 +47,13 @@ static std::unique_ptr<SoundStream> CreateSoundStreamForBackend(std::string_view
 
 void InitSoundStream(Core::System& system)
 {
+  if (Config::Get(Config::MAIN_AUDIO_OFFLINE_RENDER))
+  {
+    INFO_LOG_FMT(AUDIO, "Rendering audio offline instead of using an audio backend.");
+    system.SetSoundStream(std::make_unique<NullSound>(true));
+    return;
+  }
+
   std::string backend = Config::Get(Config::MAIN_AUDIO_BACKEND);
   std::unique_ptr<SoundStream> sound_stream = CreateSoundStreamForBackend(backend);
 
@@ -207,6 +214,25 @@ void SendAIBuffer(Core::System& system, const short* samples, unsigned int num_s
   }
 }
 
+static NullSound* GetOfflineSoundStream(Core::System& system)
+{
+  auto* const sound_stream = dynamic_cast<NullSound*>(system.GetSoundStream());
+  if (!sound_stream || !sound_stream->IsRenderingOffline())
+    return nullptr;
+  return sound_stream;
+}
+
+bool IsRenderingOffline(Core::System& system)
+{
+  return GetOfflineSoundStream(system) != nullptr;
+}
+
+void RenderOffline(Core::System& system, u64 ticks, u32 ticks_per_second)
+{
+  if (NullSound* sound_stream = GetOfflineSoundStream(system))
+    sound_stream->RenderOffline(ticks, ticks_per_second);
+}
+
 void StartAudioDump(Core::System& system)
 {
   SoundStream* sound_stream = system.GetSoundStream();
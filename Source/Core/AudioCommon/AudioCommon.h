@@ -10,6 +10,7 @@
 
 #include "AudioCommon/Enums.h"
 #include "AudioCommon/SoundStream.h"
+#include "Common/CommonTypes.h"
 
 class Mixer;
 
@@ -32,6 +33,8 @@ bool SupportsVolumeChanges(std::string_view backend);
 void UpdateSoundStream(Core::System& system);
 void SetSoundStreamRunning(Core::System& system, bool running);
 void SendAIBuffer(Core::System& system, const short* samples, unsigned int num_samples);
+bool IsRenderingOffline(Core::System& system);
+void RenderOffline(Core::System& system, u64 ticks, u32 ticks_per_second);
 void StartAudioDump(Core::System& system);
 void StopAudioDump(Core::System& system);
 void IncreaseVolume(Core::System& system, unsigned short offset);
@@ -0,0 +1,106 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/LatencyController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AudioCommon
+{
+// Weights of a new measurement in the averages of the callback interval and its deviation. These
+// are the weights TCP uses to estimate round-trip times.
+constexpr float PERIOD_WEIGHT = 1.0f / 8;
+constexpr float JITTER_WEIGHT = 1.0f / 4;
+// Mean deviations of the callback interval to keep buffered on top of one callback period.
+constexpr float JITTER_MARGIN = 4.0f;
+// How much of the buffer has to be left over for a window before the target is lowered.
+constexpr float MIN_HEADROOM_MS = 1.0f;
+constexpr u64 WINDOW_US = 1000000;
+// Callbacks further apart than this mean the backend was paused, and aren't counted as jitter.
+constexpr u64 MAX_CALLBACK_INTERVAL_US = 500000;
+constexpr float LATENCY_WEIGHT = 1.0f / 16;
+
+LatencyController::LatencyController(unsigned int sample_rate, float max_latency_ms)
+    : m_sample_rate(sample_rate), m_max_latency_ms(max_latency_ms),
+      m_target_latency_ms(max_latency_ms)
+{
+}
+
+void LatencyController::Update(u64 now_us, unsigned int num_samples,
+                               unsigned int buffered_samples, bool underrun)
+{
+  const float callback_ms = num_samples * 1000.0f / m_sample_rate;
+  const float buffered_ms = buffered_samples * 1000.0f / m_sample_rate;
+
+  if (!m_last_callback_us || now_us - *m_last_callback_us > MAX_CALLBACK_INTERVAL_US)
+  {
+    m_period_ms = callback_ms;
+    m_jitter_ms = 0.0f;
+    StartWindow(now_us);
+  }
+  else
+  {
+    const float interval_ms = (now_us - *m_last_callback_us) / 1000.0f;
+    m_jitter_ms += JITTER_WEIGHT * (std::abs(interval_ms - m_period_ms) - m_jitter_ms);
+    m_period_ms += PERIOD_WEIGHT * (interval_ms - m_period_ms);
+  }
+  m_last_callback_us = now_us;
+
+  if (underrun)
+  {
+    m_underrun_count.fetch_add(1, std::memory_order_relaxed);
+    m_target_latency_ms = m_target_latency_ms * 1.5f + 1.0f;
+    StartWindow(now_us);
+  }
+  else
+  {
+    m_window_headroom_ms = std::min(m_window_headroom_ms, buffered_ms - callback_ms);
+    if (now_us - m_window_start_us >= WINDOW_US)
+    {
+      // The buffer never got closer to running out than the headroom, so part of it can go.
+      // Lower the target gradually, as the mixer takes a while to drain the buffer to it.
+      if (m_window_headroom_ms >= MIN_HEADROOM_MS)
+        m_target_latency_ms -= std::min(m_window_headroom_ms / 2, m_target_latency_ms / 4);
+      StartWindow(now_us);
+    }
+  }
+
+  // Every callback needs a whole period of samples, and callbacks may come early.
+  const float min_latency_ms =
+      std::max(MIN_LATENCY_MS, std::max(m_period_ms, callback_ms) + JITTER_MARGIN * m_jitter_ms);
+  m_target_latency_ms =
+      std::min(std::max(m_target_latency_ms, min_latency_ms), m_max_latency_ms);
+
+  const float latency_ms = m_latency_ms.load(std::memory_order_relaxed);
+  m_latency_ms.store(latency_ms + LATENCY_WEIGHT * (buffered_ms + callback_ms - latency_ms),
+                     std::memory_order_relaxed);
+}
+
+void LatencyController::SetMaxLatency(float max_latency_ms)
+{
+  m_max_latency_ms = max_latency_ms;
+  m_target_latency_ms = std::min(m_target_latency_ms, max_latency_ms);
+}
+
+float LatencyController::GetTargetLatency() const
+{
+  return m_target_latency_ms;
+}
+
+float LatencyController::GetLatency() const
+{
+  return m_latency_ms.load(std::memory_order_relaxed);
+}
+
+u64 LatencyController::GetUnderrunCount() const
+{
+  return m_underrun_count.load(std::memory_order_relaxed);
+}
+
+void LatencyController::StartWindow(u64 now_us)
+{
+  m_window_start_us = now_us;
+  m_window_headroom_ms = m_max_latency_ms;
+}
+}  // namespace AudioCommon
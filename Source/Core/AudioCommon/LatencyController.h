@@ -0,0 +1,59 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Decides how much audio the mixer should keep buffered. The target starts at the configured
+// maximum, and is lowered while the audio backend calls back at a steady rate and the buffer never
+// runs low. Jitter in the interval between callbacks keeps a margin above the callback period, and
+// every underrun raises the target again right away.
+class LatencyController
+{
+public:
+  LatencyController(unsigned int sample_rate, float max_latency_ms);
+
+  // Called from the sound stream thread after every backend callback. buffered_samples is the
+  // number of samples that were ready to be mixed when the callback started, and underrun is
+  // whether they ran out before num_samples were mixed.
+  void Update(u64 now_us, unsigned int num_samples, unsigned int buffered_samples, bool underrun);
+
+  void SetMaxLatency(float max_latency_ms);
+
+  // The amount of audio to keep buffered, in milliseconds.
+  float GetTargetLatency() const;
+
+  // The average amount of audio buffered between the emulated hardware and the audio backend,
+  // including one callback's worth, in milliseconds. Thread-safe.
+  float GetLatency() const;
+  // The number of callbacks that ran out of samples. Thread-safe.
+  u64 GetUnderrunCount() const;
+
+  // The smallest target latency, in milliseconds.
+  static constexpr float MIN_LATENCY_MS = 4.0f;
+
+private:
+  void StartWindow(u64 now_us);
+
+  unsigned int m_sample_rate;
+  float m_max_latency_ms;
+  float m_target_latency_ms;
+
+  std::optional<u64> m_last_callback_us;
+  float m_period_ms = 0.0f;
+  float m_jitter_ms = 0.0f;
+
+  // The smallest amount of audio left over after a callback during the current window.
+  u64 m_window_start_us = 0;
+  float m_window_headroom_ms = 0.0f;
+
+  std::atomic<float> m_latency_ms{0.0f};
+  std::atomic<u64> m_underrun_count{0};
+};
+}  // namespace AudioCommon
@@ -10,12 +10,18 @@
 #include "AudioCommon/Enums.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Timer.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "VideoCommon/PerformanceMetrics.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
 {
   switch (quality)
@@ -31,10 +37,159 @@ static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
   }
 }
 
+// Copies stereo samples, swapping the two channels and optionally the byte order of each sample.
+static void ConvertSamples(short* dst, const short* src, u32 num_samples, bool swap_bytes)
+{
+  u32 i = 0;
+#if defined(_M_X86)
+  for (; i + 4 <= num_samples; i += 4)
+  {
+    __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    samples = _mm_shufflelo_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+    samples = _mm_shufflehi_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+    if (swap_bytes)
+      samples = _mm_or_si128(_mm_slli_epi16(samples, 8), _mm_srli_epi16(samples, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), samples);
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 4 <= num_samples; i += 4)
+  {
+    int16x8_t samples = vrev32q_s16(vld1q_s16(src + i * 2));
+    if (swap_bytes)
+      samples = vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(samples)));
+    vst1q_s16(dst + i * 2, samples);
+  }
+#endif
+  for (; i < num_samples; i++)
+  {
+    dst[i * 2] = swap_bytes ? Common::swap16(src[i * 2 + 1]) : src[i * 2 + 1];
+    dst[i * 2 + 1] = swap_bytes ? Common::swap16(src[i * 2]) : src[i * 2];
+  }
+}
+
+// Linearly interpolates between each pair of current and next samples by the fraction of the
+// stereo sample they belong to, scales the results by volumes[channel] / 256 and adds them to mix.
+static void InterpolateSamples(s32* mix, const s16* current, const s16* next, const u16* fracs,
+                               u32 num_samples, s32 volume0, s32 volume1)
+{
+  u32 i = 0;
+#if defined(_M_X86)
+  const __m128i volumes = _mm_setr_epi16(volume0, volume1, volume0, volume1, volume0, volume1,
+                                         volume0, volume1);
+  // Multiplies signed samples by unsigned fractions, giving 32-bit products.
+  const auto multiply = [](__m128i samples, __m128i fractions, __m128i* lo, __m128i* hi) {
+    const __m128i products_lo = _mm_mullo_epi16(samples, fractions);
+    // _mm_mulhi_epi16 treats fractions >= 0x8000 as negative, which takes 0x10000 * sample off.
+    const __m128i products_hi =
+        _mm_add_epi16(_mm_mulhi_epi16(samples, fractions),
+                      _mm_and_si128(samples, _mm_srai_epi16(fractions, 15)));
+    *lo = _mm_unpacklo_epi16(products_lo, products_hi);
+    *hi = _mm_unpackhi_epi16(products_lo, products_hi);
+  };
+
+  for (; i + 4 <= num_samples; i += 4)
+  {
+    const __m128i current_samples =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i * 2));
+    const __m128i next_samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(next + i * 2));
+    const __m128i sample_fracs = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(fracs + i));
+    const __m128i channel_fracs = _mm_unpacklo_epi16(sample_fracs, sample_fracs);
+
+    // (current << 16) + (next - current) * frac, wrapping around like the 32-bit scalar code.
+    __m128i current_lo, current_hi, next_lo, next_hi;
+    multiply(current_samples, channel_fracs, &current_lo, &current_hi);
+    multiply(next_samples, channel_fracs, &next_lo, &next_hi);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i sum_lo = _mm_add_epi32(_mm_unpacklo_epi16(zero, current_samples),
+                                         _mm_sub_epi32(next_lo, current_lo));
+    const __m128i sum_hi = _mm_add_epi32(_mm_unpackhi_epi16(zero, current_samples),
+                                         _mm_sub_epi32(next_hi, current_hi));
+    const __m128i interpolated =
+        _mm_packs_epi32(_mm_srai_epi32(sum_lo, 16), _mm_srai_epi32(sum_hi, 16));
+
+    const __m128i scaled_lo = _mm_mullo_epi16(interpolated, volumes);
+    const __m128i scaled_hi = _mm_mulhi_epi16(interpolated, volumes);
+    s32* const out = mix + i * 2;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<__m128i*>(out)),
+                                   _mm_srai_epi32(_mm_unpacklo_epi16(scaled_lo, scaled_hi), 8)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4),
+                     _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<__m128i*>(out + 4)),
+                                   _mm_srai_epi32(_mm_unpackhi_epi16(scaled_lo, scaled_hi), 8)));
+  }
+#elif defined(_M_ARM_64)
+  const int32x2_t volume_pair = vset_lane_s32(volume1, vdup_n_s32(volume0), 1);
+  const int32x4_t volumes = vcombine_s32(volume_pair, volume_pair);
+  for (; i + 4 <= num_samples; i += 4)
+  {
+    const int16x8_t current_samples = vld1q_s16(current + i * 2);
+    const int16x8_t next_samples = vld1q_s16(next + i * 2);
+    const uint16x4_t sample_fracs = vld1_u16(fracs + i);
+    const uint16x4x2_t channel_fracs = vzip_u16(sample_fracs, sample_fracs);
+
+    for (int half = 0; half < 2; half++)
+    {
+      const int32x4_t current_half = vmovl_s16(half ? vget_high_s16(current_samples) :
+                                                      vget_low_s16(current_samples));
+      const int32x4_t next_half =
+          vmovl_s16(half ? vget_high_s16(next_samples) : vget_low_s16(next_samples));
+      const int32x4_t frac_half = vreinterpretq_s32_u32(vmovl_u16(channel_fracs.val[half]));
+
+      // (current << 16) + (next - current) * frac, wrapping around like the 32-bit scalar code.
+      const int32x4_t sum = vmlaq_s32(vshlq_n_s32(current_half, 16),
+                                      vsubq_s32(next_half, current_half), frac_half);
+      const int32x4_t scaled = vshrq_n_s32(vmulq_s32(vshrq_n_s32(sum, 16), volumes), 8);
+      s32* const out = mix + i * 2 + half * 4;
+      vst1q_s32(out, vaddq_s32(vld1q_s32(out), scaled));
+    }
+  }
+#endif
+  for (; i < num_samples; i++)
+  {
+    for (u32 channel = 0; channel < 2; channel++)
+    {
+      const s32 current_sample = current[i * 2 + channel];
+      const s32 next_sample = next[i * 2 + channel];
+      const u32 sum = (static_cast<u32>(current_sample) << 16) +
+                      static_cast<u32>(next_sample - current_sample) * fracs[i];
+      const s32 interpolated = static_cast<s32>(sum) >> 16;
+      mix[i * 2 + channel] += (interpolated * (channel == 0 ? volume0 : volume1)) >> 8;
+    }
+  }
+}
+
+// Clamps the mixed samples to [-32767, 32767].
+static void ClampSamples(short* samples, const s32* mix, u32 count)
+{
+  u32 i = 0;
+#if defined(_M_X86)
+  const __m128i min = _mm_set1_epi16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mix + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mix + i + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i),
+                     _mm_max_epi16(_mm_packs_epi32(lo, hi), min));
+  }
+#elif defined(_M_ARM_64)
+  const int16x8_t min = vdupq_n_s16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t clamped =
+        vcombine_s16(vqmovn_s32(vld1q_s32(mix + i)), vqmovn_s32(vld1q_s32(mix + i + 4)));
+    vst1q_s16(samples + i, vmaxq_s16(clamped, min));
+  }
+#endif
+  for (; i < count; i++)
+    samples[i] = std::clamp(mix[i], -32767, 32767);
+}
+
 Mixer::Mixer(unsigned int BackendSampleRate)
     : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate),
       m_surround_decoder(BackendSampleRate,
-                         DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY)))
+                         DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY))),
+      m_latency_controller(BackendSampleRate,
+                           static_cast<float>(Config::Get(Config::MAIN_TIMING_VARIANCE)))
 {
   m_config_changed_callback_id = Config::AddConfigChangedCallback([this] { RefreshConfig(); });
   RefreshConfig();
@@ -57,33 +212,18 @@ void Mixer::DoState(PointerWrap& p)
 }
 
 // Executed from sound stream thread
-unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
-                                   bool consider_framelimit, float emulationspeed,
-                                   int timing_variance)
-{
-  unsigned int currentSample = 0;
-
-  // Cache access in non-volatile variable
-  // This is the only function changing the read value, so it's safe to
-  // cache it locally although it's written here.
-  // The writing pointer will be modified outside, but it will only increase,
-  // so we will just ignore new written data while interpolating.
-  // Without this cache, the compiler wouldn't be allowed to optimize the
-  // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
-
-  // render numleft sample pairs to samples[]
-  // advance indexR with sample position
-  // remember fractional offset
-
+void Mixer::MixerFifo::UpdateRatio(bool consider_framelimit, float emulationspeed,
+                                   int target_latency)
+{
   float aid_sample_rate =
       FIXED_SAMPLE_RATE_DIVIDEND / static_cast<float>(m_input_sample_rate_divisor);
   if (consider_framelimit && emulationspeed > 0.0f)
   {
+    const u32 indexR = m_indexR.load(std::memory_order_relaxed);
+    const u32 indexW = m_indexW.load(std::memory_order_acquire);
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
-    u32 low_watermark = (FIXED_SAMPLE_RATE_DIVIDEND * timing_variance) /
+    u32 low_watermark = (FIXED_SAMPLE_RATE_DIVIDEND * target_latency) /
                         (static_cast<u64>(m_input_sample_rate_divisor) * 1000);
     low_watermark = std::min(low_watermark, MAX_SAMPLES / 2);
 
@@ -97,61 +237,85 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     aid_sample_rate = (aid_sample_rate + offset) * emulationspeed;
   }
 
-  const u32 ratio = (u32)(65536.0f * aid_sample_rate / (float)m_mixer->m_sampleRate);
+  m_ratio = (u32)(65536.0f * aid_sample_rate / (float)m_mixer->m_sampleRate);
+}
+
+// Executed from sound stream thread
+unsigned int Mixer::MixerFifo::Mix(s32* mix, unsigned int num_samples)
+{
+  // Only this function changes the read index. The write index will be increased by
+  // PushSamples meanwhile, but we will just ignore new written data while interpolating.
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  const u32 indexW = m_indexW.load(std::memory_order_acquire);
 
-  s32 lvolume = m_LVolume.load();
-  s32 rvolume = m_RVolume.load();
+  const s32 rvolume = m_RVolume.load();
+  const s32 lvolume = m_LVolume.load();
 
-  const auto read_buffer = [this](auto index) {
-    return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
-  };
+  // Gather the two samples to interpolate between for each output sample first, so that the
+  // interpolation itself can be vectorized.
+  std::array<s16, MIX_BLOCK_SIZE * 2> current;
+  std::array<s16, MIX_BLOCK_SIZE * 2> next;
+  std::array<u16, MIX_BLOCK_SIZE> fracs;
+  unsigned int count = 0;
 
   // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  for (; count < num_samples && ((indexW - indexR) & INDEX_MASK) > 2; count++)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
+    current[count * 2] = m_buffer[indexR & INDEX_MASK];
+    current[count * 2 + 1] = m_buffer[(indexR + 1) & INDEX_MASK];
+    next[count * 2] = m_buffer[(indexR + 2) & INDEX_MASK];
+    next[count * 2 + 1] = m_buffer[(indexR + 3) & INDEX_MASK];
+    fracs[count] = static_cast<u16>(m_frac);
+
+    m_frac += m_ratio;
     indexR += 2 * (u16)(m_frac >> 16);
     m_frac &= 0xffff;
   }
 
-  // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  InterpolateSamples(mix, current.data(), next.data(), fracs.data(), count, rvolume, lvolume);
+
+  // Flush cached variable
+  m_indexR.store(indexR, std::memory_order_release);
 
   // Padding
-  short s[2];
-  s[0] = read_buffer((indexR - 1) & INDEX_MASK);
-  s[1] = read_buffer((indexR - 2) & INDEX_MASK);
-  s[0] = (s[0] * rvolume) >> 8;
-  s[1] = (s[1] * lvolume) >> 8;
-  for (; currentSample < numSamples * 2; currentSample += 2)
+  const s16 pad_r = static_cast<s16>((m_buffer[(indexR - 2) & INDEX_MASK] * rvolume) >> 8);
+  const s16 pad_l = static_cast<s16>((m_buffer[(indexR - 1) & INDEX_MASK] * lvolume) >> 8);
+  if (pad_r != 0 || pad_l != 0)
   {
-    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
-    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
-
-    samples[currentSample + 0] = sampleR;
-    samples[currentSample + 1] = sampleL;
+    for (unsigned int i = count; i < num_samples; i++)
+    {
+      mix[i * 2] += pad_r;
+      mix[i * 2 + 1] += pad_l;
+    }
   }
 
-  // Flush cached variable
-  m_indexR.store(indexR);
+  return count;
+}
+
+unsigned int Mixer::MixFifos(short* samples, unsigned int num_samples, bool consider_framelimit,
+                             float emulation_speed, int target_latency)
+{
+  for (MixerFifo* fifo : m_fifos)
+    fifo->UpdateRatio(consider_framelimit, emulation_speed, target_latency);
+
+  unsigned int dma_samples = 0;
+
+  // Mix all fifos in blocks and clamp the sums once, rather than adding each fifo to the output
+  // and clamping it separately.
+  for (unsigned int offset = 0; offset < num_samples; offset += MIX_BLOCK_SIZE)
+  {
+    const unsigned int block_size = std::min(num_samples - offset, MIX_BLOCK_SIZE);
+    std::fill_n(m_mix_buffer.begin(), block_size * 2, 0);
+    for (MixerFifo* fifo : m_fifos)
+    {
+      const unsigned int mixed = fifo->Mix(m_mix_buffer.data(), block_size);
+      if (fifo == &m_dma_mixer)
+        dma_samples += mixed;
+    }
+    ClampSamples(samples + offset * 2, m_mix_buffer.data(), block_size * 2);
+  }
 
-  return actual_sample_count;
+  return dma_samples;
 }
 
 unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
@@ -159,12 +323,12 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   if (!samples)
     return 0;
 
-  memset(samples, 0, num_samples * 2 * sizeof(short));
+  if (m_rendering_offline.load(std::memory_order_relaxed))
+  {
+    std::fill_n(samples, num_samples * 2, 0);
+    return num_samples;
+  }
 
-  // TODO: Determine how emulation speed will be used in audio
-  // const float emulation_speed = std::roundf(g_perf_metrics.GetSpeed()) / 100.f;
-  const float emulation_speed = m_config_emulation_speed;
-  const int timing_variance = m_config_timing_variance;
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -175,19 +339,8 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
                m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples(),
                available_samples, MAX_SAMPLES, num_samples);
 
-    m_scratch_buffer.fill(0);
-
-    m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                    timing_variance);
-    m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                          timing_variance);
-    m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                timing_variance);
-    for (auto& mixer : m_gba_mixers)
-    {
-      mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                timing_variance);
-    }
+    MixFifos(m_scratch_buffer.data(), available_samples, false, m_config_emulation_speed,
+             m_config_timing_variance);
 
     if (!m_is_stretching)
     {
@@ -199,17 +352,39 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    for (auto& mixer : m_gba_mixers)
-      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    // TODO: Determine how emulation speed will be used in audio
+    // const float emulation_speed = std::roundf(g_perf_metrics.GetSpeed()) / 100.f;
+    int target_latency = m_config_timing_variance;
+    if (m_config_audio_low_latency)
+      target_latency = static_cast<int>(std::ceil(m_latency_controller.GetTargetLatency()));
+
+    const unsigned int buffered_samples = m_dma_mixer.AvailableSamples();
+    const unsigned int dma_samples =
+        MixFifos(samples, num_samples, true, m_config_emulation_speed, target_latency);
     m_is_stretching = false;
+
+    // The DMA fifo carries the game's audio. It running out while it was playing means that too
+    // little was buffered. When the game stops playing audio, this counts once.
+    const bool underrun = dma_samples < num_samples && (m_dma_active || dma_samples != 0);
+    m_dma_active = dma_samples == num_samples;
+
+    m_latency_controller.SetMaxLatency(static_cast<float>(m_config_timing_variance));
+    m_latency_controller.Update(Common::Timer::NowUs(), num_samples, buffered_samples, underrun);
   }
 
   return num_samples;
 }
 
+unsigned int Mixer::MixOffline(short* samples, unsigned int num_samples)
+{
+  // Samples are pulled at exactly the rate they are pushed at, so the fifos stay at the same fill
+  // level at any emulation speed. Only the fill level steers the resampling ratio, which keeps the
+  // output the same from run to run.
+  m_rendering_offline.store(true, std::memory_order_relaxed);
+  MixFifos(samples, num_samples, true, 1.0f, OFFLINE_TARGET_LATENCY);
+  return num_samples;
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
@@ -241,31 +416,27 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
-  // Cache access in non-volatile variable
-  // indexR isn't allowed to cache in the audio throttling loop as it
-  // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  // Only this function changes the write index. The read index needs to be loaded each time, so
+  // that the audio throttling loop doesn't deadlock.
+  const u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
-    return;
-
-  // AyuanX: Actual re-sampling work has been moved to sound thread
-  // to alleviate the workload on main thread
-  // and we simply store raw data here to make fast mem copy
-  int over_bytes = num_samples * 4 - (MAX_SAMPLES * 2 - (indexW & INDEX_MASK)) * sizeof(short);
-  if (over_bytes > 0)
+  if (num_samples * 2 + ((indexW - m_indexR.load(std::memory_order_acquire)) & INDEX_MASK) >=
+      MAX_SAMPLES * 2)
   {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4 - over_bytes);
-    memcpy(&m_buffer[0], samples + (num_samples * 4 - over_bytes) / sizeof(short), over_bytes);
-  }
-  else
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
+    return;
   }
 
-  m_indexW.fetch_add(num_samples * 2);
+  // Convert the whole batch to the format Mix reads while copying it into the ring, so that the
+  // sound stream thread doesn't have to convert every sample it reads.
+  const u32 start = indexW & INDEX_MASK;
+  const u32 samples_until_wrap = std::min(num_samples, (MAX_SAMPLES * 2 - start) / 2);
+  ConvertSamples(&m_buffer[start], samples, samples_until_wrap, !m_little_endian);
+  ConvertSamples(&m_buffer[0], samples + samples_until_wrap * 2, num_samples - samples_until_wrap,
+                 !m_little_endian);
+
+  m_indexW.store(indexW + num_samples * 2, std::memory_order_release);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
@@ -430,6 +601,7 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_audio_low_latency = Config::Get(Config::MAIN_AUDIO_LOW_LATENCY);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
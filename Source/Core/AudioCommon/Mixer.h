@@ -7,6 +7,7 @@
 #include <atomic>
 
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/LatencyController.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
@@ -24,6 +25,11 @@ public:
   // Called from audio threads
   unsigned int Mix(short* samples, unsigned int numSamples);
   unsigned int MixSurround(float* samples, unsigned int num_samples);
+  // Called from the emulation thread when rendering audio offline, in lockstep with emulated time
+  // rather than by an audio device. Neither stretches the audio nor adapts the latency, and the
+  // output doesn't depend on the audio settings. Once it has been called, Mix only outputs silence,
+  // so that nothing else takes samples away from the render.
+  unsigned int MixOffline(short* samples, unsigned int num_samples);
 
   // Called from main thread
   void PushSamples(const short* samples, unsigned int num_samples);
@@ -48,6 +54,11 @@ public:
   void StartLogDSPAudio(const std::string& filename);
   void StopLogDSPAudio();
 
+  const AudioCommon::LatencyController& GetLatencyController() const
+  {
+    return m_latency_controller;
+  }
+
   // 54000000 doesn't work here as it doesn't evenly divide with 32000, but 108000000 does
   static constexpr u64 FIXED_SAMPLE_RATE_DIVIDEND = 54000000 * 2;
 
@@ -57,9 +68,19 @@ private:
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
+  // The fill level in ms that the fifos are kept at when rendering offline. This is the default
+  // timing variance, but it doesn't follow the setting.
+  static constexpr int OFFLINE_TARGET_LATENCY = 40;
+
+  // Number of samples mixed at a time. Every fifo is mixed into a block before it is clamped.
+  static constexpr u32 MIX_BLOCK_SIZE = 256;
+
+  static constexpr size_t CACHE_LINE_SIZE = 64;
 
   const unsigned int SURROUND_CHANNELS = 6;
 
+  // Single producer, single consumer ring of stereo samples. Samples are pushed from the
+  // emulation thread, and resampled and mixed from the sound stream thread.
   class MixerFifo final
   {
   public:
@@ -70,8 +91,12 @@ private:
     }
     void DoState(PointerWrap& p);
     void PushSamples(const short* samples, unsigned int num_samples);
-    unsigned int Mix(short* samples, unsigned int numSamples, bool consider_framelimit,
-                     float emulationspeed, int timing_variance);
+    // Updates the resampling ratio used by the following Mix calls, steering the fifo towards
+    // holding target_latency milliseconds of samples.
+    void UpdateRatio(bool consider_framelimit, float emulationspeed, int target_latency);
+    // Resamples num_samples samples and adds them to mix. Once the fifo runs out, the last sample
+    // is repeated. Returns the number of samples that were resampled before running out.
+    unsigned int Mix(s32* mix, unsigned int num_samples);
     void SetInputSampleRateDivisor(unsigned int rate_divisor);
     unsigned int GetInputSampleRateDivisor() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
@@ -82,18 +107,31 @@ private:
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
-    std::array<short, MAX_SAMPLES * 2> m_buffer{};
-    std::atomic<u32> m_indexW{0};
-    std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
+
+    // The indices are kept on separate cache lines, as each is written by a different thread.
+    alignas(CACHE_LINE_SIZE) std::atomic<u32> m_indexW{0};
+
+    // Only used by the sound stream thread.
+    alignas(CACHE_LINE_SIZE) std::atomic<u32> m_indexR{0};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+    u32 m_ratio = 0;
+
+    // Samples are converted to host endianness and to the channel order of the mix output when
+    // they are pushed.
+    alignas(CACHE_LINE_SIZE) std::array<short, MAX_SAMPLES * 2> m_buffer{};
   };
 
   void RefreshConfig();
 
+  // Mixes num_samples samples from every fifo to samples. Returns the number of samples the DMA
+  // fifo had for it.
+  unsigned int MixFifos(short* samples, unsigned int num_samples, bool consider_framelimit,
+                        float emulation_speed, int target_latency);
+
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
   MixerFifo m_streaming_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, false};
   MixerFifo m_wiimote_speaker_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 3000, true};
@@ -101,12 +139,22 @@ private:
                                         MixerFifo{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, true},
                                         MixerFifo{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, true},
                                         MixerFifo{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, true}};
+  const std::array<MixerFifo*, 7> m_fifos{
+      &m_dma_mixer,     &m_streaming_mixer, &m_wiimote_speaker_mixer, &m_gba_mixers[0],
+      &m_gba_mixers[1], &m_gba_mixers[2],   &m_gba_mixers[3],
+  };
   unsigned int m_sampleRate;
 
   bool m_is_stretching = false;
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
+  std::array<s32, MIX_BLOCK_SIZE * 2> m_mix_buffer{};
+
+  AudioCommon::LatencyController m_latency_controller;
+  // Whether the DMA fifo had enough samples for the last callback.
+  bool m_dma_active = false;
+  std::atomic<bool> m_rendering_offline{false};
 
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
@@ -117,6 +165,7 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_audio_low_latency;
 
   size_t m_config_changed_callback_id;
 };
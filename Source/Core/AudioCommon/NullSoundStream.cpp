@@ -3,6 +3,15 @@
 
 #include "AudioCommon/NullSoundStream.h"
 
+#include <algorithm>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
+
 bool NullSound::Init()
 {
   return true;
@@ -16,3 +25,47 @@ bool NullSound::SetRunning(bool running)
 void NullSound::SetVolume(int volume)
 {
 }
+
+void NullSound::RenderOffline(u64 ticks, u32 ticks_per_second)
+{
+  if (!m_render_started)
+  {
+    // The game ID is only known once the game has booted. Each render of a game replaces the
+    // previous one, so that renders of different builds can be compared.
+    const std::string filename = fmt::format("{}{}_mixdump.wav", File::GetUserPath(D_DUMPAUDIO_IDX),
+                                             SConfig::GetInstance().GetGameID());
+    File::CreateFullPath(filename);
+    if (File::Exists(filename))
+      File::Delete(filename);
+
+    const u32 sample_rate_divisor = Mixer::FIXED_SAMPLE_RATE_DIVIDEND / m_mixer->GetSampleRate();
+    if (!m_wave_writer.Start(filename, sample_rate_divisor))
+      m_render_offline = false;
+    else
+      INFO_LOG_FMT(AUDIO, "Rendering audio offline to {}", filename);
+
+    m_render_started = true;
+    m_last_ticks = ticks;
+    return;
+  }
+
+  // Loading a savestate may take emulated time backwards. Continue the render from there.
+  if (ticks < m_last_ticks)
+  {
+    m_last_ticks = ticks;
+    return;
+  }
+
+  m_remainder += (ticks - m_last_ticks) * m_mixer->GetSampleRate();
+  m_last_ticks = ticks;
+  u64 num_samples = m_remainder / ticks_per_second;
+  m_remainder %= ticks_per_second;
+
+  while (num_samples > 0)
+  {
+    const u32 count = static_cast<u32>(std::min<u64>(num_samples, m_buffer.size() / 2));
+    m_mixer->MixOffline(m_buffer.data(), count);
+    m_wave_writer.AddStereoSamples(m_buffer.data(), count);
+    num_samples -= count;
+  }
+}
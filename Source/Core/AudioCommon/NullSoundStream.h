@@ -3,14 +3,39 @@
 
 #pragma once
 
+#include <array>
+
 #include "AudioCommon/SoundStream.h"
+#include "AudioCommon/WaveFile.h"
+#include "Common/CommonTypes.h"
 
 class NullSound final : public SoundStream
 {
 public:
+  NullSound() = default;
+  // When rendering offline, the mixer is pulled in lockstep with emulated time instead of by an
+  // audio device, and its output is written to a wave file in the audio dump directory. The output
+  // doesn't depend on wall clock time or emulation speed.
+  explicit NullSound(bool render_offline) : m_render_offline(render_offline) {}
+
   bool Init() override;
   bool SetRunning(bool running) override;
   void SetVolume(int volume) override;
 
   static bool IsValid() { return true; }
+
+  bool IsRenderingOffline() const { return m_render_offline; }
+
+  // Called from the emulation thread at regular intervals of emulated time when rendering
+  // offline. Mixes the samples for the emulated time that passed since the last call.
+  void RenderOffline(u64 ticks, u32 ticks_per_second);
+
+private:
+  bool m_render_offline = false;
+  bool m_render_started = false;
+  WaveFileWriter m_wave_writer;
+  u64 m_last_ticks = 0;
+  // Emulated ticks times the sample rate that haven't made up a whole sample yet.
+  u64 m_remainder = 0;
+  std::array<short, 1024 * 2> m_buffer{};
 };
@@ -4,6 +4,7 @@
 #include "AudioCommon/WaveFile.h"
 #include "AudioCommon/Mixer.h"
 
+#include <algorithm>
 #include <string>
 
 #include "Common/CommonTypes.h"
@@ -115,6 +116,25 @@ void WaveFileWriter::Write4(const char* ptr)
   file.WriteBytes(ptr, 4);
 }
 
+void WaveFileWriter::AddStereoSamples(const short* sample_data, u32 count)
+{
+  if (!file)
+  {
+    ERROR_LOG_FMT(AUDIO, "WaveFileWriter - file not open.");
+    return;
+  }
+
+  if (skip_silence && std::all_of(sample_data, sample_data + count * 2,
+                                  [](short sample) { return sample == 0; }))
+  {
+    return;
+  }
+
+  // Wave files are little endian, like every host.
+  file.WriteBytes(sample_data, count * 4);
+  audio_size += count * 4;
+}
+
 void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
                                         u32 sample_rate_divisor, int l_volume, int r_volume)
 {
@@ -6,8 +6,7 @@
 // Description: Simple utility class to make it easy to write long 16-bit stereo
 // audio streams to disk.
 // Use Start() to start recording to a file, and AddStereoSamples to add wave data.
-// The float variant will convert from -1.0-1.0 range and clamp.
-// Alternatively, AddSamplesBE for big endian wave data.
+// Alternatively, AddStereoSamplesBE for big endian wave data.
 // If Stop is not called when it destructs, the destructor will call Stop().
 // ---------------------------------------------------------------------------------
 
@@ -34,6 +33,8 @@ public:
   void Stop();
 
   void SetSkipSilence(bool skip) { skip_silence = skip; }
+  // host endian, left channel first, as output by the mixer
+  void AddStereoSamples(const short* sample_data, u32 count);
   // big endian
   void AddStereoSamplesBE(const short* sample_data, u32 count, u32 sample_rate_divisor,
                           int l_volume, int r_volume);
@@ -4,6 +4,7 @@
 #include "Common/Hash.h"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cstring>
 
@@ -20,6 +21,7 @@
 #else
 #include <arm_acle.h>
 #endif
+#include <arm_neon.h>
 #endif
 
 namespace Common
@@ -451,6 +453,226 @@ u64 GetHash64(const u8* src, u32 len, u32 samples)
   return s_texture_hash_func(src, len, samples);
 }
 
+// The full hash consumes the input in 64-byte stripes, feeding each 64-bit lane into one of eight
+// accumulators. The accumulators are scrambled after every block of 16 stripes, so that long
+// inputs don't degrade into a plain sum.
+constexpr size_t FULL_HASH_STRIPE_SIZE = 64;
+constexpr size_t FULL_HASH_SECRET_SIZE = 192;
+constexpr size_t FULL_HASH_STRIPES_PER_BLOCK = (FULL_HASH_SECRET_SIZE - FULL_HASH_STRIPE_SIZE) / 8;
+constexpr size_t FULL_HASH_BLOCK_SIZE = FULL_HASH_STRIPE_SIZE * FULL_HASH_STRIPES_PER_BLOCK;
+
+constexpr u32 FULL_HASH_PRIME32_1 = 0x9E3779B1;
+constexpr u32 FULL_HASH_PRIME32_2 = 0x85EBCA77;
+constexpr u32 FULL_HASH_PRIME32_3 = 0xC2B2AE3D;
+constexpr u64 FULL_HASH_PRIME64_1 = 0x9E3779B185EBCA87;
+constexpr u64 FULL_HASH_PRIME64_2 = 0xC2B2AE3D27D4EB4F;
+constexpr u64 FULL_HASH_PRIME64_3 = 0x165667B19E3779F9;
+constexpr u64 FULL_HASH_PRIME64_4 = 0x85EBCA77C2B2AE63;
+constexpr u64 FULL_HASH_PRIME64_5 = 0x27D4EB2F165667C5;
+
+// Key material mixed into every stripe, generated with splitmix64.
+static constexpr std::array<u8, FULL_HASH_SECRET_SIZE> GenerateFullHashSecret()
+{
+  std::array<u8, FULL_HASH_SECRET_SIZE> secret{};
+  u64 state = FULL_HASH_PRIME64_1;
+  for (size_t i = 0; i < FULL_HASH_SECRET_SIZE; i += 8)
+  {
+    state += 0x9E3779B97F4A7C15;
+    u64 z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    z ^= z >> 31;
+    for (size_t j = 0; j < 8; j++)
+      secret[i + j] = static_cast<u8>(z >> (j * 8));
+  }
+  return secret;
+}
+
+alignas(16) static constexpr std::array<u8, FULL_HASH_SECRET_SIZE> s_full_hash_secret =
+    GenerateFullHashSecret();
+
+static u64 ReadU64(const u8* ptr)
+{
+  u64 value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+#if defined(_M_X86_64)
+
+// Accumulates consecutive stripes, advancing the secret by 8 bytes per stripe. The accumulators are
+// kept in locals, as the input pointer could otherwise alias them.
+static void FullHashAccumulate(u64* acc, const u8* input, const u8* secret, size_t num_stripes)
+{
+  __m128i* const xacc = reinterpret_cast<__m128i*>(acc);
+  __m128i acc_vec[4] = {xacc[0], xacc[1], xacc[2], xacc[3]};
+  for (size_t stripe = 0; stripe < num_stripes; stripe++)
+  {
+    const __m128i* const data_ptr =
+        reinterpret_cast<const __m128i*>(input + stripe * FULL_HASH_STRIPE_SIZE);
+    const __m128i* const key_ptr = reinterpret_cast<const __m128i*>(secret + stripe * 8);
+    for (size_t i = 0; i < 4; i++)
+    {
+      const __m128i data_vec = _mm_loadu_si128(data_ptr + i);
+      const __m128i data_key = _mm_xor_si128(data_vec, _mm_loadu_si128(key_ptr + i));
+      const __m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+      const __m128i product = _mm_mul_epu32(data_key, data_key_hi);
+      const __m128i data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+      acc_vec[i] = _mm_add_epi64(product, _mm_add_epi64(acc_vec[i], data_swap));
+    }
+  }
+  for (size_t i = 0; i < 4; i++)
+    xacc[i] = acc_vec[i];
+}
+
+static void FullHashScramble(u64* acc, const u8* secret)
+{
+  __m128i* const xacc = reinterpret_cast<__m128i*>(acc);
+  const __m128i prime32 = _mm_set1_epi32(static_cast<int>(FULL_HASH_PRIME32_1));
+  for (size_t i = 0; i < 4; i++)
+  {
+    const __m128i key_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+    const __m128i acc_vec =
+        _mm_xor_si128(_mm_xor_si128(xacc[i], _mm_srli_epi64(xacc[i], 47)), key_vec);
+    const __m128i acc_hi = _mm_shuffle_epi32(acc_vec, _MM_SHUFFLE(0, 3, 0, 1));
+    const __m128i product_lo = _mm_mul_epu32(acc_vec, prime32);
+    const __m128i product_hi = _mm_mul_epu32(acc_hi, prime32);
+    xacc[i] = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+  }
+}
+
+#elif defined(_M_ARM_64)
+
+static void FullHashAccumulate(u64* acc, const u8* input, const u8* secret, size_t num_stripes)
+{
+  uint64x2_t acc_vec[4] = {vld1q_u64(acc), vld1q_u64(acc + 2), vld1q_u64(acc + 4),
+                           vld1q_u64(acc + 6)};
+  for (size_t stripe = 0; stripe < num_stripes; stripe++)
+  {
+    const u8* const data_ptr = input + stripe * FULL_HASH_STRIPE_SIZE;
+    const u8* const key_ptr = secret + stripe * 8;
+    for (size_t i = 0; i < 4; i++)
+    {
+      const uint64x2_t data_vec = vreinterpretq_u64_u8(vld1q_u8(data_ptr + i * 16));
+      const uint64x2_t key_vec = vreinterpretq_u64_u8(vld1q_u8(key_ptr + i * 16));
+      const uint64x2_t data_key = veorq_u64(data_vec, key_vec);
+      const uint64x2_t data_swap = vextq_u64(data_vec, data_vec, 1);
+      acc_vec[i] = vaddq_u64(acc_vec[i], data_swap);
+      acc_vec[i] = vmlal_u32(acc_vec[i], vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+    }
+  }
+  for (size_t i = 0; i < 4; i++)
+    vst1q_u64(acc + i * 2, acc_vec[i]);
+}
+
+static void FullHashScramble(u64* acc, const u8* secret)
+{
+  const uint32x2_t prime32 = vdup_n_u32(FULL_HASH_PRIME32_1);
+  for (size_t i = 0; i < 4; i++)
+  {
+    uint64x2_t acc_vec = vld1q_u64(acc + i * 2);
+    const uint64x2_t key_vec = vreinterpretq_u64_u8(vld1q_u8(secret + i * 16));
+    acc_vec = veorq_u64(veorq_u64(acc_vec, vshrq_n_u64(acc_vec, 47)), key_vec);
+    const uint64x2_t product_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(acc_vec, 32), prime32), 32);
+    vst1q_u64(acc + i * 2, vmlal_u32(product_hi, vmovn_u64(acc_vec), prime32));
+  }
+}
+
+#else
+
+static void FullHashAccumulate(u64* acc, const u8* input, const u8* secret, size_t num_stripes)
+{
+  u64 acc_val[8];
+  std::memcpy(acc_val, acc, sizeof(acc_val));
+  for (size_t stripe = 0; stripe < num_stripes; stripe++)
+  {
+    const u8* const data_ptr = input + stripe * FULL_HASH_STRIPE_SIZE;
+    const u8* const key_ptr = secret + stripe * 8;
+    for (size_t i = 0; i < 8; i++)
+    {
+      const u64 data_val = ReadU64(data_ptr + i * 8);
+      const u64 data_key = data_val ^ ReadU64(key_ptr + i * 8);
+      acc_val[i ^ 1] += data_val;
+      acc_val[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+    }
+  }
+  std::memcpy(acc, acc_val, sizeof(acc_val));
+}
+
+static void FullHashScramble(u64* acc, const u8* secret)
+{
+  for (size_t i = 0; i < 8; i++)
+  {
+    u64 acc_val = acc[i];
+    acc_val ^= acc_val >> 47;
+    acc_val ^= ReadU64(secret + i * 8);
+    acc[i] = acc_val * FULL_HASH_PRIME32_1;
+  }
+}
+
+#endif
+
+// Returns the xor of the high and low halves of the 128-bit product.
+static u64 Mul128Fold64(u64 lhs, u64 rhs)
+{
+  const u64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+  const u64 hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+  const u64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+  const u64 hi_hi = (lhs >> 32) * (rhs >> 32);
+
+  const u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  const u64 upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  const u64 lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return upper ^ lower;
+}
+
+u64 GetFullHash64(const u8* src, size_t len)
+{
+  const u8* const secret = s_full_hash_secret.data();
+  alignas(16) u64 acc[8] = {FULL_HASH_PRIME32_3, FULL_HASH_PRIME64_1, FULL_HASH_PRIME64_2,
+                            FULL_HASH_PRIME64_3, FULL_HASH_PRIME64_4, FULL_HASH_PRIME32_2,
+                            FULL_HASH_PRIME64_5, FULL_HASH_PRIME32_1};
+
+  if (len < FULL_HASH_STRIPE_SIZE)
+  {
+    // Short inputs are zero-padded to a single stripe. The length is mixed in below, so padding
+    // can't be confused with trailing zeroes.
+    u8 stripe[FULL_HASH_STRIPE_SIZE] = {};
+    if (len != 0)
+      std::memcpy(stripe, src, len);
+    FullHashAccumulate(acc, stripe, secret, 1);
+  }
+  else
+  {
+    const size_t num_blocks = (len - 1) / FULL_HASH_BLOCK_SIZE;
+    for (size_t block = 0; block < num_blocks; block++)
+    {
+      FullHashAccumulate(acc, src + block * FULL_HASH_BLOCK_SIZE, secret,
+                         FULL_HASH_STRIPES_PER_BLOCK);
+      FullHashScramble(acc, secret + FULL_HASH_SECRET_SIZE - FULL_HASH_STRIPE_SIZE);
+    }
+
+    // Remaining whole stripes of the last block, then the final (possibly overlapping) stripe.
+    const size_t num_stripes =
+        ((len - 1) - num_blocks * FULL_HASH_BLOCK_SIZE) / FULL_HASH_STRIPE_SIZE;
+    FullHashAccumulate(acc, src + num_blocks * FULL_HASH_BLOCK_SIZE, secret, num_stripes);
+    FullHashAccumulate(acc, src + len - FULL_HASH_STRIPE_SIZE,
+                       secret + FULL_HASH_SECRET_SIZE - FULL_HASH_STRIPE_SIZE - 7, 1);
+  }
+
+  u64 result = static_cast<u64>(len) * FULL_HASH_PRIME64_1;
+  for (size_t i = 0; i < 4; i++)
+  {
+    result += Mul128Fold64(acc[i * 2] ^ ReadU64(secret + 11 + i * 16),
+                           acc[i * 2 + 1] ^ ReadU64(secret + 11 + i * 16 + 8));
+  }
+
+  result ^= result >> 37;
+  result *= 0x165667919E3779F9;
+  result ^= result >> 32;
+  return result;
+}
+
 u32 StartCRC32()
 {
   return crc32_z(0L, Z_NULL, 0);
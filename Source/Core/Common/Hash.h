@@ -17,6 +17,11 @@ u32 HashEctor(const u8* data, size_t len);
 // Specialized hash function used for the texture cache
 u64 GetHash64(const u8* src, u32 len, u32 samples);
 
+// Fast hash over every byte of the input, used by the texture cache when no sampling is requested.
+// Follows the structure of XXH3 (wide 64-bit accumulators over 64-byte stripes), and produces the
+// same result on all hosts.
+u64 GetFullHash64(const u8* src, size_t len);
+
 u32 StartCRC32();
 u32 UpdateCRC32(u32 crc, const u8* data, size_t len);
 u32 ComputeCRC32(const u8* data, size_t len);
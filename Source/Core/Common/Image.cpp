@@ -4,6 +4,7 @@
 #include "Common/Image.h"
 
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -28,8 +29,7 @@ static auto make_spng_ctx(int flags)
   return std::unique_ptr<spng_ctx, decltype(&spng_free)>(spng_ctx_new(flags), spng_free);
 }
 
-bool LoadPNG(const std::vector<u8>& input, std::vector<u8>* data_out, u32* width_out,
-             u32* height_out)
+bool LoadPNG(std::span<const u8> input, std::vector<u8>* data_out, u32* width_out, u32* height_out)
 {
   auto ctx = make_spng_ctx(0);
   if (!ctx)
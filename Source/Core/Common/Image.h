@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -10,8 +11,7 @@
 
 namespace Common
 {
-bool LoadPNG(const std::vector<u8>& input, std::vector<u8>* data_out, u32* width_out,
-             u32* height_out);
+bool LoadPNG(std::span<const u8> input, std::vector<u8>* data_out, u32* width_out, u32* height_out);
 
 enum class ImageByteFormat
 {
@@ -0,0 +1,411 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "Common/Version.h"
+
+// On disk format:
+// header{
+// u32 'DCIX';
+// char version[40];  // scm rev
+// u16 sizeof(key_type);
+// u16 sizeof(value_type);
+// u32 index_entry_count;
+// u32 reserved;
+// u64 log_offset;
+//}
+
+// index_entry[index_entry_count]{  // sorted by the bytes of the key
+// key_type key;
+// u32 value_size;
+// u64 value_offset;
+//}
+
+// value_type[] values;  // referenced by the index entries
+
+// log_record{  // appended since the file was last compacted, until log_offset
+// u32 value_size;
+// key_type key;
+// value_type[value_size] value;
+// u32 record_number;
+//}
+
+// Key-value store with a sorted key index, for caches which are too large to read in full when
+// they are opened. Opening only reads the index; the values are memory-mapped, and only read when
+// they are looked up.
+//
+// New entries are appended to a log at the end of the file, which is read in full when the file is
+// opened. Compact() merges the log into the index and drops values which have been replaced, by
+// writing a new file and atomically replacing the old one with it. Close() does this once the log
+// has grown large compared to the index.
+//
+// Keys are compared by their bytes, so K must not contain uninitialized padding.
+// Values are returned as pointers into the mapping, so V must not require any alignment.
+
+// K and V are some POD type
+// K : the key type
+// V : value array type
+template <typename K, typename V>
+class IndexedDiskCache
+{
+public:
+  IndexedDiskCache() = default;
+  ~IndexedDiskCache() { Close(); }
+
+  IndexedDiskCache(const IndexedDiskCache&) = delete;
+  IndexedDiskCache& operator=(const IndexedDiskCache&) = delete;
+
+  // Opens the cache for lookups and appending, recreating it if it is missing or invalid.
+  // Returns the number of entries.
+  u32 Open(const std::string& filename)
+  {
+    static_assert(std::is_trivially_copyable_v<K>, "K must be a trivially copyable type");
+    static_assert(std::is_trivially_copyable_v<V>, "V must be a trivially copyable type");
+    static_assert(alignof(V) == 1, "V must not require alignment");
+
+    Close();
+    m_filename = filename;
+
+    if (m_mapping.Open(filename) &&
+        ParseFile(m_mapping.GetData(), m_mapping.GetSize(), &m_index, &m_append_offset,
+                  &m_log_record_count, &m_superseded_count) &&
+        m_file.Open(filename, "r+b", File::SharedAccess::Read) &&
+        m_file.Seek(m_append_offset, File::SeekOrigin::Begin))
+    {
+      return static_cast<u32>(m_index.size());
+    }
+
+    // Failed to open the file, or it is invalid. Recreate it.
+    m_file.Close();
+    m_mapping.Close();
+    m_index.clear();
+    m_log_record_count = 0;
+    m_superseded_count = 0;
+
+    const Header header = CreateHeader(0, sizeof(Header));
+    m_file.Open(filename, "wb");
+    m_file.WriteArray(&header, 1);
+    m_append_offset = sizeof(Header);
+    return 0;
+  }
+
+  bool IsOpen() const { return m_file.IsOpen(); }
+
+  // Returns the value stored for the key when the cache was opened, or nullptr if there is none.
+  // Values appended since then are not returned. This only reads state that is fixed while the
+  // cache is open, so it can be called from any thread, including concurrently with Append().
+  const V* Lookup(const K& key, u32* value_size) const
+  {
+    const Entry* entry = FindEntry(key);
+    if (!entry)
+      return nullptr;
+
+    *value_size = entry->value_size;
+    return reinterpret_cast<const V*>(m_mapping.GetData() + entry->value_offset);
+  }
+
+  // Returns true if a value is stored for the key, including values appended since opening.
+  bool Contains(const K& key) const
+  {
+    return FindEntry(key) != nullptr || m_appended_keys.find(key) != m_appended_keys.end();
+  }
+
+  // Calls func(key, value, value_size) for every entry stored when the cache was opened, in the
+  // order of the keys' bytes.
+  template <typename F>
+  void ForEachEntry(F func) const
+  {
+    for (const Entry& entry : m_index)
+    {
+      func(entry.key, reinterpret_cast<const V*>(m_mapping.GetData() + entry.value_offset),
+           entry.value_size);
+    }
+  }
+
+  // Appends a key-value pair to the store. If the key is already stored, the new value replaces
+  // the old one once the cache is reopened.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    if (!m_file.IsOpen())
+      return;
+
+    if (Contains(key))
+      m_superseded_count++;
+    else
+      m_appended_keys.insert(key);
+
+    m_file.WriteArray(&value_size, 1);
+    m_file.WriteArray(&key, 1);
+    m_file.WriteArray(value, value_size);
+    m_log_record_count++;
+    m_file.WriteArray(&m_log_record_count, 1);
+  }
+
+  void Sync() { m_file.Flush(); }
+
+  // Rewrites the file with every entry in the sorted index, and reopens it.
+  bool Compact()
+  {
+    if (!m_file.IsOpen())
+      return false;
+
+    const std::string filename = m_filename;
+    const bool result = WriteCompactedFile();
+    Open(filename);
+    return result;
+  }
+
+  void Close()
+  {
+    // Compacting rewrites the whole file, so only do it once reading the log on open costs a
+    // noticeable fraction of reading the index, or values have been replaced.
+    if (m_file.IsOpen() && (m_superseded_count != 0 || m_log_record_count * 4 > m_index.size()))
+      WriteCompactedFile();
+
+    m_file.Close();
+    m_mapping.Close();
+    m_index.clear();
+    m_appended_keys.clear();
+    m_filename.clear();
+    m_append_offset = 0;
+    m_log_record_count = 0;
+    m_superseded_count = 0;
+  }
+
+private:
+  struct Header
+  {
+    u32 id;
+    char ver[40];
+    u16 key_t_size;
+    u16 value_t_size;
+    u32 index_entry_count;
+    u32 reserved;
+    u64 log_offset;
+  };
+
+  struct Entry
+  {
+    K key;
+    u32 value_size;
+    u64 value_offset;
+  };
+
+  struct KeyLess
+  {
+    bool operator()(const K& lhs, const K& rhs) const
+    {
+      return std::memcmp(&lhs, &rhs, sizeof(K)) < 0;
+    }
+  };
+
+  static constexpr size_t INDEX_ENTRY_SIZE = sizeof(K) + sizeof(u32) + sizeof(u64);
+
+  static Header CreateHeader(u32 index_entry_count, u64 log_offset)
+  {
+    Header header{};
+    // Null-terminator is intentionally not copied.
+    std::memcpy(&header.id, "DCIX", sizeof(u32));
+    std::memcpy(header.ver, Common::GetScmRevGitStr().c_str(),
+                std::min(Common::GetScmRevGitStr().size(), sizeof(header.ver)));
+    header.key_t_size = sizeof(K);
+    header.value_t_size = sizeof(V);
+    header.index_entry_count = index_entry_count;
+    header.log_offset = log_offset;
+    return header;
+  }
+
+  const Entry* FindEntry(const K& key) const
+  {
+    const auto it = std::lower_bound(
+        m_index.begin(), m_index.end(), key,
+        [](const Entry& entry, const K& value) { return KeyLess()(entry.key, value); });
+    if (it == m_index.end() || KeyLess()(key, it->key))
+      return nullptr;
+
+    return &*it;
+  }
+
+  // Reads the index and the log, and merges them into a single sorted index.
+  static bool ParseFile(const u8* data, u64 size, std::vector<Entry>* entries, u64* append_offset,
+                        u32* log_record_count, u32* superseded_count)
+  {
+    Header header;
+    if (size < sizeof(Header))
+      return false;
+    std::memcpy(&header, data, sizeof(Header));
+
+    const Header expected_header = CreateHeader(0, 0);
+    if (header.id != expected_header.id ||
+        std::memcmp(header.ver, expected_header.ver, sizeof(header.ver)) != 0 ||
+        header.key_t_size != expected_header.key_t_size ||
+        header.value_t_size != expected_header.value_t_size)
+    {
+      return false;
+    }
+
+    const u64 index_end = sizeof(Header) + u64{header.index_entry_count} * INDEX_ENTRY_SIZE;
+    if (index_end > header.log_offset || header.log_offset > size)
+      return false;
+
+    entries->resize(header.index_entry_count);
+    const u8* index_data = data + sizeof(Header);
+    for (Entry& entry : *entries)
+    {
+      std::memcpy(&entry.key, index_data, sizeof(K));
+      std::memcpy(&entry.value_size, index_data + sizeof(K), sizeof(u32));
+      std::memcpy(&entry.value_offset, index_data + sizeof(K) + sizeof(u32), sizeof(u64));
+      index_data += INDEX_ENTRY_SIZE;
+
+      if (entry.value_offset < index_end || entry.value_offset > header.log_offset ||
+          u64{entry.value_size} * sizeof(V) > header.log_offset - entry.value_offset)
+      {
+        return false;
+      }
+    }
+
+    // Read the log, stopping at the first incomplete record.
+    std::vector<Entry> log_entries;
+    u64 offset = header.log_offset;
+    u32 record_count = 0;
+    while (offset + sizeof(u32) + sizeof(K) <= size)
+    {
+      u32 value_size;
+      std::memcpy(&value_size, data + offset, sizeof(u32));
+      const u64 value_offset = offset + sizeof(u32) + sizeof(K);
+      const u64 next_offset = value_offset + u64{value_size} * sizeof(V) + sizeof(u32);
+      if (next_offset > size)
+        break;
+
+      u32 record_number;
+      std::memcpy(&record_number, data + next_offset - sizeof(u32), sizeof(u32));
+      if (record_number != record_count + 1)
+        break;
+
+      Entry& entry = log_entries.emplace_back();
+      std::memcpy(&entry.key, data + offset + sizeof(u32), sizeof(K));
+      entry.value_size = value_size;
+      entry.value_offset = value_offset;
+
+      record_count++;
+      offset = next_offset;
+    }
+    *append_offset = offset;
+    *log_record_count = record_count;
+    *superseded_count = 0;
+
+    if (log_entries.empty())
+      return true;
+
+    // Later records replace earlier ones with the same key, both in the log and in the index.
+    std::stable_sort(
+        log_entries.begin(), log_entries.end(),
+        [](const Entry& lhs, const Entry& rhs) { return KeyLess()(lhs.key, rhs.key); });
+    std::vector<Entry> merged;
+    merged.reserve(entries->size() + log_entries.size());
+    auto index_it = entries->begin();
+    for (auto log_it = log_entries.begin(); log_it != log_entries.end(); ++log_it)
+    {
+      if (log_it + 1 != log_entries.end() && !KeyLess()(log_it->key, (log_it + 1)->key))
+      {
+        (*superseded_count)++;
+        continue;
+      }
+
+      while (index_it != entries->end() && KeyLess()(index_it->key, log_it->key))
+        merged.push_back(*index_it++);
+      if (index_it != entries->end() && !KeyLess()(log_it->key, index_it->key))
+      {
+        (*superseded_count)++;
+        ++index_it;
+      }
+      merged.push_back(*log_it);
+    }
+    merged.insert(merged.end(), index_it, entries->end());
+    *entries = std::move(merged);
+    return true;
+  }
+
+  // Writes every current entry to a new file, which then replaces the open one. All handles to
+  // the open file are closed, even on failure.
+  bool WriteCompactedFile()
+  {
+    m_file.Flush();
+    m_file.Close();
+    m_mapping.Close();
+
+    // Map the file again, so that the entries appended since opening are included.
+    File::MappedFile mapping;
+    std::vector<Entry> entries;
+    u64 append_offset;
+    u32 log_record_count;
+    u32 superseded_count;
+    if (!mapping.Open(m_filename) ||
+        !ParseFile(mapping.GetData(), mapping.GetSize(), &entries, &append_offset,
+                   &log_record_count, &superseded_count))
+    {
+      return false;
+    }
+
+    const u64 index_end = sizeof(Header) + u64{entries.size()} * INDEX_ENTRY_SIZE;
+    u64 value_offset = index_end;
+    std::vector<u8> index(entries.size() * INDEX_ENTRY_SIZE);
+    u8* index_data = index.data();
+    for (const Entry& entry : entries)
+    {
+      std::memcpy(index_data, &entry.key, sizeof(K));
+      std::memcpy(index_data + sizeof(K), &entry.value_size, sizeof(u32));
+      std::memcpy(index_data + sizeof(K) + sizeof(u32), &value_offset, sizeof(u64));
+      index_data += INDEX_ENTRY_SIZE;
+      value_offset += u64{entry.value_size} * sizeof(V);
+    }
+
+    const std::string temp_filename = m_filename + ".tmp";
+    const Header header = CreateHeader(static_cast<u32>(entries.size()), value_offset);
+    File::IOFile temp_file(temp_filename, "wb");
+    bool success =
+        temp_file.WriteArray(&header, 1) && temp_file.WriteBytes(index.data(), index.size());
+    for (const Entry& entry : entries)
+    {
+      if (!success)
+        break;
+      success = temp_file.WriteBytes(mapping.GetData() + entry.value_offset,
+                                     u64{entry.value_size} * sizeof(V));
+    }
+    success &= temp_file.Close();
+    mapping.Close();
+
+    if (!success || !File::RenameSync(temp_filename, m_filename))
+    {
+      File::Delete(temp_filename);
+      return false;
+    }
+
+    return true;
+  }
+
+  std::string m_filename;
+  File::IOFile m_file;
+  File::MappedFile m_mapping;
+
+  // Sorted index of the entries stored when the cache was opened.
+  std::vector<Entry> m_index;
+  // Keys appended since opening which are not in m_index.
+  std::set<K, KeyLess> m_appended_keys;
+
+  u64 m_append_offset = 0;
+  u32 m_log_record_count = 0;
+  u32 m_superseded_count = 0;
+};
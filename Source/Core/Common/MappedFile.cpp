@@ -0,0 +1,110 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/Logging/Log.h"
+
+namespace File
+{
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+  Close();
+
+#ifdef _WIN32
+  // Allow the file to be written and replaced while it is mapped.
+  const HANDLE file =
+      CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ,
+                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                  FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The mapping keeps a reference to the file, so the file handle isn't needed past this point.
+  m_mapping_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!m_mapping_handle)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to create file mapping for {}: {}", filename,
+                  GetLastErrorString());
+    return false;
+  }
+
+  m_data = static_cast<const u8*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+  if (!m_data)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to map {}: {}", filename, GetLastErrorString());
+    CloseHandle(m_mapping_handle);
+    m_mapping_handle = nullptr;
+    return false;
+  }
+  m_size = static_cast<u64>(size.QuadPart);
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    return false;
+
+  struct stat file_info;
+  if (fstat(fd, &file_info) != 0 || file_info.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  // The mapping stays valid after the file descriptor is closed.
+  const size_t size = static_cast<size_t>(file_info.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to map {}: {}", filename, LastStrerrorString());
+    return false;
+  }
+  m_data = static_cast<const u8*>(data);
+  m_size = size;
+#endif
+
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  munmap(const_cast<u8*>(m_data), static_cast<size_t>(m_size));
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+}  // namespace File
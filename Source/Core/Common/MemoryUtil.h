@@ -34,5 +34,7 @@ void ReadProtectMemory(void* ptr, size_t size);
 void WriteProtectMemory(void* ptr, size_t size, bool executable = false);
 void UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute = false);
 size_t MemPhysical();
+// Returns the granularity at which memory protection can be changed.
+size_t PageSize();
 
 }  // namespace Common
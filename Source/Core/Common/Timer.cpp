@@ -29,6 +29,11 @@ static auto steady_time_now()
   return time_now<std::chrono::steady_clock, Duration>();
 }
 
+u64 Timer::NowNs()
+{
+  return steady_time_now<std::chrono::nanoseconds>();
+}
+
 u64 Timer::NowUs()
 {
   return steady_time_now<std::chrono::microseconds>();
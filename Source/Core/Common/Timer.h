@@ -10,6 +10,7 @@ namespace Common
 class Timer
 {
 public:
+  static u64 NowNs();
   static u64 NowUs();
   static u64 NowMs();
 
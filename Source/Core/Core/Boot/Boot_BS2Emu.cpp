@@ -312,7 +312,7 @@ bool CBoot::EmulatedBS2_GC(Core::System& system, const DiscIO::VolumeDisc& volum
   {
     // Load game into RAM, like on the actual Triforce
     u8* dimm_disc = AMBaseboard::InitDIMM();
-    volume.Read( 0, 0x20000000, dimm_disc, DiscIO::PARTITION_NONE );
+    volume.ReadBulk( 0, 0x20000000, dimm_disc, DiscIO::PARTITION_NONE );
 
   // Triforce disc register obfucation
     AMBaseboard::InitKeys( memory.Read_U32(0), memory.Read_U32(4), memory.Read_U32(8) );
@@ -66,6 +66,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_AUDIO_LATENCY.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH_LATENCY.GetLocation(),
+      &Config::MAIN_AUDIO_LOW_LATENCY.GetLocation(),
       &Config::MAIN_OVERCLOCK.GetLocation(),
       &Config::MAIN_OVERCLOCK_ENABLE.GetLocation(),
       &Config::MAIN_RAM_OVERRIDE_ENABLE.GetLocation(),
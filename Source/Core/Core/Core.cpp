@@ -40,6 +40,7 @@
 
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -55,6 +56,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -359,6 +361,14 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   if (fastmem_enabled)
     EMM::InstallExceptionHandler();  // Let's run under memory watch
 
+  // Write tracking relies on the exception handler, so it is only available alongside fastmem.
+  auto& memory = Core::System::GetInstance().GetMemory();
+  if (fastmem_enabled && Config::Get(Config::GFX_HACK_TRACK_TEXTURE_WRITES) &&
+      Memory::MemoryManager::IsWriteTrackingSupported())
+  {
+    memory.SetWriteTrackingEnabled(true);
+  }
+
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher = std::make_unique<MemoryWatcher>();
 #endif
@@ -404,6 +414,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
 
   s_is_started = false;
 
+  memory.SetWriteTrackingEnabled(false);
   if (fastmem_enabled)
     EMM::UninstallExceptionHandler();
 
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -263,6 +264,16 @@ void CoreTimingManager::RemoveAllEvents(EventType* event_type)
   RemoveEvent(event_type);
 }
 
+std::optional<s64> CoreTimingManager::GetTicksUntilEvent(EventType* event_type) const
+{
+  auto itr = std::find_if(m_event_queue.begin(), m_event_queue.end(),
+                          [&](const Event& e) { return e.type == event_type; });
+  if (itr == m_event_queue.end())
+    return std::nullopt;
+
+  return itr->time - static_cast<s64>(GetTicks());
+}
+
 void CoreTimingManager::ForceExceptionCheck(s64 cycles)
 {
   cycles = std::max<s64>(0, cycles);
@@ -17,6 +17,7 @@
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -104,6 +105,10 @@ public:
   // We only permit one event of each type in the queue at a time.
   void RemoveEvent(EventType* event_type);
   void RemoveAllEvents(EventType* event_type);
+  // Returns how many ticks are left until the event is due, or nothing if it isn't scheduled.
+  // Like RemoveEvent, this doesn't see events scheduled from other threads that haven't been moved
+  // into the queue yet.
+  std::optional<s64> GetTicksUntilEvent(EventType* event_type) const;
 
   // Advance must be called at the beginning of dispatcher loops, not the end. Advance() ends
   // the previous timing slice and begins the next one, you must Advance from the previous
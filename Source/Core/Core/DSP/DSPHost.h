@@ -30,4 +30,6 @@ void InterruptRequest();
 void CodeLoaded(DSPCore& dsp, u32 addr, size_t size);
 void CodeLoaded(DSPCore& dsp, const u8* ptr, size_t size);
 void UpdateDebugger();
+// Where the JIT keeps the blocks a ucode entered, or an empty string to not keep them.
+std::string GetBlockCachePath(u32 iram_crc);
 }  // namespace DSP::Host
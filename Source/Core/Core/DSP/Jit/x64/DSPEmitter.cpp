@@ -11,6 +11,8 @@
 #include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 
 #include "Core/DSP/DSPAnalyzer.h"
@@ -28,6 +30,19 @@ namespace DSP::JIT::x64
 constexpr size_t COMPILED_CODE_SIZE = 2097152;
 constexpr size_t MAX_BLOCK_SIZE = 250;
 constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
+// Precompiling stops when less than this is left, so that there is room for the blocks that are
+// only found while the ucode runs.
+constexpr size_t PRECOMPILE_RESERVED_SIZE = COMPILED_CODE_SIZE / 2;
+
+constexpr u32 BLOCK_CACHE_MAGIC = 0x42505344;  // "DSPB"
+constexpr u32 BLOCK_CACHE_VERSION = 1;
+
+struct BlockCacheHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_entry_points;
+};
 
 DSPEmitter::DSPEmitter(DSPCore& dsp)
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
@@ -45,6 +60,7 @@ DSPEmitter::DSPEmitter(DSPCore& dsp)
 
 DSPEmitter::~DSPEmitter()
 {
+  SaveEntryPoints();
   FreeCodeSpace();
 }
 
@@ -56,6 +72,10 @@ u16 DSPEmitter::RunCycles(u16 cycles)
     m_dsp_core.CheckExceptions();
   }
 
+  // A ucode that was uploaded from outside of the DSP can be precompiled before it runs.
+  if (m_dsp_core.DSPState().reset_dspjit_codespace)
+    ClearIRAMandDSPJITCodespaceReset();
+
   m_cycles_left = cycles;
   auto exec_addr = (DSPCompiledCode)m_enter_dispatcher;
   exec_addr();
@@ -73,6 +93,10 @@ void DSPEmitter::DoState(PointerWrap& p)
 
 void DSPEmitter::ClearIRAM()
 {
+  // Blocks compiled from here on belong to the new ucode.
+  SaveEntryPoints();
+  m_ucode_crc.reset();
+
   for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
   {
     m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
@@ -97,6 +121,132 @@ void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
     m_unresolved_jumps[i].clear();
   }
   m_dsp_core.DSPState().reset_dspjit_codespace = false;
+
+  Precompile();
+}
+
+void DSPEmitter::Precompile()
+{
+  SaveEntryPoints();
+
+  m_ucode_crc = m_dsp_core.DSPState().GetIRAMCRC();
+  m_entry_points.reset();
+  const std::string path = Host::GetBlockCachePath(*m_ucode_crc);
+  if (!path.empty())
+    LoadEntryPoints(path);
+
+  // The cache only has the blocks that were compiled as they were reached, so it is merged with
+  // the entry points found by looking at the code. The cached ones come first, since they are known
+  // to be used.
+  std::vector<u16> entry_points;
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
+  {
+    if (m_entry_points[i])
+      entry_points.push_back(static_cast<u16>(i));
+  }
+  for (const u16 address : FindEntryPoints())
+  {
+    if (!m_entry_points[address])
+      entry_points.push_back(address);
+  }
+
+  // Compiling a block that others were waiting to link to throws those away, so compile them again
+  // once everything they link to exists.
+  const auto& analyzer = m_dsp_core.DSPState().GetAnalyzer();
+  size_t num_compiled = 0;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    for (const u16 address : entry_points)
+    {
+      if (GetSpaceLeft() < PRECOMPILE_RESERVED_SIZE)
+        break;
+      if (m_blocks[address] != (DSPCompiledCode)m_stub_entry_point ||
+          !analyzer.IsStartOfInstruction(address))
+      {
+        continue;
+      }
+
+      CompileAndLink(address);
+      num_compiled++;
+    }
+  }
+
+  INFO_LOG_FMT(DSPLLE, "Precompiled {} blocks for ucode {:08x}", num_compiled, *m_ucode_crc);
+}
+
+std::vector<u16> DSPEmitter::FindEntryPoints() const
+{
+  const SDSP& state = m_dsp_core.DSPState();
+  const auto& analyzer = state.GetAnalyzer();
+  std::vector<u16> entry_points;
+
+  // The exception vectors.
+  for (u16 address = 0; address < 0x10; address += 2)
+    entry_points.push_back(address);
+
+  for (u16 address = 0; address < DSP_IRAM_SIZE; address++)
+  {
+    if (!analyzer.IsStartOfInstruction(address))
+      continue;
+
+    // Blocks end before idle skips, and at jumps and calls, which go to the dispatcher when the
+    // block they go to can't be linked. Returns come back right after the call.
+    const UDSPInstruction inst = state.ReadIMEM(address);
+    const bool is_jump = (inst & 0xfff0) == 0x0290;
+    const bool is_call = (inst & 0xfff0) == 0x02b0;
+    if (is_jump || is_call)
+      entry_points.push_back(state.ReadIMEM(address + 1));
+    if (is_call)
+      entry_points.push_back(address + 2);
+    if (analyzer.IsIdleSkip(address))
+      entry_points.push_back(address);
+  }
+
+  return entry_points;
+}
+
+void DSPEmitter::LoadEntryPoints(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  BlockCacheHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != BLOCK_CACHE_MAGIC ||
+      header.version != BLOCK_CACHE_VERSION || header.num_entry_points > MAX_BLOCKS)
+  {
+    return;
+  }
+
+  std::vector<u16> entry_points(header.num_entry_points);
+  if (!file.ReadArray(entry_points.data(), entry_points.size()))
+    return;
+
+  for (const u16 address : entry_points)
+    m_entry_points[address] = true;
+  m_entry_points_changed = false;
+}
+
+void DSPEmitter::SaveEntryPoints()
+{
+  if (!m_ucode_crc || !m_entry_points_changed)
+    return;
+  m_entry_points_changed = false;
+
+  const std::string path = Host::GetBlockCachePath(*m_ucode_crc);
+  if (path.empty())
+    return;
+
+  std::vector<u16> entry_points;
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
+  {
+    if (m_entry_points[i])
+      entry_points.push_back(static_cast<u16>(i));
+  }
+
+  File::CreateFullPath(path);
+  File::IOFile file(path, "wb");
+  const BlockCacheHeader header{BLOCK_CACHE_MAGIC, BLOCK_CACHE_VERSION,
+                                static_cast<u32>(entry_points.size())};
+  if (!file.WriteArray(&header, 1) || !file.WriteArray(entry_points.data(), entry_points.size()))
+    WARN_LOG_FMT(DSPLLE, "Failed to write the block cache to {}", path);
 }
 
 static void CheckExceptionsThunk(DSPCore& dsp)
@@ -394,7 +544,19 @@ void DSPEmitter::Compile(u16 start_addr)
 
 void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
 {
-  emitter.Compile(emitter.m_dsp_core.DSPState().pc);
+  const u16 pc = emitter.m_dsp_core.DSPState().pc;
+  if (!emitter.m_entry_points[pc])
+  {
+    emitter.m_entry_points[pc] = true;
+    emitter.m_entry_points_changed = true;
+  }
+
+  emitter.CompileAndLink(pc);
+}
+
+void DSPEmitter::CompileAndLink(u16 start_addr)
+{
+  Compile(start_addr);
 
   bool retry = true;
 
@@ -403,11 +565,11 @@ void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
     retry = false;
     for (size_t i = 0; i < 0xffff; ++i)
     {
-      if (!emitter.m_unresolved_jumps[i].empty())
+      if (!m_unresolved_jumps[i].empty())
       {
-        const u16 address_to_compile = emitter.m_unresolved_jumps[i].front();
-        emitter.Compile(address_to_compile);
-        if (!emitter.m_unresolved_jumps[i].empty())
+        const u16 address_to_compile = m_unresolved_jumps[i].front();
+        Compile(address_to_compile);
+        if (!m_unresolved_jumps[i].empty())
           retry = true;
       }
     }
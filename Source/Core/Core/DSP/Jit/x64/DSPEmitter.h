@@ -4,8 +4,11 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <list>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -206,6 +209,16 @@ private:
   void CompileDispatcher();
   Block CompileStub();
   void Compile(u16 start_addr);
+  // Compiles a block, and the blocks it calls that it couldn't be linked to yet.
+  void CompileAndLink(u16 start_addr);
+
+  // Compiles the blocks a newly uploaded ucode is likely to enter, so that they don't need to be
+  // compiled while the ucode runs.
+  void Precompile();
+  // Guesses where blocks start from the branches in IRAM, for ucodes that aren't in the cache.
+  std::vector<u16> FindEntryPoints() const;
+  void LoadEntryPoints(const std::string& path);
+  void SaveEntryPoints();
 
   bool FlagsNeeded() const;
 
@@ -323,6 +336,11 @@ private:
 
   std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
 
+  // The addresses of the blocks entered by the current ucode, which are kept in the block cache.
+  std::bitset<MAX_BLOCKS> m_entry_points;
+  bool m_entry_points_changed = false;
+  std::optional<u32> m_ucode_crc;
+
   u16 m_cycles_left = 0;
 
   // The index of the last stored ext value (compile time).
@@ -6,21 +6,36 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <zstd.h>
+
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
-constexpr u32 MIN_LOADER_VERSION = 1;
-// This value is only used if the DFF file was created with overridden RAM sizes.
-// If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
-constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+constexpr u32 VERSION_NUMBER = 6;
+// Version 6 replaced the uncompressed frame data with compressed chunks, which older versions of
+// the FIFO Player can't read.
+constexpr u32 MIN_LOADER_VERSION = 6;
+constexpr u32 FIRST_CHUNKED_VERSION = 6;
+
+constexpr int COMPRESSION_LEVEL = 5;
+// Number of decoded frames of chunked files that are kept around, so that the FIFO Player and the
+// FIFO Analyzer can look at the same frames without decompressing them again.
+constexpr size_t DECODED_FRAME_CACHE_SIZE = 4;
+// A zstd block holds at most 128 KiB and takes at least 4 bytes, so compressed data can't get
+// larger than this many times its size when decompressed.
+constexpr u64 MAX_COMPRESSION_RATIO = 0x20000 / 4;
 
 #pragma pack(push, 1)
 
@@ -46,7 +61,10 @@ struct FileHeader
   // will crash and burn with mismatched settings.  See PR #8722.
   u32 mem1_size;
   u32 mem2_size;
-  u8 reserved[32];
+  // Only valid since version 6.
+  u64 blobListOffset;
+  u32 blobCount;
+  u8 reserved[20];
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
@@ -73,8 +91,85 @@ struct FileMemoryUpdate
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
+// Since version 6, each frame is stored as a single compressed chunk that holds a
+// FileChunkMemoryUpdate for every memory update followed by the FIFO data, and the frame list
+// holds a FileFrameChunk for every frame. This allows reading any frame without reading the ones
+// before it.
+struct FileFrameChunk
+{
+  u64 chunkOffset;
+  u32 chunkSize;
+  u32 fifoDataSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u32 numMemoryUpdates;
+  u8 reserved[4];
+};
+static_assert(sizeof(FileFrameChunk) == 32, "FileFrameChunk should be 32 bytes");
+
+// Games upload the same textures and vertex data over and over, so the data of memory updates is
+// stored separately from the frames, compressed on its own, and only once per distinct payload.
+struct FileChunkMemoryUpdate
+{
+  u32 fifoPosition;
+  u32 address;
+  u32 blobIndex;
+  u8 type;
+  u8 reserved[3];
+};
+static_assert(sizeof(FileChunkMemoryUpdate) == 16, "FileChunkMemoryUpdate should be 16 bytes");
+
+struct FileBlob
+{
+  u64 dataOffset;
+  u32 compressedSize;
+  u32 dataSize;
+};
+static_assert(sizeof(FileBlob) == 16, "FileBlob should be 16 bytes");
+
 #pragma pack(pop)
 
+namespace
+{
+struct ZSTDCompressionContextDeleter
+{
+  void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+};
+
+using ZSTDCompressionContext = std::unique_ptr<ZSTD_CCtx, ZSTDCompressionContextDeleter>;
+
+bool WriteCompressed(ZSTD_CCtx* context, const u8* data, size_t size, std::vector<u8>& buffer,
+                     File::IOFile& file, u32* compressed_size)
+{
+  buffer.resize(ZSTD_compressBound(size));
+  const size_t result =
+      ZSTD_compressCCtx(context, buffer.data(), buffer.size(), data, size, COMPRESSION_LEVEL);
+  if (ZSTD_isError(result))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to compress FIFO log data: {}", ZSTD_getErrorName(result));
+    return false;
+  }
+
+  *compressed_size = static_cast<u32>(result);
+  return file.WriteBytes(buffer.data(), result);
+}
+
+bool FitsInFile(u64 offset, u64 size, u64 file_size)
+{
+  return offset <= file_size && size <= file_size - offset;
+}
+
+bool ReadCompressed(File::IOFile& file, u64 offset, u32 compressed_size, u8* data, size_t size)
+{
+  std::vector<u8> buffer(compressed_size);
+  if (!file.Seek(offset, File::SeekOrigin::Begin) || !file.ReadBytes(buffer.data(), buffer.size()))
+    return false;
+
+  const size_t result = ZSTD_decompress(data, size, buffer.data(), buffer.size());
+  return !ZSTD_isError(result) && result == size;
+}
+}  // namespace
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -101,7 +196,35 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  m_Frames.push_back(std::make_shared<const FifoFrameInfo>(frameInfo));
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (m_frame_chunks.empty())
+    return m_Frames[frame];
+
+  std::lock_guard lk(m_stream_mutex);
+
+  auto it = std::find_if(m_decoded_frames.begin(), m_decoded_frames.end(),
+                         [frame](const auto& decoded) { return decoded.first == frame; });
+  if (it == m_decoded_frames.end())
+  {
+    if (m_decoded_frames.size() == DECODED_FRAME_CACHE_SIZE)
+      m_decoded_frames.pop_back();
+    it = m_decoded_frames.emplace(m_decoded_frames.end(), frame, ReadFrameChunk(frame));
+  }
+
+  // Keep the most recently used frames at the front.
+  std::rotate(m_decoded_frames.begin(), it, it + 1);
+  return m_decoded_frames.front().second;
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  if (!m_frame_chunks.empty())
+    return static_cast<u32>(m_frame_chunks.size());
+  return static_cast<u32>(m_Frames.size());
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -110,13 +233,13 @@ bool FifoDataFile::Save(const std::string& filename)
   if (!file.Open(filename, "wb"))
     return false;
 
+  ZSTDCompressionContext context(ZSTD_createCCtx());
+  if (!context)
+    return false;
+
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
-  // Add space for frame list
-  u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
-
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
 
@@ -132,15 +255,97 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem);
 
+  const u32 frameCount = GetFrameCount();
+  std::vector<FileFrameChunk> frameChunks(frameCount);
+  std::vector<FileBlob> blobs;
+
+  // Payloads that have already been written, by hash. The frame that each one came from is kept
+  // alive so that payloads with the same hash can be compared.
+  struct WrittenPayload
+  {
+    u32 blobIndex;
+    std::shared_ptr<const FifoFrameInfo> frame;
+    size_t update;
+  };
+  std::unordered_multimap<u64, WrittenPayload> writtenPayloads;
+
+  std::vector<u8> chunk;
+  std::vector<u8> compressed;
+
+  for (u32 i = 0; i < frameCount; ++i)
+  {
+    const std::shared_ptr<const FifoFrameInfo> srcFrame = GetFrame(i);
+    const std::vector<MemoryUpdate>& memUpdates = srcFrame->memoryUpdates;
+
+    const size_t updatesSize = memUpdates.size() * sizeof(FileChunkMemoryUpdate);
+    chunk.resize(updatesSize + srcFrame->fifoData.size());
+
+    for (size_t j = 0; j < memUpdates.size(); ++j)
+    {
+      const std::vector<u8>& data = memUpdates[j].data;
+      const u64 hash = Common::GetFullHash64(data.data(), data.size());
+
+      const auto [begin, end] = writtenPayloads.equal_range(hash);
+      const auto written = std::find_if(begin, end, [&data](const auto& candidate) {
+        return candidate.second.frame->memoryUpdates[candidate.second.update].data == data;
+      });
+
+      FileChunkMemoryUpdate dstUpdate{};
+      dstUpdate.fifoPosition = memUpdates[j].fifoPosition;
+      dstUpdate.address = memUpdates[j].address;
+      dstUpdate.type = memUpdates[j].type;
+
+      if (written != end)
+      {
+        dstUpdate.blobIndex = written->second.blobIndex;
+      }
+      else
+      {
+        FileBlob& blob = blobs.emplace_back();
+        blob.dataOffset = file.Tell();
+        blob.dataSize = static_cast<u32>(data.size());
+        if (!WriteCompressed(context.get(), data.data(), data.size(), compressed, file,
+                             &blob.compressedSize))
+        {
+          return false;
+        }
+
+        dstUpdate.blobIndex = static_cast<u32>(blobs.size() - 1);
+        writtenPayloads.emplace(hash, WrittenPayload{dstUpdate.blobIndex, srcFrame, j});
+      }
+
+      std::memcpy(&chunk[j * sizeof(FileChunkMemoryUpdate)], &dstUpdate, sizeof(dstUpdate));
+    }
+
+    if (!srcFrame->fifoData.empty())
+    {
+      std::memcpy(&chunk[updatesSize], srcFrame->fifoData.data(), srcFrame->fifoData.size());
+    }
+
+    FileFrameChunk& dstFrame = frameChunks[i];
+    dstFrame.chunkOffset = file.Tell();
+    dstFrame.fifoDataSize = static_cast<u32>(srcFrame->fifoData.size());
+    dstFrame.fifoStart = srcFrame->fifoStart;
+    dstFrame.fifoEnd = srcFrame->fifoEnd;
+    dstFrame.numMemoryUpdates = static_cast<u32>(memUpdates.size());
+    if (!WriteCompressed(context.get(), chunk.data(), chunk.size(), compressed, file,
+                         &dstFrame.chunkSize))
+    {
+      return false;
+    }
+  }
+
+  u64 frameListOffset = file.Tell();
+  file.WriteArray(frameChunks.data(), frameChunks.size());
+
+  u64 blobListOffset = file.Tell();
+  file.WriteArray(blobs.data(), blobs.size());
+
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -158,7 +363,10 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frameCount;
+
+  header.blobListOffset = blobListOffset;
+  header.blobCount = static_cast<u32>(blobs.size());
 
   header.flags = m_Flags;
 
@@ -170,32 +378,6 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
-  }
-
   if (!file.Close())
     return false;
 
@@ -316,6 +498,16 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
+  if (dataFile->m_Version >= FIRST_CHUNKED_VERSION)
+  {
+    if (!dataFile->LoadFrameIndex(header, file))
+      return panic_failed_to_read();
+
+    // Frames are read from the file as they are needed.
+    dataFile->m_stream_file = std::make_unique<File::IOFile>(std::move(file));
+    return dataFile;
+  }
+
   // Read frames
   for (u32 i = 0; i < header.frameCount; ++i)
   {
@@ -339,7 +531,7 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     if (!file.IsGood())
       return panic_failed_to_read();
 
-    dataFile->AddFrame(dstFrame);
+    dataFile->m_Frames.push_back(std::make_shared<const FifoFrameInfo>(std::move(dstFrame)));
   }
 
   return dataFile;
@@ -364,37 +556,6 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
-{
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
-
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = srcUpdate.type;
-
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
-  }
-
-  return updateListOffset;
-}
-
 void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                      std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
 {
@@ -417,3 +578,107 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
   }
 }
+
+bool FifoDataFile::LoadFrameIndex(const FileHeader& header, File::IOFile& file)
+{
+  // The sizes in the indexes are used to allocate buffers, so check that they are possible before
+  // trusting them.
+  const u64 file_size = file.GetSize();
+  if (!FitsInFile(header.frameListOffset, u64{header.frameCount} * sizeof(FileFrameChunk),
+                  file_size) ||
+      !FitsInFile(header.blobListOffset, u64{header.blobCount} * sizeof(FileBlob), file_size))
+  {
+    return false;
+  }
+
+  m_frame_chunks.resize(header.frameCount);
+  if (!file.Seek(header.frameListOffset, File::SeekOrigin::Begin) ||
+      !file.ReadArray(m_frame_chunks.data(), m_frame_chunks.size()))
+  {
+    return false;
+  }
+
+  m_blobs.resize(header.blobCount);
+  if (!file.Seek(header.blobListOffset, File::SeekOrigin::Begin) ||
+      !file.ReadArray(m_blobs.data(), m_blobs.size()))
+  {
+    return false;
+  }
+
+  for (const FileFrameChunk& frame : m_frame_chunks)
+  {
+    const u64 chunk_size = frame.chunkSize;
+    const u64 data_size =
+        u64{frame.numMemoryUpdates} * sizeof(FileChunkMemoryUpdate) + frame.fifoDataSize;
+    if (!FitsInFile(frame.chunkOffset, chunk_size, file_size) ||
+        data_size > chunk_size * MAX_COMPRESSION_RATIO)
+    {
+      return false;
+    }
+  }
+
+  for (const FileBlob& blob : m_blobs)
+  {
+    const u64 compressed_size = blob.compressedSize;
+    if (!FitsInFile(blob.dataOffset, compressed_size, file_size) ||
+        blob.dataSize > compressed_size * MAX_COMPRESSION_RATIO)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::ReadFrameChunk(u32 frame) const
+{
+  const FileFrameChunk& srcFrame = m_frame_chunks[frame];
+
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+
+  const size_t updatesSize = srcFrame.numMemoryUpdates * sizeof(FileChunkMemoryUpdate);
+  std::vector<u8> chunk(updatesSize + srcFrame.fifoDataSize);
+  bool good = ReadCompressed(*m_stream_file, srcFrame.chunkOffset, srcFrame.chunkSize,
+                             chunk.data(), chunk.size());
+
+  if (good)
+  {
+    dstFrame->fifoData.assign(chunk.begin() + updatesSize, chunk.end());
+
+    dstFrame->memoryUpdates.resize(srcFrame.numMemoryUpdates);
+    for (u32 i = 0; i < srcFrame.numMemoryUpdates && good; ++i)
+    {
+      FileChunkMemoryUpdate srcUpdate;
+      std::memcpy(&srcUpdate, &chunk[i * sizeof(FileChunkMemoryUpdate)], sizeof(srcUpdate));
+
+      MemoryUpdate& dstUpdate = dstFrame->memoryUpdates[i];
+      dstUpdate.address = srcUpdate.address;
+      dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+      dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+      good = ReadBlob(srcUpdate.blobIndex, dstUpdate.data);
+    }
+  }
+
+  if (!good)
+  {
+    // Play the frame without any commands rather than stopping playback.
+    PanicAlertFmtT("Failed to read frame {0} of the DFF file.", frame);
+    dstFrame->fifoData.clear();
+    dstFrame->memoryUpdates.clear();
+  }
+
+  return dstFrame;
+}
+
+bool FifoDataFile::ReadBlob(u32 blob, std::vector<u8>& data) const
+{
+  if (blob >= m_blobs.size())
+    return false;
+
+  const FileBlob& srcBlob = m_blobs[blob];
+  data.resize(srcBlob.dataSize);
+  return ReadCompressed(*m_stream_file, srcBlob.dataOffset, srcBlob.compressedSize, data.data(),
+                        data.size());
+}
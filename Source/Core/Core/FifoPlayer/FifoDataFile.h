@@ -5,7 +5,9 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -16,6 +18,10 @@ namespace File
 class IOFile;
 }
 
+struct FileBlob;
+struct FileFrameChunk;
+struct FileHeader;
+
 struct MemoryUpdate
 {
   enum Type
@@ -73,8 +79,10 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Frames of files in the chunked format are read and decompressed when they are requested, so
+  // callers should hold on to the returned frame for as long as they use it. Thread-safe.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -90,10 +98,13 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
 
+  bool LoadFrameIndex(const FileHeader& header, File::IOFile& file);
+  std::shared_ptr<const FifoFrameInfo> ReadFrameChunk(u32 frame) const;
+  bool ReadBlob(u32 blob, std::vector<u8>& data) const;
+
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
   std::array<u32, XF_MEM_SIZE> m_XFMem{};
@@ -105,5 +116,15 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // Frames of files that were recorded or loaded from the old format, which are kept in memory.
+  std::vector<std::shared_ptr<const FifoFrameInfo>> m_Frames;
+
+  // Frames and memory update payloads of files in the chunked format, which are kept on disk.
+  std::vector<FileFrameChunk> m_frame_chunks;
+  std::vector<FileBlob> m_blobs;
+
+  // Guards the file that chunks are read from and the recently decoded frames.
+  mutable std::mutex m_stream_mutex;
+  std::unique_ptr<File::IOFile> m_stream_file;
+  mutable std::vector<std::pair<u32, std::shared_ptr<const FifoFrameInfo>>> m_decoded_frames;
 };
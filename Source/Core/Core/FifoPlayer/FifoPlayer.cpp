@@ -32,12 +32,11 @@
 // TODO: Move texMem somewhere else so this isn't an issue.
 #include "VideoCommon/TextureDecoder.h"
 
-namespace
-{
 class FifoPlaybackAnalyzer : public OpcodeDecoder::Callback
 {
 public:
-  static void AnalyzeFrames(FifoDataFile* file, std::vector<AnalyzedFrameInfo>& frame_info);
+  // Frames have to be analyzed in order, since the CP state carries over from one to the next.
+  void AnalyzeFrame(const FifoFrameInfo& frame, AnalyzedFrameInfo& analyzed);
 
   explicit FifoPlaybackAnalyzer(const u32* cpmem) : m_cpmem(cpmem) {}
 
@@ -72,58 +71,47 @@ public:
   CPState m_cpmem;
 };
 
-void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
-                                         std::vector<AnalyzedFrameInfo>& frame_info)
+void FifoPlaybackAnalyzer::AnalyzeFrame(const FifoFrameInfo& frame, AnalyzedFrameInfo& analyzed)
 {
-  FifoPlaybackAnalyzer analyzer(file->GetCPMem());
-  frame_info.clear();
-  frame_info.resize(file->GetFrameCount());
-
-  for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
-  {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
-    AnalyzedFrameInfo& analyzed = frame_info[frame_no];
+  u32 offset = 0;
 
-    u32 offset = 0;
+  u32 part_start = 0;
+  CPState cpmem;
 
-    u32 part_start = 0;
-    CPState cpmem;
+  while (offset < frame.fifoData.size())
+  {
+    const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
+                                                   u32(frame.fifoData.size()) - offset, *this);
 
-    while (offset < frame.fifoData.size())
+    if (m_start_of_primitives)
     {
-      const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
-                                                     u32(frame.fifoData.size()) - offset, analyzer);
-
-      if (analyzer.m_start_of_primitives)
-      {
-        // Start of primitive data for an object
-        analyzed.AddPart(FramePartType::Commands, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-        // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
-        // primitive data, and the first opcode might update cpmem
-        std::memcpy(&cpmem, &analyzer.m_cpmem, sizeof(CPState));
-      }
-      if (analyzer.m_end_of_primitives)
-      {
-        // End of primitive data for an object, and thus end of the object
-        analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, cpmem);
-        part_start = offset;
-      }
+      // Start of primitive data for an object
+      analyzed.AddPart(FramePartType::Commands, part_start, offset, m_cpmem);
+      part_start = offset;
+      // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
+      // primitive data, and the first opcode might update cpmem
+      std::memcpy(&cpmem, &m_cpmem, sizeof(CPState));
+    }
+    if (m_end_of_primitives)
+    {
+      // End of primitive data for an object, and thus end of the object
+      analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, cpmem);
+      part_start = offset;
+    }
 
-      offset += cmd_size;
+    offset += cmd_size;
 
-      if (analyzer.m_efb_copy)
-      {
-        // We increase the offset beforehand, so that the trigger EFB copy command is included.
-        analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-      }
+    if (m_efb_copy)
+    {
+      // We increase the offset beforehand, so that the trigger EFB copy command is included.
+      analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, m_cpmem);
+      part_start = offset;
     }
-
-    // The frame should end with an EFB copy, so part_start should have been updated to the end.
-    ASSERT(part_start == frame.fifoData.size());
-    ASSERT(offset == frame.fifoData.size());
   }
+
+  // The frame should end with an EFB copy, so part_start should have been updated to the end.
+  ASSERT(part_start == frame.fifoData.size());
+  ASSERT(offset == frame.fifoData.size());
 }
 
 void FifoPlaybackAnalyzer::OnBP(u8 command, u32 value)
@@ -165,7 +153,6 @@ void FifoPlaybackAnalyzer::OnCommand(const u8* data, u32 size)
   m_is_copy = false;
   m_is_nop = false;
 }
-}  // namespace
 
 bool IsPlayingBackFifologWithBrokenEFBCopies = false;
 
@@ -188,7 +175,11 @@ bool FifoPlayer::Open(const std::string& filename)
 
   if (m_File)
   {
-    FifoPlaybackAnalyzer::AnalyzeFrames(m_File.get(), m_FrameInfo);
+    // Frames are analyzed as they are needed, so that opening a file doesn't decompress them all.
+    m_analyzer = std::make_unique<FifoPlaybackAnalyzer>(m_File->GetCPMem());
+    m_analyzed_frame_count = 0;
+    m_FrameInfo.clear();
+    m_FrameInfo.resize(m_File->GetFrameCount());
 
     m_FrameRangeEnd = m_File->GetFrameCount() - 1;
   }
@@ -293,7 +284,7 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  WriteFrame(*m_File->GetFrame(m_CurrentFrame), GetAnalyzedFrameInfo(m_CurrentFrame));
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -334,8 +325,28 @@ bool FifoPlayer::IsRunningWithFakeVideoInterfaceUpdates() const
   return m_File->ShouldGenerateFakeVIUpdates();
 }
 
-u32 FifoPlayer::GetMaxObjectCount() const
+const AnalyzedFrameInfo& FifoPlayer::GetAnalyzedFrameInfo(u32 frame)
+{
+  AnalyzeFramesUpTo(frame);
+  return m_FrameInfo[frame];
+}
+
+void FifoPlayer::AnalyzeFramesUpTo(u32 frame)
 {
+  std::lock_guard lock(m_analysis_lock);
+  for (; m_analyzed_frame_count <= frame; m_analyzed_frame_count++)
+  {
+    m_analyzer->AnalyzeFrame(*m_File->GetFrame(m_analyzed_frame_count),
+                             m_FrameInfo[m_analyzed_frame_count]);
+  }
+}
+
+u32 FifoPlayer::GetMaxObjectCount()
+{
+  if (m_FrameInfo.empty())
+    return 0;
+
+  AnalyzeFramesUpTo(static_cast<u32>(m_FrameInfo.size() - 1));
   u32 result = 0;
   for (auto& frame : m_FrameInfo)
   {
@@ -346,17 +357,17 @@ u32 FifoPlayer::GetMaxObjectCount() const
   return result;
 }
 
-u32 FifoPlayer::GetFrameObjectCount(u32 frame) const
+u32 FifoPlayer::GetFrameObjectCount(u32 frame)
 {
   if (frame < m_FrameInfo.size())
   {
-    return m_FrameInfo[frame].part_type_counts[FramePartType::PrimitiveData];
+    return GetAnalyzedFrameInfo(frame).part_type_counts[FramePartType::PrimitiveData];
   }
 
   return 0;
 }
 
-u32 FifoPlayer::GetCurrentFrameObjectCount() const
+u32 FifoPlayer::GetCurrentFrameObjectCount()
 {
   return GetFrameObjectCount(m_CurrentFrame);
 }
@@ -484,8 +495,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -547,7 +558,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame_ptr = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_ptr;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
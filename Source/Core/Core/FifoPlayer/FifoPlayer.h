@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -16,6 +17,7 @@
 #include "VideoCommon/OpcodeDecoding.h"
 
 class FifoDataFile;
+class FifoPlaybackAnalyzer;
 struct MemoryUpdate;
 
 namespace CPU
@@ -105,11 +107,12 @@ public:
   bool IsPlaying() const;
 
   FifoDataFile* GetFile() const { return m_File.get(); }
-  u32 GetMaxObjectCount() const;
-  u32 GetFrameObjectCount(u32 frame) const;
-  u32 GetCurrentFrameObjectCount() const;
+  // Analyzes every frame of the file.
+  u32 GetMaxObjectCount();
+  u32 GetFrameObjectCount(u32 frame);
+  u32 GetCurrentFrameObjectCount();
   u32 GetCurrentFrameNum() const { return m_CurrentFrame; }
-  const AnalyzedFrameInfo& GetAnalyzedFrameInfo(u32 frame) const { return m_FrameInfo[frame]; }
+  const AnalyzedFrameInfo& GetAnalyzedFrameInfo(u32 frame);
   // Frame range
   u32 GetFrameRangeStart() const { return m_FrameRangeStart; }
   void SetFrameRangeStart(u32 start);
@@ -136,6 +139,8 @@ private:
 
   CPU::State AdvanceFrame();
 
+  void AnalyzeFramesUpTo(u32 frame);
+
   void WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo& info);
   void WriteFramePart(const FramePart& part, u32* next_mem_update, const FifoFrameInfo& frame);
 
@@ -193,5 +198,10 @@ private:
 
   std::unique_ptr<FifoDataFile> m_File;
 
+  // Frames before m_analyzed_frame_count have been analyzed, and don't change until another file is
+  // opened. The lock is held while analyzing, since the UI can ask for frames during playback.
+  std::unique_ptr<FifoPlaybackAnalyzer> m_analyzer;
+  u32 m_analyzed_frame_count = 0;
   std::vector<AnalyzedFrameInfo> m_FrameInfo;
+  std::mutex m_analysis_lock;
 };
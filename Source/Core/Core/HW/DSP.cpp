@@ -507,8 +507,11 @@ void UpdateDSPSlice(int cycles)
   if (state.is_lle)
   {
     // use up the rest of the slice(if any)
-    state.dsp_emulator->DSP_Update(state.dsp_slice);
-    state.dsp_slice %= 6;
+    if (state.dsp_slice > 0)
+    {
+      state.dsp_emulator->DSP_Update(state.dsp_slice);
+      state.dsp_slice %= 6;
+    }
     // note the new budget
     state.dsp_slice += cycles;
   }
@@ -518,6 +521,17 @@ void UpdateDSPSlice(int cycles)
   }
 }
 
+// called when the current slice is cut short after its budget was handed out
+void ShortenDSPSlice(int cycles)
+{
+  auto& state = Core::System::GetInstance().GetDSPState().GetData();
+
+  // The DSP may already have used more than what is left, in which case the difference is taken
+  // from the next budget.
+  if (state.is_lle)
+    state.dsp_slice -= cycles;
+}
+
 // This happens at 4 khz, since 32 bytes at 4khz = 4 bytes at 32 khz (16bit stereo pcm)
 void UpdateAudioDMA()
 {
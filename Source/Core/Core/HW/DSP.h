@@ -99,5 +99,6 @@ u8* GetARAMPtr();
 
 void UpdateAudioDMA();
 void UpdateDSPSlice(int cycles);
+void ShortenDSPSlice(int cycles);
 
 }  // namespace DSP
@@ -15,6 +15,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -30,6 +31,9 @@ namespace DSP::HLE
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc)
 {
   INFO_LOG_FMT(DSPHLE, "Instantiating AXUCode: crc={:08x}", crc);
+
+  m_voice_workers.ResizeWorkerThreads(
+      AXVoiceWorkers::GetNumWorkerThreads(Config::Get(Config::MAIN_DSP_HLE_VOICE_THREADS)));
 }
 
 void AXUCode::Initialize()
@@ -400,37 +404,94 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
 
 void AXUCode::ProcessPBList(u32 pb_addr)
 {
-  // Samples per millisecond. In theory DSP sampling rate can be changed from
-  // 32KHz to 48KHz, but AX always process at 32KHz.
-  constexpr u32 spms = 32;
+  if (m_voice_workers.HasWorkerThreads() && ProcessPBListInParallel(pb_addr))
+    return;
+
+  int* const buffers[] = {m_samples_main_left,    m_samples_main_right, m_samples_main_surround,
+                          m_samples_auxA_left,    m_samples_auxA_right, m_samples_auxA_surround,
+                          m_samples_auxB_left,    m_samples_auxB_right, m_samples_auxB_surround};
 
   AXPB pb;
 
   while (pb_addr)
   {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
-
     ReadPB(pb_addr, pb, m_crc);
 
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
 
+    ProcessPB(pb, updates, buffers);
+    ReportVoiceQuirks(pb);
+
+    WritePB(pb_addr, pb, m_crc);
+    pb_addr = HILO_TO_32(pb.next_pb);
+  }
+}
+
+bool AXUCode::ProcessPBListInParallel(u32 pb_addr)
+{
+  // Read the whole list first. Updates can change the address of the next PB, so they are
+  // applied to a copy of each PB to find it.
+  m_pb_list.clear();
+  while (pb_addr)
+  {
+    if (m_pb_list.size() == MAX_PARALLEL_VOICES)
+      return false;
+
+    PBListVoice& voice = m_pb_list.emplace_back();
+    voice.addr = pb_addr;
+    ReadPB(pb_addr, voice.pb, m_crc);
+    voice.updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(voice.pb.updates.data));
+
+    AXPB updated_pb = voice.pb;
     for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
-    {
-      ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
+      ApplyUpdatesForMs(curr_ms, updated_pb, updated_pb.updates.num_updates, voice.updates);
+    pb_addr = HILO_TO_32(updated_pb.next_pb);
+  }
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
-                   m_coeffs_checksum ? m_coeffs.data() : nullptr);
+  const std::array<AXVoiceWorkers::MixBuffer, 9> mix_buffers{{
+      {m_samples_main_left, std::size(m_samples_main_left)},
+      {m_samples_main_right, std::size(m_samples_main_right)},
+      {m_samples_main_surround, std::size(m_samples_main_surround)},
+      {m_samples_auxA_left, std::size(m_samples_auxA_left)},
+      {m_samples_auxA_right, std::size(m_samples_auxA_right)},
+      {m_samples_auxA_surround, std::size(m_samples_auxA_surround)},
+      {m_samples_auxB_left, std::size(m_samples_auxB_left)},
+      {m_samples_auxB_right, std::size(m_samples_auxB_right)},
+      {m_samples_auxB_surround, std::size(m_samples_auxB_surround)},
+  }};
+  m_voice_workers.Run(m_pb_list.size(), mix_buffers, [this](size_t i, int* const* buffers) {
+    ProcessPB(m_pb_list[i].pb, m_pb_list[i].updates, buffers);
+  });
 
-      // Forward the buffers
-      for (auto& ptr : buffers.ptrs)
-        ptr += spms;
-    }
+  for (const PBListVoice& voice : m_pb_list)
+  {
+    ReportVoiceQuirks(voice.pb);
+    WritePB(voice.addr, voice.pb, m_crc);
+  }
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
+  return true;
+}
+
+void AXUCode::ProcessPB(AXPB& pb, u16* updates, int* const* buffers)
+{
+  // Samples per millisecond. In theory DSP sampling rate can be changed from
+  // 32KHz to 48KHz, but AX always process at 32KHz.
+  constexpr u32 spms = 32;
+
+  AXBuffers voice_buffers;
+  std::copy_n(buffers, std::size(voice_buffers.ptrs), voice_buffers.ptrs);
+
+  for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+  {
+    ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
+
+    ProcessVoice(pb, voice_buffers, spms, ConvertMixerControl(pb.mixer_control),
+                 m_coeffs_checksum ? m_coeffs.data() : nullptr);
+
+    // Forward the buffers
+    for (auto& ptr : voice_buffers.ptrs)
+      ptr += spms;
   }
 }
 
@@ -13,10 +13,13 @@
 
 #include <array>
 #include <optional>
+#include <vector>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -100,6 +103,13 @@ protected:
 
   u16 m_compressor_pos = 0;
 
+  // PB lists longer than this are processed serially, without reading them ahead. A list this
+  // long most likely loops.
+  static constexpr size_t MAX_PARALLEL_VOICES = 256;
+
+  // Worker threads for processing the voices of a PB list in parallel.
+  AXVoiceWorkers m_voice_workers;
+
   bool LoadResamplingCoefficients(bool require_same_checksum, u32 desired_checksum);
 
   // Copy a command list from memory to our temp buffer
@@ -166,6 +176,11 @@ protected:
   void SetupProcessing(u32 init_addr);
   void DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16 vol_auxb);
   void ProcessPBList(u32 pb_addr);
+  // Reads the whole PB list ahead and processes its voices on the voice worker threads. Returns
+  // false without processing anything if the list is too long to be read ahead.
+  bool ProcessPBListInParallel(u32 pb_addr);
+  // Processes 5ms of audio from a PB, mixing it to the given buffers (in the order of AXBuffers).
+  void ProcessPB(AXPB& pb, u16* updates, int* const* buffers);
   void MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr);
   void UploadLRS(u32 dst_addr);
   void SetMainLR(u32 src_addr);
@@ -180,6 +195,16 @@ protected:
   void DoAXState(PointerWrap& p);
 
 private:
+  // A PB read ahead from the PB list, along with its updates.
+  struct PBListVoice
+  {
+    u32 addr;
+    AXPB pb;
+    u16* updates;
+  };
+
+  std::vector<PBListVoice> m_pb_list;
+
   enum CmdType
   {
     CMD_SETUP = 0x00,
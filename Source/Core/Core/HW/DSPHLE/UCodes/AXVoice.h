@@ -12,10 +12,9 @@
 #endif
 
 #include <algorithm>
-#include <functional>
-#include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -24,6 +23,10 @@
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP::HLE
 {
 #ifdef AX_GC
@@ -152,22 +155,38 @@ void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
   }
 }
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
-
+// Simulated accelerator, reading the samples of a voice. Each voice sets up its own accelerator,
+// so that voices can be processed on several threads at once.
 class HLEAccelerator final : public Accelerator
 {
+public:
+  explicit HLEAccelerator(PB_TYPE* pb) : m_pb(pb)
+  {
+    SetStartAddress(HILO_TO_32(pb->audio_addr.loop_addr));
+    SetEndAddress(HILO_TO_32(pb->audio_addr.end_addr));
+    SetCurrentAddress(HILO_TO_32(pb->audio_addr.cur_addr));
+    SetSampleFormat(pb->audio_addr.sample_format);
+    SetYn1(pb->adpcm.yn1);
+    SetYn2(pb->adpcm.yn2);
+    SetPredScale(pb->adpcm.pred_scale);
+  }
+
+  // Reads a sample from the accelerator. Also handles looping and
+  // disabling streams that reached the end (this is done by an exception raised
+  // by the accelerator on real hardware).
+  u16 GetSample() { return Read(m_pb->adpcm.coefs); }
+
 protected:
   void OnEndException() override
   {
-    if (acc_pb->audio_addr.looping)
+    if (m_pb->audio_addr.looping)
     {
       // Set the ADPCM info to continue processing at loop_addr.
-      SetPredScale(acc_pb->adpcm_loop_info.pred_scale);
-      if (acc_pb->is_stream != 1)
+      SetPredScale(m_pb->adpcm_loop_info.pred_scale);
+      if (m_pb->is_stream != 1)
       {
-        SetYn1(acc_pb->adpcm_loop_info.yn1);
-        SetYn2(acc_pb->adpcm_loop_info.yn2);
+        SetYn1(m_pb->adpcm_loop_info.yn1);
+        SetYn2(m_pb->adpcm_loop_info.yn2);
       }
       else
       {
@@ -176,42 +195,186 @@ protected:
         SetYn2(GetYn2());
 #ifdef AX_GC
         // If we're streaming, increment the loop counter.
-        acc_pb->loop_counter++;
+        m_pb->loop_counter++;
 #endif
       }
     }
     else
     {
       // Non looping voice reached the end -> running = 0.
-      acc_pb->running = 0;
+      m_pb->running = 0;
     }
   }
 
   u8 ReadMemory(u32 address) override { return ReadARAM(address); }
   void WriteMemory(u32 address, u8 value) override { WriteARAM(value, address); }
+
+private:
+  PB_TYPE* m_pb;
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+#if defined(_M_X86)
+// Multiplies 8 samples by 8 unsigned 1.15 volumes, clamping the results to [-32767, 32767].
+__m128i ScaleSamples8(__m128i samples, __m128i volumes)
+{
+  // The high half of a signed product is off by the sample for volumes with the top bit set.
+  const __m128i lo = _mm_mullo_epi16(samples, volumes);
+  const __m128i hi = _mm_add_epi16(_mm_mulhi_epi16(samples, volumes),
+                                   _mm_and_si128(samples, _mm_srai_epi16(volumes, 15)));
+  const __m128i products_lo = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+  const __m128i products_hi = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+  return _mm_max_epi16(_mm_packs_epi32(products_lo, products_hi), _mm_set1_epi16(-32767));
+}
+#elif defined(_M_ARM_64)
+int16x8_t ScaleSamples8(int16x8_t samples, uint16x8_t volumes)
+{
+  const int32x4_t products_lo =
+      vmulq_s32(vmovl_s16(vget_low_s16(samples)),
+                vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes))));
+  const int32x4_t products_hi =
+      vmulq_s32(vmovl_s16(vget_high_s16(samples)),
+                vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(volumes))));
+  const int16x8_t scaled =
+      vcombine_s16(vqshrn_n_s32(products_lo, 15), vqshrn_n_s32(products_hi, 15));
+  return vmaxq_s16(scaled, vdupq_n_s16(-32767));
+}
+#endif
+
+// Multiplies samples by a 1.15 volume which is incremented by volume_delta after each sample,
+// clamping the results to [-32767, 32767]. input and output may be the same buffer. Returns the
+// volume after the last sample.
+u16 ScaleSamples(const s16* input, s16* output, u32 count, u16 volume, u16 volume_delta)
+{
+  u32 i = 0;
+#if defined(_M_X86)
+  __m128i volumes = _mm_add_epi16(_mm_set1_epi16(volume),
+                                  _mm_mullo_epi16(_mm_set1_epi16(volume_delta),
+                                                  _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7)));
+  const __m128i volume_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), ScaleSamples8(samples, volumes));
+    volumes = _mm_add_epi16(volumes, volume_step);
+  }
+  volume += static_cast<u16>(volume_delta * i);
+#elif defined(_M_ARM_64)
+  constexpr u16 lanes[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  uint16x8_t volumes = vmlaq_n_u16(vdupq_n_u16(volume), vld1q_u16(lanes), volume_delta);
+  const uint16x8_t volume_step = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+  for (; i + 8 <= count; i += 8)
+  {
+    vst1q_s16(output + i, ScaleSamples8(vld1q_s16(input + i), volumes));
+    volumes = vaddq_u16(volumes, volume_step);
+  }
+  volume += static_cast<u16>(volume_delta * i);
+#endif
+
+  for (; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    output[i] = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+  return volume;
+}
 
-// Sets up the simulated accelerator.
-void AcceleratorSetup(PB_TYPE* pb)
+// Adds samples to a 32-bit output buffer.
+void AddSamples(int* out, const s16* input, u32 count)
 {
-  acc_pb = pb;
-  s_accelerator->SetStartAddress(HILO_TO_32(pb->audio_addr.loop_addr));
-  s_accelerator->SetEndAddress(HILO_TO_32(pb->audio_addr.end_addr));
-  s_accelerator->SetCurrentAddress(HILO_TO_32(pb->audio_addr.cur_addr));
-  s_accelerator->SetSampleFormat(pb->audio_addr.sample_format);
-  s_accelerator->SetYn1(pb->adpcm.yn1);
-  s_accelerator->SetYn2(pb->adpcm.yn2);
-  s_accelerator->SetPredScale(pb->adpcm.pred_scale);
+  u32 i = 0;
+#if defined(_M_X86)
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    __m128i* const dst = reinterpret_cast<__m128i*>(out + i);
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), lo));
+    _mm_storeu_si128(dst + 1, _mm_add_epi32(_mm_loadu_si128(dst + 1), hi));
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(input + i);
+    vst1q_s32(out + i, vaddw_s16(vld1q_s32(out + i), vget_low_s16(samples)));
+    vst1q_s32(out + i + 4, vaddw_s16(vld1q_s32(out + i + 4), vget_high_s16(samples)));
+  }
+#endif
+
+  for (; i < count; ++i)
+    out[i] += input[i];
 }
 
-// Reads a sample from the accelerator. Also handles looping and
-// disabling streams that reached the end (this is done by an exception raised
-// by the accelerator on real hardware).
-u16 AcceleratorGetSample()
+// Linearly interpolates between two samples for each output sample. A fractional position of 0
+// takes the first sample as is.
+void InterpolateLinear(const s16* samples0, const s16* samples1, const u16* fracs, s16* output,
+                       u32 count)
 {
-  return s_accelerator->Read(acc_pb->adpcm.coefs);
+  u32 i = 0;
+#if defined(_M_X86)
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples0 + i));
+    const __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples1 + i));
+    const __m128i frac = _mm_loadu_si128(reinterpret_cast<const __m128i*>(fracs + i));
+    const __m128i inv_frac = _mm_sub_epi16(_mm_setzero_si128(), frac);
+
+    // Unsigned 16-bit by signed 16-bit products, as in ScaleSamples8.
+    const auto multiply = [](__m128i samples, __m128i factors, __m128i* lo, __m128i* hi) {
+      const __m128i product_lo = _mm_mullo_epi16(samples, factors);
+      const __m128i product_hi = _mm_add_epi16(_mm_mulhi_epi16(samples, factors),
+                                               _mm_and_si128(samples, _mm_srai_epi16(factors, 15)));
+      *lo = _mm_unpacklo_epi16(product_lo, product_hi);
+      *hi = _mm_unpackhi_epi16(product_lo, product_hi);
+    };
+    __m128i s0_lo, s0_hi, s1_lo, s1_hi;
+    multiply(s0, inv_frac, &s0_lo, &s0_hi);
+    multiply(s1, frac, &s1_lo, &s1_hi);
+
+    // The sum can't overflow, as the two factors add up to 0x10000.
+    const __m128i sum_lo = _mm_srai_epi32(_mm_add_epi32(s0_lo, s1_lo), 16);
+    const __m128i sum_hi = _mm_srai_epi32(_mm_add_epi32(s0_hi, s1_hi), 16);
+    const __m128i interpolated = _mm_packs_epi32(sum_lo, sum_hi);
+
+    const __m128i no_frac = _mm_cmpeq_epi16(frac, _mm_setzero_si128());
+    const __m128i result =
+        _mm_or_si128(_mm_and_si128(no_frac, s0), _mm_andnot_si128(no_frac, interpolated));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t s0 = vld1q_s16(samples0 + i);
+    const int16x8_t s1 = vld1q_s16(samples1 + i);
+    const uint16x8_t frac = vld1q_u16(fracs + i);
+    const uint16x8_t inv_frac = vsubq_u16(vdupq_n_u16(0), frac);
+
+    const auto widen = [](uint16x4_t factors) {
+      return vreinterpretq_s32_u32(vmovl_u16(factors));
+    };
+    int32x4_t sum_lo = vmulq_s32(vmovl_s16(vget_low_s16(s0)), widen(vget_low_u16(inv_frac)));
+    int32x4_t sum_hi = vmulq_s32(vmovl_s16(vget_high_s16(s0)), widen(vget_high_u16(inv_frac)));
+    sum_lo = vmlaq_s32(sum_lo, vmovl_s16(vget_low_s16(s1)), widen(vget_low_u16(frac)));
+    sum_hi = vmlaq_s32(sum_hi, vmovl_s16(vget_high_s16(s1)), widen(vget_high_u16(frac)));
+    const int16x8_t interpolated = vcombine_s16(vshrn_n_s32(sum_lo, 16), vshrn_n_s32(sum_hi, 16));
+
+    const uint16x8_t no_frac = vceqq_u16(frac, vdupq_n_u16(0));
+    vst1q_s16(output + i, vbslq_s16(no_frac, s0, interpolated));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const u16 curr_frac = fracs[i];
+    const u16 inv_curr_frac = -curr_frac;
+    if (curr_frac)
+      output[i] = ((s32(samples0[i]) * inv_curr_frac) + (s32(samples1[i]) * curr_frac)) >> 16;
+    else
+      output[i] = samples0[i];
+  }
 }
 
 // Reads samples from the input callback, resamples them to <count> samples at
@@ -234,50 +397,19 @@ u16 AcceleratorGetSample()
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+//
+// The input samples are read one at a time first, as the accelerator decodes them serially,
+// recording the four samples each output sample is computed from. The output samples are then
+// computed from those in a separate pass.
+template <typename InputCallback>
+u32 ResampleAudio(InputCallback input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
 
   // If DSP DROM coefficients are available, support polyphase resampling.
-  if (coeffs && srctype == SRCTYPE_POLYPHASE)
-  {
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
-      const s16* c = &coeffs[curr_pos_frac];
-
-      s64 t0 = temp[idx++ & 3];
-      s64 t1 = temp[idx++ & 3];
-      s64 t2 = temp[idx++ & 3];
-      s64 t3 = temp[idx++ & 3];
-
-      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
-
-      output[i] = MathUtil::SaturatingCast<s16>(samp);
-    }
-
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
-  }
-  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
+  const bool polyphase = coeffs && srctype == SRCTYPE_POLYPHASE;
+  if (polyphase || srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
   {
     // This is the circular buffer containing samples to use for the
     // interpolation. It is initialized with the values from the PB, and it
@@ -290,6 +422,11 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
     temp[idx++ & 3] = last_samples[2];
     temp[idx++ & 3] = last_samples[3];
 
+    // The contents of the circular buffer for each output sample, oldest first, and the
+    // fractional position of the output sample.
+    s16 taps[4][MAX_SAMPLES_PER_FRAME];
+    u16 fracs[MAX_SAMPLES_PER_FRAME];
+
     for (u32 i = 0; i < count; ++i)
     {
       curr_pos += ratio;
@@ -302,29 +439,34 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
         curr_pos -= 0x10000;
       }
 
-      // Get our current fractional position, used to know how much of
-      // curr0 and how much of curr1 the output sample should be.
-      u16 curr_frac = curr_pos & 0xFFFF;
-      u16 inv_curr_frac = -curr_frac;
+      taps[0][i] = temp[idx & 3];
+      taps[1][i] = temp[(idx + 1) & 3];
+      taps[2][i] = temp[(idx + 2) & 3];
+      taps[3][i] = temp[(idx + 3) & 3];
+      fracs[i] = curr_pos & 0xFFFF;
+    }
 
-      // Interpolate! If curr_frac is 0, we can simply take the last
-      // sample without any multiplying.
-      s16 sample;
-      if (curr_frac)
+    if (polyphase)
+    {
+      for (u32 i = 0; i < count; ++i)
       {
-        s32 s0 = temp[idx++ & 3];
-        s32 s1 = temp[idx++ & 3];
+        u16 curr_pos_frac = (fracs[i] >> 9) << 2;
+        const s16* c = &coeffs[curr_pos_frac];
 
-        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
-        idx += 2;
-      }
-      else
-      {
-        sample = temp[idx++ & 3];
-        idx += 3;
-      }
+        s64 t0 = taps[0][i];
+        s64 t1 = taps[1][i];
+        s64 t2 = taps[2][i];
+        s64 t3 = taps[3][i];
+
+        s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
 
-      output[i] = sample;
+        output[i] = MathUtil::SaturatingCast<s16>(samp);
+      }
+    }
+    else
+    {
+      // Interpolate between the two oldest samples of the circular buffer.
+      InterpolateLinear(taps[0], taps[1], fracs, output, count);
     }
 
     // Update the four last_samples values.
@@ -350,47 +492,37 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
 // if required.
 void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 {
-  AcceleratorSetup(&pb);
+  HLEAccelerator accelerator(&pb);
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+  u32 curr_pos = ResampleAudio([&accelerator](u32) { return accelerator.GetSample(); }, samples,
+                               count, pb.src.last_samples, pb.src.cur_addr_frac,
+                               HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
-  pb.audio_addr.cur_addr_hi = static_cast<u16>(s_accelerator->GetCurrentAddress() >> 16);
-  pb.audio_addr.cur_addr_lo = static_cast<u16>(s_accelerator->GetCurrentAddress());
-  pb.adpcm.yn1 = s_accelerator->GetYn1();
-  pb.adpcm.yn2 = s_accelerator->GetYn2();
-  pb.adpcm.pred_scale = s_accelerator->GetPredScale();
+  pb.audio_addr.cur_addr_hi = static_cast<u16>(accelerator.GetCurrentAddress() >> 16);
+  pb.audio_addr.cur_addr_lo = static_cast<u16>(accelerator.GetCurrentAddress());
+  pb.adpcm.yn1 = accelerator.GetYn1();
+  pb.adpcm.yn2 = accelerator.GetYn2();
+  pb.adpcm.pred_scale = accelerator.GetPredScale();
 }
 
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
-
   // If volume ramping is disabled, set volume_delta to 0. That way, the
   // mixing loop can avoid testing if volume ramping is enabled at each step,
   // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
+  const u16 volume_delta = ramp ? vd->volume_delta : 0;
 
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+  s16 scaled[MAX_SAMPLES_PER_FRAME];
+  vd->volume = ScaleSamples(input, scaled, count, vd->volume, volume_delta);
+  AddSamples(out, scaled, count);
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
+  if (count != 0)
+    *dpop = scaled[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -416,12 +548,8 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    const s32 sample = ((s32)samples[i] * pb.vol_env.cur_volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = ScaleSamples(samples, samples, count, pb.vol_env.cur_volume,
+                                       static_cast<u16>(pb.vol_env.cur_volume_delta));
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -505,11 +633,7 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #undef RAMP_ON
 
   // Optionally, phase shift left or right channel to simulate 3D sound.
-  if (pb.initial_time_delay.on)
-  {
-    // TODO
-    DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_AX_INITIAL_TIME_DELAY);
-  }
+  // TODO (see ReportVoiceQuirks)
 
 #ifdef AX_WII
   // Wiimote mixing.
@@ -562,6 +686,14 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #endif
 }
 
+// Reports the unimplemented features used by a voice. Unlike ProcessVoice, this must be called
+// on the emulation thread.
+void ReportVoiceQuirks(const PB_TYPE& pb)
+{
+  if (pb.running == 1 && pb.initial_time_delay.on)
+    DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_AX_INITIAL_TIME_DELAY);
+}
+
 }  // namespace
 }  // inline namespace AXGC/AXWii
 }  // namespace DSP::HLE
@@ -0,0 +1,164 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
+
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/Thread.h"
+
+namespace DSP::HLE
+{
+// Frames with fewer voices than this are processed on the calling thread, as waking the workers
+// would cost more than it saves.
+constexpr size_t MIN_PARALLEL_VOICES = 8;
+
+AXVoiceWorkers::~AXVoiceWorkers()
+{
+  StopWorkerThreads();
+}
+
+void AXVoiceWorkers::ResizeWorkerThreads(u32 num_worker_threads)
+{
+  if (m_worker_threads.size() == num_worker_threads)
+    return;
+
+  StopWorkerThreads();
+
+  m_thread_used.assign(num_worker_threads + 1, false);
+  for (u32 i = 0; i < num_worker_threads; i++)
+    m_worker_threads.emplace_back(&AXVoiceWorkers::WorkerThreadRun, this, i + 1);
+}
+
+bool AXVoiceWorkers::HasWorkerThreads() const
+{
+  return !m_worker_threads.empty();
+}
+
+void AXVoiceWorkers::StopWorkerThreads()
+{
+  if (!HasWorkerThreads())
+    return;
+
+  {
+    std::lock_guard guard(m_lock);
+    m_exit_flag.Set();
+    m_worker_wake.notify_all();
+  }
+
+  for (std::thread& thr : m_worker_threads)
+    thr.join();
+  m_worker_threads.clear();
+  m_exit_flag.Clear();
+}
+
+u32 AXVoiceWorkers::GetNumWorkerThreads(int setting)
+{
+  if (setting >= 0)
+    return static_cast<u32>(setting);
+
+  // Automatic number. Leave cores for the CPU, GPU and audio threads. A frame rarely has more
+  // than 64 voices, so more than four threads wouldn't have enough work each.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 3, 0, 3));
+}
+
+void AXVoiceWorkers::Run(size_t num_voices, std::span<const MixBuffer> mix_buffers,
+                         const ProcessFunction& process)
+{
+  m_num_buffers = mix_buffers.size();
+  m_thread_buffers.resize(m_num_buffers * (m_worker_threads.size() + 1));
+  for (size_t i = 0; i < m_num_buffers; i++)
+    m_thread_buffers[i] = mix_buffers[i].samples;
+
+  if (!HasWorkerThreads() || num_voices < MIN_PARALLEL_VOICES)
+  {
+    for (size_t voice = 0; voice < num_voices; voice++)
+      process(voice, m_thread_buffers.data());
+    return;
+  }
+
+  m_samples_per_thread = 0;
+  for (const MixBuffer& buffer : mix_buffers)
+    m_samples_per_thread += buffer.count;
+  m_thread_samples.resize(m_samples_per_thread * m_worker_threads.size());
+
+  int* samples = m_thread_samples.data();
+  for (size_t thread = 1; thread <= m_worker_threads.size(); thread++)
+  {
+    for (size_t i = 0; i < m_num_buffers; i++)
+    {
+      m_thread_buffers[thread * m_num_buffers + i] = samples;
+      samples += mix_buffers[i].count;
+    }
+  }
+
+  std::unique_lock lock(m_lock);
+  std::fill(m_thread_used.begin(), m_thread_used.end(), false);
+  m_process = &process;
+  m_num_voices = num_voices;
+  m_next_voice = 0;
+  m_voices_remaining = num_voices;
+  m_worker_wake.notify_all();
+
+  // Process voices on this thread as well, rather than just waiting for the workers.
+  RunVoices(lock, 0);
+  m_frame_done.wait(lock, [this] { return m_voices_remaining == 0; });
+  m_process = nullptr;
+
+  // Add the samples of each worker to the output buffers, in a fixed order.
+  for (size_t thread = 1; thread <= m_worker_threads.size(); thread++)
+  {
+    if (!m_thread_used[thread])
+      continue;
+
+    for (size_t i = 0; i < m_num_buffers; i++)
+    {
+      const int* thread_samples = m_thread_buffers[thread * m_num_buffers + i];
+      for (u32 j = 0; j < mix_buffers[i].count; j++)
+        mix_buffers[i].samples[j] += thread_samples[j];
+    }
+  }
+}
+
+void AXVoiceWorkers::RunVoices(std::unique_lock<std::mutex>& lock, u32 thread_index)
+{
+  while (m_next_voice < m_num_voices)
+  {
+    const size_t voice = m_next_voice++;
+    const bool first_voice = !m_thread_used[thread_index];
+    m_thread_used[thread_index] = true;
+    int* const* buffers = &m_thread_buffers[thread_index * m_num_buffers];
+    lock.unlock();
+
+    // Worker buffers are only cleared once the worker gets a voice to mix.
+    if (first_voice && thread_index != 0)
+    {
+      std::fill_n(m_thread_samples.begin() + (thread_index - 1) * m_samples_per_thread,
+                  m_samples_per_thread, 0);
+    }
+
+    (*m_process)(voice, buffers);
+
+    lock.lock();
+    if (--m_voices_remaining == 0)
+      m_frame_done.notify_one();
+  }
+}
+
+void AXVoiceWorkers::WorkerThreadRun(u32 thread_index)
+{
+  Common::SetCurrentThreadName("AX voice worker");
+
+  std::unique_lock lock(m_lock);
+  while (true)
+  {
+    m_worker_wake.wait(lock,
+                       [this] { return m_exit_flag.IsSet() || m_next_voice < m_num_voices; });
+    if (m_exit_flag.IsSet())
+      break;
+
+    RunVoices(lock, thread_index);
+  }
+}
+}  // namespace DSP::HLE
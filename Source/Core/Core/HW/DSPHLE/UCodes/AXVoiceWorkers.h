@@ -0,0 +1,80 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+
+namespace DSP::HLE
+{
+// Processes the voices of an AX frame in parallel on a set of worker threads. The calling thread
+// processes voices as well, mixing them directly into the output buffers. The worker threads mix
+// into buffers of their own, which are added to the output buffers once all voices are done, in
+// worker order. Voices are mixed with integer additions, so the result is identical to mixing
+// the voices one after the other, no matter which thread processed which voice.
+class AXVoiceWorkers
+{
+public:
+  struct MixBuffer
+  {
+    int* samples;
+    u32 count;
+  };
+
+  // Called with the index of the voice to process, and one pointer per mix buffer to mix to.
+  using ProcessFunction = std::function<void(size_t voice, int* const* buffers)>;
+
+  AXVoiceWorkers() = default;
+  ~AXVoiceWorkers();
+
+  AXVoiceWorkers(const AXVoiceWorkers&) = delete;
+  AXVoiceWorkers& operator=(const AXVoiceWorkers&) = delete;
+
+  void ResizeWorkerThreads(u32 num_worker_threads);
+  bool HasWorkerThreads() const;
+  void StopWorkerThreads();
+
+  // Gets the number of worker threads to use for the given setting (-1 = automatic).
+  static u32 GetNumWorkerThreads(int setting);
+
+  // Calls process for each voice in [0, num_voices), and returns once all have been processed.
+  // Voices must not depend on each other, besides being mixed to the same buffers.
+  void Run(size_t num_voices, std::span<const MixBuffer> mix_buffers,
+           const ProcessFunction& process);
+
+private:
+  void WorkerThreadRun(u32 thread_index);
+
+  // Processes voices of the current frame until none are left. m_lock must be held by the caller.
+  void RunVoices(std::unique_lock<std::mutex>& lock, u32 thread_index);
+
+  std::vector<std::thread> m_worker_threads;
+  Common::Flag m_exit_flag;
+
+  std::mutex m_lock;
+  std::condition_variable m_worker_wake;
+  std::condition_variable m_frame_done;
+  const ProcessFunction* m_process = nullptr;
+  size_t m_num_voices = 0;
+  size_t m_next_voice = 0;
+  size_t m_voices_remaining = 0;
+
+  // Mix buffer pointers for each thread, m_num_buffers per thread. The calling thread's point to
+  // the output buffers, and the worker threads' into m_thread_samples.
+  size_t m_num_buffers = 0;
+  std::vector<int*> m_thread_buffers;
+  size_t m_samples_per_thread = 0;
+  std::vector<int> m_thread_samples;
+
+  // Whether each thread has processed a voice of the current frame.
+  std::vector<bool> m_thread_used;
+};
+}  // namespace DSP::HLE
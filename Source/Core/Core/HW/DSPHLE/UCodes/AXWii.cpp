@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
+#include <span>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -410,22 +412,21 @@ void AXWiiUCode::ReinjectUpdatesFields(AXPBWii& pb, u16* num_updates, u32 update
 
 void AXWiiUCode::ProcessPBList(u32 pb_addr)
 {
-  // Samples per millisecond. In theory DSP sampling rate can be changed from
-  // 32KHz to 48KHz, but AX always process at 32KHz.
-  constexpr u32 spms = 32;
+  if (m_voice_workers.HasWorkerThreads() && ProcessPBListInParallel(pb_addr))
+    return;
 
-  AXPBWii pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+  int* const buffers[] = {m_samples_main_left, m_samples_main_right, m_samples_main_surround,
                           m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
                           m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
                           m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
                           m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
                           m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
+                          m_samples_wm3,       m_samples_aux3};
+
+  AXPBWii pb;
 
+  while (pb_addr)
+  {
     ReadPB(pb_addr, pb, m_crc);
 
     u16 num_updates[3];
@@ -433,29 +434,120 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
     u32 updates_addr;
     if (ExtractUpdatesFields(pb, num_updates, updates, &updates_addr))
     {
-      for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
-      {
-        ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
-                     m_coeffs_checksum ? m_coeffs.data() : nullptr);
-
-        // Forward the buffers
-        for (auto& ptr : buffers.ptrs)
-          ptr += spms;
-      }
+      ProcessPB(pb, num_updates, updates, buffers);
       ReinjectUpdatesFields(pb, num_updates, updates_addr);
     }
     else
     {
-      ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
-                   m_coeffs_checksum ? m_coeffs.data() : nullptr);
+      ProcessPB(pb, nullptr, nullptr, buffers);
     }
+    ReportVoiceQuirks(pb);
 
     WritePB(pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
 }
 
+bool AXWiiUCode::ProcessPBListInParallel(u32 pb_addr)
+{
+  // Read the whole list first. Updates can change the address of the next PB, so they are
+  // applied to a copy of each PB to find it.
+  m_wii_pb_list.clear();
+  while (pb_addr)
+  {
+    if (m_wii_pb_list.size() == MAX_PARALLEL_VOICES)
+      return false;
+
+    WiiPBListVoice& voice = m_wii_pb_list.emplace_back();
+    voice.addr = pb_addr;
+    ReadPB(pb_addr, voice.pb, m_crc);
+    voice.has_updates =
+        ExtractUpdatesFields(voice.pb, voice.num_updates, voice.updates, &voice.updates_addr);
+
+    AXPBWii updated_pb = voice.pb;
+    if (voice.has_updates)
+    {
+      for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+        ApplyUpdatesForMs(curr_ms, updated_pb, voice.num_updates, voice.updates);
+    }
+    pb_addr = HILO_TO_32(updated_pb.next_pb);
+  }
+
+  // Each buffer holds 3ms of audio.
+  const std::array<AXVoiceWorkers::MixBuffer, 20> mix_buffers{{
+      {m_samples_main_left, 32 * 3},
+      {m_samples_main_right, 32 * 3},
+      {m_samples_main_surround, 32 * 3},
+      {m_samples_auxA_left, 32 * 3},
+      {m_samples_auxA_right, 32 * 3},
+      {m_samples_auxA_surround, 32 * 3},
+      {m_samples_auxB_left, 32 * 3},
+      {m_samples_auxB_right, 32 * 3},
+      {m_samples_auxB_surround, 32 * 3},
+      {m_samples_auxC_left, std::size(m_samples_auxC_left)},
+      {m_samples_auxC_right, std::size(m_samples_auxC_right)},
+      {m_samples_auxC_surround, std::size(m_samples_auxC_surround)},
+      {m_samples_wm0, std::size(m_samples_wm0)},
+      {m_samples_aux0, std::size(m_samples_aux0)},
+      {m_samples_wm1, std::size(m_samples_wm1)},
+      {m_samples_aux1, std::size(m_samples_aux1)},
+      {m_samples_wm2, std::size(m_samples_wm2)},
+      {m_samples_aux2, std::size(m_samples_aux2)},
+      {m_samples_wm3, std::size(m_samples_wm3)},
+      {m_samples_aux3, std::size(m_samples_aux3)},
+  }};
+  m_voice_workers.Run(m_wii_pb_list.size(), mix_buffers, [this](size_t i, int* const* buffers) {
+    WiiPBListVoice& voice = m_wii_pb_list[i];
+    if (voice.has_updates)
+      ProcessPB(voice.pb, voice.num_updates, voice.updates, buffers);
+    else
+      ProcessPB(voice.pb, nullptr, nullptr, buffers);
+  });
+
+  for (WiiPBListVoice& voice : m_wii_pb_list)
+  {
+    if (voice.has_updates)
+      ReinjectUpdatesFields(voice.pb, voice.num_updates, voice.updates_addr);
+    ReportVoiceQuirks(voice.pb);
+    WritePB(voice.addr, voice.pb, m_crc);
+  }
+
+  return true;
+}
+
+void AXWiiUCode::ProcessPB(AXPBWii& pb, u16* num_updates, u16* updates, int* const* buffers)
+{
+  // Samples per millisecond. In theory DSP sampling rate can be changed from
+  // 32KHz to 48KHz, but AX always process at 32KHz.
+  constexpr u32 spms = 32;
+  // Wiimote speakers are mixed at 6KHz.
+  constexpr u32 wm_spms = 6;
+
+  AXBuffers voice_buffers;
+  std::copy_n(buffers, std::size(voice_buffers.ptrs), voice_buffers.ptrs);
+
+  if (!num_updates)
+  {
+    ProcessVoice(pb, voice_buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+                 m_coeffs_checksum ? m_coeffs.data() : nullptr);
+    return;
+  }
+
+  for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+  {
+    ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
+    ProcessVoice(pb, voice_buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+                 m_coeffs_checksum ? m_coeffs.data() : nullptr);
+
+    // Forward the buffers. The last 8 are the Wiimote buffers.
+    const std::span<int*> ptrs(voice_buffers.ptrs);
+    for (int*& ptr : ptrs.first(ptrs.size() - 8))
+      ptr += spms;
+    for (int*& ptr : ptrs.last(8))
+      ptr += wm_spms;
+  }
+}
+
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
 {
   std::array<u16, 96> volume_ramp;
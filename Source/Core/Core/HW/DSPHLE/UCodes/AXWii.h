@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 
@@ -63,12 +65,30 @@ protected:
   void AddToLR(u32 val_addr, bool neg);
   void AddSubToLR(u32 val_addr);
   void ProcessPBList(u32 pb_addr);
+  bool ProcessPBListInParallel(u32 pb_addr);
+  // Processes 3ms of audio from a PB, mixing it to the given buffers (in the order of AXBuffers).
+  // num_updates and updates are the fields extracted by ExtractUpdatesFields, or null if the PB
+  // has no updates.
+  void ProcessPB(AXPBWii& pb, u16* num_updates, u16* updates, int* const* buffers);
   void MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume);
   void UploadAUXMixLRSC(int aux_id, u32* addresses, u16 volume);
   void OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool upload_auxc);
   void OutputWMSamples(u32* addresses);  // 4 addresses
 
 private:
+  // A PB read ahead from the PB list, along with its extracted updates.
+  struct WiiPBListVoice
+  {
+    u32 addr;
+    AXPBWii pb;
+    bool has_updates;
+    u16 num_updates[3];
+    u16 updates[1024];
+    u32 updates_addr;
+  };
+
+  std::vector<WiiPBListVoice> m_wii_pb_list;
+
   enum CmdType
   {
     CMD_SETUP = 0x00,
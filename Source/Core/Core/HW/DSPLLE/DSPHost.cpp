@@ -5,7 +5,10 @@
 
 #include <string>
 
+#include <fmt/format.h>
+
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Core/Config/MainSettings.h"
@@ -107,4 +110,12 @@ void UpdateDebugger()
 {
   Host_RefreshDSPDebuggerWindow();
 }
+
+std::string GetBlockCachePath(u32 iram_crc)
+{
+  if (!Config::Get(Config::MAIN_DSP_JIT_CACHE))
+    return {};
+
+  return fmt::format("{}DSP/{:08x}.blocks", File::GetUserPath(D_CACHE_IDX), iram_crc);
+}
 }  // namespace DSP::Host
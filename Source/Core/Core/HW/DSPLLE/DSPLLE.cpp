@@ -3,6 +3,7 @@
 
 #include "Core/HW/DSPLLE/DSPLLE.h"
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -26,11 +27,19 @@
 #include "Core/DSP/Interpreter/DSPInterpreter.h"
 #include "Core/DSP/Jit/DSPEmitterBase.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/Host.h"
 
 namespace DSP::LLE
 {
-DSPLLE::DSPLLE() = default;
+// The number of CPU cycles between DSP updates while the DSP is busy.
+constexpr u32 BASE_UPDATE_RATE = 12600;  // TO BE TWEAKED
+// While the DSP waits in an idle loop for mail, the time between updates grows up to this.
+constexpr u32 MAX_UPDATE_RATE = BASE_UPDATE_RATE * 8;
+
+DSPLLE::DSPLLE() : m_update_rate{BASE_UPDATE_RATE}
+{
+}
 
 DSPLLE::~DSPLLE()
 {
@@ -51,6 +60,7 @@ void DSPLLE::DoState(PointerWrap& p)
   }
   m_dsp_core.DoState(p);
   p.Do(m_cycle_count);
+  p.Do(m_update_rate);
 }
 
 // Regular thread
@@ -150,6 +160,7 @@ bool DSPLLE::Initialize(bool wii, bool dsp_thread)
 
   m_wii = wii;
   m_is_dsp_on_thread = dsp_thread;
+  m_update_rate = BASE_UPDATE_RATE;
 
   m_dsp_core.Reset();
 
@@ -181,8 +192,19 @@ void DSPLLE::Shutdown()
   m_dsp_core.Shutdown();
 }
 
+void DSPLLE::ResetUpdateRate()
+{
+  if (m_update_rate == BASE_UPDATE_RATE)
+    return;
+
+  // The next update was scheduled at the longer rate, so move it closer as well.
+  m_update_rate = BASE_UPDATE_RATE;
+  SystemTimers::DSPUpdateRateLowered();
+}
+
 u16 DSPLLE::DSP_WriteControlRegister(u16 value)
 {
+  ResetUpdateRate();
   m_dsp_core.GetInterpreter().WriteControlRegister(value);
 
   if ((value & CR_EXTERNAL_INT) != 0)
@@ -243,6 +265,7 @@ void DSPLLE::DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value)
   if (cpu_mailbox)
   {
     m_dsp_core.WriteMailboxLow(Mailbox::CPU, value);
+    ResetUpdateRate();
   }
   else
   {
@@ -273,19 +296,37 @@ void DSPLLE::DSP_Update(int cycles)
   {
     // ~1/6th as many cycles as the period PPC-side.
     m_dsp_core.RunCycles(dsp_cycles);
+    AdaptUpdateRate();
   }
   else
   {
     // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
     m_ppc_event.Wait();
+    AdaptUpdateRate();
     m_cycle_count.fetch_add(dsp_cycles);
     m_dsp_event.Set();
   }
 }
 
+void DSPLLE::AdaptUpdateRate()
+{
+  // A DSP that is halted or waiting for mail in an idle loop only needs to be woken up when the CPU
+  // talks to it, which resets the rate. Until then, run it in longer bursts so that there are fewer
+  // switches between the CPU and the DSP. Mailbox reads by the CPU still advance the DSP in small
+  // steps, so mails are exchanged in the same order.
+  const SDSP& state = m_dsp_core.DSPState();
+  const bool is_idle =
+      (state.control_reg & CR_HALT) != 0 || state.GetAnalyzer().IsIdleSkip(state.pc);
+  const bool has_pending_mail = (m_dsp_core.PeekMailbox(Mailbox::CPU) & 0x80000000) != 0;
+  if (is_idle && !has_pending_mail && !state.external_interrupt_waiting.load())
+    m_update_rate = std::min(m_update_rate * 2, MAX_UPDATE_RATE);
+  else
+    m_update_rate = BASE_UPDATE_RATE;
+}
+
 u32 DSPLLE::DSP_UpdateRate()
 {
-  return 12600;  // TO BE TWEAKED
+  return m_update_rate;
 }
 
 void DSPLLE::PauseAndLock(bool do_lock, bool unpause_on_unlock)
@@ -41,6 +41,11 @@ public:
 private:
   static void DSPThread(DSPLLE* dsp_lle);
 
+  // Called between slices, while the DSP isn't running.
+  void AdaptUpdateRate();
+  // Called when the CPU talks to the DSP.
+  void ResetUpdateRate();
+
   DSPCore m_dsp_core;
   std::thread m_dsp_thread;
   std::mutex m_dsp_thread_mutex;
@@ -51,5 +56,7 @@ private:
   Common::Event m_dsp_event;
   Common::Event m_ppc_event;
   bool m_request_disable_thread = false;
+
+  u32 m_update_rate;
 };
 }  // namespace DSP::LLE
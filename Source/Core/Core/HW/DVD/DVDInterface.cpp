@@ -156,6 +156,8 @@ struct DVDInterfaceState::Data
   UDICFG DICFG;
 
   StreamADPCM::ADPCMDecoder adpcm_decoder;
+  // Reused for every chunk of DTK audio.
+  std::vector<s16> dtk_pcm;
 
   // DTK
   bool stream = false;
@@ -261,22 +263,11 @@ static size_t ProcessDTKSamples(std::vector<s16>* temp_pcm, const std::vector<u8
 {
   auto& state = Core::System::GetInstance().GetDVDInterfaceState().GetData();
 
-  size_t samples_processed = 0;
-  size_t bytes_processed = 0;
-  while (samples_processed < temp_pcm->size() / 2 && bytes_processed < audio_data.size())
-  {
-    state.adpcm_decoder.DecodeBlock(&(*temp_pcm)[samples_processed * 2],
-                                    &audio_data[bytes_processed]);
-    for (size_t i = 0; i < StreamADPCM::SAMPLES_PER_BLOCK * 2; ++i)
-    {
-      // TODO: Fix the mixer so it can accept non-byte-swapped samples.
-      s16* sample = &(*temp_pcm)[samples_processed * 2 + i];
-      *sample = Common::swap16(*sample);
-    }
-    samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
-    bytes_processed += StreamADPCM::ONE_BLOCK_SIZE;
-  }
-  return samples_processed;
+  // TODO: Fix the mixer so it can accept non-byte-swapped samples.
+  const size_t num_blocks = std::min(temp_pcm->size() / 2 / StreamADPCM::SAMPLES_PER_BLOCK,
+                                     audio_data.size() / StreamADPCM::ONE_BLOCK_SIZE);
+  state.adpcm_decoder.DecodeBlocksBE(temp_pcm->data(), audio_data.data(), num_blocks);
+  return num_blocks * StreamADPCM::SAMPLES_PER_BLOCK;
 }
 
 static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
@@ -339,11 +330,11 @@ static void DTKStreamingCallback(DIInterruptType interrupt_type, const std::vect
   if (interrupt_type == DIInterruptType::TCINT)
   {
     // Send audio to the mixer.
-    std::vector<s16> temp_pcm(state.pending_samples * 2, 0);
-    ProcessDTKSamples(&temp_pcm, audio_data);
+    state.dtk_pcm.assign(state.pending_samples * 2, 0);
+    ProcessDTKSamples(&state.dtk_pcm, audio_data);
 
     SoundStream* sound_stream = system.GetSoundStream();
-    sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(), state.pending_samples);
+    sound_stream->GetMixer()->PushStreamingSamples(state.dtk_pcm.data(), state.pending_samples);
 
     if (state.stream && AudioInterface::IsPlaying())
     {
@@ -151,6 +151,7 @@ void CEXIAMBaseboard::DMARead(u32 addr, u32 size)
 
   m_backup->Flush();
 
+  memory.MarkRangeWritten(addr, size);
   m_backup->ReadBytes(memory.GetPointer(addr), size);
 }
   void CEXIAMBaseboard::TransferByte(u8& _byte)
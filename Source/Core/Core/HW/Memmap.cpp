@@ -14,12 +14,16 @@
 #include <memory>
 #include <tuple>
 
+#include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -33,6 +37,7 @@
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
+#include "Core/MemTools.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -41,6 +46,23 @@
 
 namespace Memory
 {
+// Write tracking states of a host page.
+enum : u8
+{
+  // Not write-protected. Treated as written.
+  TRACKED_PAGE_UNTRACKED = 0,
+  // Write-protected, and not written since.
+  TRACKED_PAGE_CLEAN = 1,
+  // Written since it was last write-protected. No longer write-protected.
+  TRACKED_PAGE_WRITTEN = 2,
+  // Written, and being made writable again by the thread that noticed the write.
+  TRACKED_PAGE_UNPROTECTING = 3,
+};
+
+// Pages that have been written this many times are no longer write-protected, as the faults
+// would cost more than whatever tracking them saves.
+constexpr u8 MAX_TRACKED_PAGE_WRITES = 8;
+
 MemoryManager::MemoryManager() = default;
 MemoryManager::~MemoryManager() = default;
 
@@ -158,6 +180,15 @@ void MemoryManager::Init()
 
   Clear();
 
+  if (IsWriteTrackingSupported())
+  {
+    m_tracked_page_size = static_cast<u32>(Common::PageSize());
+    m_tracked_page_count = (GetRamSize() + (m_exram ? GetExRamSize() : 0)) / m_tracked_page_size;
+    m_tracked_page_states = std::make_unique<std::atomic<u8>[]>(m_tracked_page_count);
+    m_tracked_page_write_counts = std::make_unique<std::atomic<u8>[]>(m_tracked_page_count);
+    m_tracked_page_generations = std::make_unique<std::atomic<u64>[]>(m_tracked_page_count);
+  }
+
   INFO_LOG_FMT(MEMMAP, "Memory system initialized. RAM at {}", fmt::ptr(m_ram));
   m_is_initialized = true;
 }
@@ -204,6 +235,15 @@ bool MemoryManager::InitFastmemArena()
 
 void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  std::lock_guard lock(m_write_tracking_lock);
+
+  // The fault handler walks the logical views without taking the lock, so wait for any that are
+  // running to finish before changing them.
+  m_logical_views_changing.store(true);
+  while (m_write_tracking_faults_in_progress.load() != 0)
+    Common::YieldCPU();
+  Common::ScopeGuard changed_guard([this] { m_logical_views_changing.store(false); });
+
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -248,7 +288,7 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                   intersection_start, mapped_size, logical_address);
               exit(0);
             }
-            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
           }
 
           m_logical_page_mappings[i] =
@@ -257,6 +297,10 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
       }
     }
   }
+
+  // The new logical views are writable, so tracked pages could be written without a fault.
+  if (IsWriteTrackingEnabled())
+    ResetWriteTrackingLocked();
 }
 
 void MemoryManager::DoState(PointerWrap& p)
@@ -297,6 +341,10 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
+  // Loading a state overwrites all of RAM, so don't fault on every tracked page.
+  if (p.IsReadMode())
+    ResetWriteTracking();
+
   p.DoArray(m_ram, current_ram_size);
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
@@ -323,6 +371,9 @@ void MemoryManager::Shutdown()
   }
   m_arena.ReleaseSHMSegment();
   m_mmio_mapping.reset();
+  m_tracked_page_count = 0;
+  m_tracked_page_states.reset();
+  m_tracked_page_write_counts.reset();
   INFO_LOG_FMT(MEMMAP, "Memory system shut down.");
 }
 
@@ -366,6 +417,280 @@ void MemoryManager::Clear()
     memset(m_exram, 0, GetExRamSize());
 }
 
+bool MemoryManager::IsWriteTrackingSupported()
+{
+#if defined(__APPLE__)
+  // The Mach exception handler only catches faults raised on the CPU thread, and the protection
+  // of the RAM views can't be changed on ARM64.
+  return false;
+#else
+  return EMM::IsExceptionHandlerSupported();
+#endif
+}
+
+void MemoryManager::SetWriteTrackingEnabled(bool enabled)
+{
+  std::lock_guard lock(m_write_tracking_lock);
+  if (enabled == IsWriteTrackingEnabled())
+    return;
+
+  ASSERT(!enabled || m_tracked_page_count != 0);
+  if (!enabled)
+    ResetWriteTrackingLocked();
+  m_write_tracking_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::optional<u64> MemoryManager::TrackWrites(u32 address, u32 size)
+{
+  if (!IsWriteTrackingEnabled())
+    return std::nullopt;
+
+  u32 first_page, end_page;
+  if (!GetTrackedPages(address, size, &first_page, &end_page))
+    return std::nullopt;
+
+  std::lock_guard lock(m_write_tracking_lock);
+  if (!IsWriteTrackingEnabled())
+    return std::nullopt;
+
+  // Protect runs of pages at once to keep the number of syscalls down. Pages that are still being
+  // unprotected after a write are left alone, and report being written until the next call.
+  // Writes to pages that weren't protected went unseen, so those get a new generation when they
+  // are protected again. Only the fault handler changes page states without holding the lock, and
+  // it only changes clean pages.
+  u32 run_start = end_page;
+  for (u32 page = first_page; page < end_page; page++)
+  {
+    const u8 state = m_tracked_page_states[page].load(std::memory_order_relaxed);
+    if (state != TRACKED_PAGE_CLEAN && state != TRACKED_PAGE_UNPROTECTING &&
+        m_tracked_page_write_counts[page].load(std::memory_order_relaxed) <
+            MAX_TRACKED_PAGE_WRITES)
+    {
+      m_tracked_page_generations[page].store(m_write_generation.fetch_add(1) + 1,
+                                             std::memory_order_relaxed);
+      m_tracked_page_states[page].store(TRACKED_PAGE_CLEAN, std::memory_order_release);
+      if (run_start == end_page)
+        run_start = page;
+    }
+    else if (run_start != end_page)
+    {
+      SetTrackedPagesProtection(run_start, page, true);
+      run_start = end_page;
+    }
+  }
+  if (run_start != end_page)
+    SetTrackedPagesProtection(run_start, end_page, true);
+
+  u64 generation = 0;
+  for (u32 page = first_page; page < end_page; page++)
+  {
+    if (m_tracked_page_states[page].load(std::memory_order_acquire) != TRACKED_PAGE_CLEAN)
+      return std::nullopt;
+    generation =
+        std::max(generation, m_tracked_page_generations[page].load(std::memory_order_relaxed));
+  }
+  return generation;
+}
+
+bool MemoryManager::WasRangeWritten(u32 address, u32 size, u64 generation) const
+{
+  if (!IsWriteTrackingEnabled())
+    return true;
+
+  u32 first_page, end_page;
+  if (!GetTrackedPages(address, size, &first_page, &end_page))
+    return true;
+
+  for (u32 page = first_page; page < end_page; page++)
+  {
+    if (m_tracked_page_states[page].load(std::memory_order_acquire) != TRACKED_PAGE_CLEAN ||
+        m_tracked_page_generations[page].load(std::memory_order_relaxed) > generation)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MemoryManager::MarkRangeWritten(u32 address, u32 size)
+{
+  if (!IsWriteTrackingEnabled())
+    return;
+
+  u32 first_page, end_page;
+  if (!GetTrackedPages(address, size, &first_page, &end_page))
+    return;
+
+  std::lock_guard lock(m_write_tracking_lock);
+  MarkTrackedPagesWritten(first_page, end_page);
+}
+
+void MemoryManager::ResetWriteTracking()
+{
+  std::lock_guard lock(m_write_tracking_lock);
+  if (IsWriteTrackingEnabled())
+    ResetWriteTrackingLocked();
+}
+
+bool MemoryManager::HandleWriteTrackingFault(uintptr_t fault_address)
+{
+  if (!IsWriteTrackingEnabled())
+    return false;
+
+  // This runs in a signal handler, possibly on a thread that holds m_write_tracking_lock, so it
+  // only uses atomics. The logical views can't be changed while it is looking at them.
+  while (true)
+  {
+    m_write_tracking_faults_in_progress.fetch_add(1);
+    if (!m_logical_views_changing.load())
+      break;
+    m_write_tracking_faults_in_progress.fetch_sub(1);
+    while (m_logical_views_changing.load())
+      Common::YieldCPU();
+  }
+  Common::ScopeGuard fault_guard([this] { m_write_tracking_faults_in_progress.fetch_sub(1); });
+
+  u32 physical_address = 0;
+  const auto find_in_view = [&](const void* view, u32 view_physical_address, u32 view_size) {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(view);
+    if (!view || fault_address < start || fault_address - start >= view_size)
+      return false;
+    physical_address = view_physical_address + static_cast<u32>(fault_address - start);
+    return true;
+  };
+
+  bool found = find_in_view(m_ram, 0x00000000, GetRamSize()) ||
+               (m_exram && find_in_view(m_exram, 0x10000000, GetExRamSize()));
+  if (!found && m_is_fastmem_arena_initialized)
+  {
+    found = find_in_view(m_physical_base, 0x00000000, GetRamSize()) ||
+            (m_exram && find_in_view(m_physical_base + 0x10000000, 0x10000000, GetExRamSize()));
+    for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+    {
+      if (found)
+        break;
+      found = find_in_view(entry.mapped_pointer, entry.physical_address, entry.mapped_size);
+    }
+  }
+
+  u32 first_page, end_page;
+  if (!found || !GetTrackedPages(physical_address, 1, &first_page, &end_page))
+    return false;
+
+  // Another thread may have faulted on the same page first, in which case it is already writable
+  // again (or about to be) and the faulting access just needs to be retried.
+  MarkTrackedPagesWritten(first_page, end_page);
+  return true;
+}
+
+bool MemoryManager::GetTrackedPages(u32 address, u32 size, u32* first_page, u32* end_page) const
+{
+  if (size == 0 || m_tracked_page_count == 0)
+    return false;
+
+  // Tracked offsets cover MEM1, followed by MEM2.
+  u32 offset;
+  u32 region_end;
+  address &= 0x3FFFFFFF;
+  if (address < GetRamSize())
+  {
+    offset = address;
+    region_end = GetRamSize();
+  }
+  else if (m_exram && (address >> 28) == 0x1 && (address & 0x0FFFFFFF) < GetExRamSize())
+  {
+    offset = GetRamSize() + (address & 0x0FFFFFFF);
+    region_end = GetRamSize() + GetExRamSize();
+  }
+  else
+  {
+    return false;
+  }
+
+  const u32 end = static_cast<u32>(std::min<u64>(u64{offset} + size, region_end));
+  *first_page = offset / m_tracked_page_size;
+  *end_page = (end + m_tracked_page_size - 1) / m_tracked_page_size;
+  return true;
+}
+
+void MemoryManager::SetTrackedPagesProtection(u32 first_page, u32 end_page, bool write_protect)
+{
+  const auto protect = [write_protect](void* pointer, size_t size) {
+    if (write_protect)
+      Common::WriteProtectMemory(pointer, size);
+    else
+      Common::UnWriteProtectMemory(pointer, size);
+  };
+
+  // The pages are always within a single region.
+  const u32 offset = first_page * m_tracked_page_size;
+  const u32 size = (end_page - first_page) * m_tracked_page_size;
+  const bool is_mem1 = offset < GetRamSize();
+  const u32 physical_address = is_mem1 ? offset : 0x10000000 + offset - GetRamSize();
+  protect(is_mem1 ? m_ram + offset : m_exram + offset - GetRamSize(), size);
+
+  if (!m_is_fastmem_arena_initialized)
+    return;
+
+  protect(m_physical_base + physical_address, size);
+  for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+  {
+    const u32 start = std::max(entry.physical_address, physical_address);
+    const u32 end = std::min(entry.physical_address + entry.mapped_size, physical_address + size);
+    if (start < end)
+      protect(static_cast<u8*>(entry.mapped_pointer) + start - entry.physical_address, end - start);
+  }
+}
+
+void MemoryManager::MarkTrackedPagesWritten(u32 first_page, u32 end_page)
+{
+  // Each clean page is claimed by exactly one thread, which makes it writable and only then marks
+  // it as written, so that TrackWrites can't protect it again halfway through.
+  u32 run_start = end_page;
+  const auto unprotect_run = [this, &run_start, end_page](u32 run_end) {
+    SetTrackedPagesProtection(run_start, run_end, false);
+    for (u32 page = run_start; page < run_end; page++)
+      m_tracked_page_states[page].store(TRACKED_PAGE_WRITTEN, std::memory_order_release);
+    run_start = end_page;
+  };
+
+  for (u32 page = first_page; page < end_page; page++)
+  {
+    u8 state = TRACKED_PAGE_CLEAN;
+    if (m_tracked_page_states[page].compare_exchange_strong(state, TRACKED_PAGE_UNPROTECTING,
+                                                            std::memory_order_acq_rel))
+    {
+      m_tracked_page_generations[page].store(m_write_generation.fetch_add(1) + 1,
+                                             std::memory_order_relaxed);
+      const u8 write_count = m_tracked_page_write_counts[page].load(std::memory_order_relaxed);
+      if (write_count < MAX_TRACKED_PAGE_WRITES)
+        m_tracked_page_write_counts[page].store(write_count + 1, std::memory_order_relaxed);
+      if (run_start == end_page)
+        run_start = page;
+    }
+    else if (run_start != end_page)
+    {
+      unprotect_run(page);
+    }
+  }
+  if (run_start != end_page)
+    unprotect_run(end_page);
+}
+
+void MemoryManager::ResetWriteTrackingLocked()
+{
+  const u32 mem1_page_count = GetRamSize() / m_tracked_page_size;
+  SetTrackedPagesProtection(0, mem1_page_count, false);
+  if (m_tracked_page_count > mem1_page_count)
+    SetTrackedPagesProtection(mem1_page_count, m_tracked_page_count, false);
+
+  for (u32 page = 0; page < m_tracked_page_count; page++)
+  {
+    m_tracked_page_states[page].store(TRACKED_PAGE_UNTRACKED, std::memory_order_relaxed);
+    m_tracked_page_write_counts[page].store(0, std::memory_order_relaxed);
+  }
+}
+
 u8* MemoryManager::GetPointerForRange(u32 address, size_t size) const
 {
   // Make sure we don't have a range spanning 2 separate banks
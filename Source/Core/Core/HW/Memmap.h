@@ -4,7 +4,10 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -49,6 +52,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 class MemoryManager
@@ -97,6 +101,34 @@ public:
 
   void Clear();
 
+  // Write tracking lets other components (e.g. the texture cache) find out whether a range of
+  // MEM1/MEM2 has been written since it was last looked at, without reading it again. Tracked
+  // pages are write-protected in every view, and the first write to one is caught by the fastmem
+  // exception handler, which marks the page as written and makes it writable again. Because of
+  // this, tracking can only be enabled while that handler is installed.
+  static bool IsWriteTrackingSupported();
+  bool IsWriteTrackingEnabled() const
+  {
+    return m_write_tracking_enabled.load(std::memory_order_relaxed);
+  }
+  void SetWriteTrackingEnabled(bool enabled);
+  // Starts tracking writes to the range again. Every page has a write generation, which is set
+  // from a counter shared by all pages whenever the page is written or starts being tracked again.
+  // Returns the newest generation of the range, or nothing if some of its pages aren't tracked.
+  // Pages which keep getting written are not tracked.
+  std::optional<u64> TrackWrites(u32 address, u32 size);
+  // Returns true if any page of the range has a newer generation than the given one returned by
+  // TrackWrites, or isn't being tracked. The pages may be shared with other ranges, so this doesn't
+  // depend on which range was tracked last.
+  bool WasRangeWritten(u32 address, u32 size, u64 generation) const;
+  // Must be called before writing to a range of RAM in a way that does not raise a fault, such as
+  // reading a file straight into emulated memory.
+  void MarkRangeWritten(u32 address, u32 size);
+  // Stops tracking all pages and makes them writable.
+  void ResetWriteTracking();
+  // Called by the exception handler. Returns true if the fault was caused by a tracked page.
+  bool HandleWriteTrackingFault(uintptr_t fault_address);
+
   // Routines to access physically addressed memory, designed for use by
   // emulated hardware outside the CPU. Use "Device_" prefix.
   std::string GetString(u32 em_address, size_t size = 0);
@@ -238,6 +270,27 @@ private:
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings;
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings;
 
+  // Write tracking state. Tracked pages are host pages, numbered from the start of MEM1 and
+  // continuing into MEM2. m_write_tracking_lock serializes everything but the fault handler, which
+  // can't take locks. The page states are changed with atomic operations, so that the fault handler
+  // and the other functions can make pages writable at the same time.
+  std::atomic<bool> m_write_tracking_enabled = false;
+  std::mutex m_write_tracking_lock;
+  u32 m_tracked_page_size = 0;
+  u32 m_tracked_page_count = 0;
+  std::unique_ptr<std::atomic<u8>[]> m_tracked_page_states;
+  std::unique_ptr<std::atomic<u8>[]> m_tracked_page_write_counts;
+  std::unique_ptr<std::atomic<u64>[]> m_tracked_page_generations;
+  std::atomic<u64> m_write_generation = 0;
+  // Keeps the fault handler and UpdateLogicalMemory from using the logical views at the same time.
+  std::atomic<bool> m_logical_views_changing = false;
+  std::atomic<u32> m_write_tracking_faults_in_progress = 0;
+
   void InitMMIO(bool is_wii);
+
+  bool GetTrackedPages(u32 address, u32 size, u32* first_page, u32* end_page) const;
+  void SetTrackedPagesProtection(u32 first_page, u32 end_page, bool write_protect);
+  void MarkTrackedPagesWritten(u32 first_page, u32 end_page);
+  void ResetWriteTrackingLocked();
 };
 }  // namespace Memory
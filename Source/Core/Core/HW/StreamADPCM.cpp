@@ -9,38 +9,50 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Swap.h"
 
 namespace StreamADPCM
 {
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+// The filter and the scale are set once per block and channel, so they are looked up before the
+// loop. Both channels are decoded in the same loop, which lets their filters run side by side.
+template <bool big_endian>
+static void DecodeBlockImpl(s16* pcm, const u8* adpcm, s32& histl1, s32& histl2, s32& histr1,
+                            s32& histr2)
 {
-  s32 hist = 0;
-  switch (q >> 4)
-  {
-  case 0:
-    hist = 0;
-    break;
-  case 1:
-    hist = (hist1 * 0x3c);
-    break;
-  case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
-  case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
-  }
-  hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
+  // Only filters 0-3 exist. The others use no history, like filter 0.
+  static constexpr s32 coef1[16] = {0, 0x3c, 0x73, 0x62};
+  static constexpr s32 coef2[16] = {0, 0, -0x34, -0x37};
 
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+  const s32 lcoef1 = coef1[adpcm[0] >> 4];
+  const s32 lcoef2 = coef2[adpcm[0] >> 4];
+  const int lscale = adpcm[0] & 0xf;
+  const s32 rcoef1 = coef1[adpcm[1] >> 4];
+  const s32 rcoef2 = coef2[adpcm[1] >> 4];
+  const int rscale = adpcm[1] & 0xf;
+  const u8* const data = adpcm + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK);
 
-  hist2 = hist1;
-  hist1 = cur;
+  s32 l1 = histl1, l2 = histl2, r1 = histr1, r2 = histr2;
+  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+  {
+    const s32 lhist = std::clamp((l1 * lcoef1 + l2 * lcoef2 + 0x20) >> 6, -0x200000, 0x1fffff);
+    const s32 rhist = std::clamp((r1 * rcoef1 + r2 * rcoef2 + 0x20) >> 6, -0x200000, 0x1fffff);
+    const s32 lcur = ((static_cast<s16>(data[i] << 12) >> lscale) << 6) + lhist;
+    const s32 rcur = ((static_cast<s16>((data[i] >> 4) << 12) >> rscale) << 6) + rhist;
+    l2 = l1;
+    l1 = lcur;
+    r2 = r1;
+    r1 = rcur;
 
-  cur >>= 6;
-  cur = std::clamp(cur, -0x8000, 0x7fff);
+    const s16 left = static_cast<s16>(std::clamp(lcur >> 6, -0x8000, 0x7fff));
+    const s16 right = static_cast<s16>(std::clamp(rcur >> 6, -0x8000, 0x7fff));
+    pcm[i * 2] = big_endian ? Common::swap16(left) : left;
+    pcm[i * 2 + 1] = big_endian ? Common::swap16(right) : right;
+  }
 
-  return (s16)cur;
+  histl1 = l1;
+  histl2 = l2;
+  histr1 = r1;
+  histr2 = r2;
 }
 
 void ADPCMDecoder::ResetFilter()
@@ -61,12 +73,15 @@ void ADPCMDecoder::DoState(PointerWrap& p)
 
 void ADPCMDecoder::DecodeBlock(s16* pcm, const u8* adpcm)
 {
-  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+  DecodeBlockImpl<false>(pcm, adpcm, m_histl1, m_histl2, m_histr1, m_histr2);
+}
+
+void ADPCMDecoder::DecodeBlocksBE(s16* pcm, const u8* adpcm, size_t num_blocks)
+{
+  for (size_t i = 0; i < num_blocks; i++)
   {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-                                 m_histl1, m_histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-                                     m_histr1, m_histr2);
+    DecodeBlockImpl<true>(pcm + i * SAMPLES_PER_BLOCK * 2, adpcm + i * ONE_BLOCK_SIZE, m_histl1,
+                          m_histl2, m_histr1, m_histr2);
   }
 }
 }  // namespace StreamADPCM
@@ -47,7 +47,9 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
+#include <optional>
 
+#include "AudioCommon/AudioCommon.h"
 #include "AudioCommon/Mixer.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -80,6 +82,7 @@ CoreTiming::EventType* et_IPC_HLE;
 // PatchEngine updates every 1/60th of a second by default
 CoreTiming::EventType* et_PatchEngine;
 CoreTiming::EventType* et_Throttle;
+CoreTiming::EventType* et_AudioRender;
 
 u32 s_cpu_core_clock = 486000000u;  // 486 mhz (its not 485, stop bugging me!)
 
@@ -105,9 +108,11 @@ void DSPCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
   // splits up the cycle budget in case lle is used
   // for hle, just gives all of the slice to hle
-  DSP::UpdateDSPSlice(static_cast<int>(DSP::GetDSPEmulator()->DSP_UpdateRate() - cyclesLate));
-  system.GetCoreTiming().ScheduleEvent(DSP::GetDSPEmulator()->DSP_UpdateRate() - cyclesLate,
-                                       et_DSP);
+  // The update rate can change while the DSP runs, so the budget and the time until the next
+  // update are both taken from the rate before it runs.
+  const s64 slice = DSP::GetDSPEmulator()->DSP_UpdateRate() - cyclesLate;
+  DSP::UpdateDSPSlice(static_cast<int>(slice));
+  system.GetCoreTiming().ScheduleEvent(slice, et_DSP);
 }
 
 int GetAudioDMACallbackPeriod()
@@ -123,6 +128,14 @@ void AudioDMACallback(Core::System& system, u64 userdata, s64 cyclesLate)
   system.GetCoreTiming().ScheduleEvent(GetAudioDMACallbackPeriod() - cyclesLate, et_AudioDMA);
 }
 
+// Pulls the mixer in lockstep with emulated time when rendering audio offline.
+void AudioRenderCallback(Core::System& system, u64 userdata, s64 cyclesLate)
+{
+  auto& core_timing = system.GetCoreTiming();
+  AudioCommon::RenderOffline(system, core_timing.GetTicks() - cyclesLate, GetTicksPerSecond());
+  core_timing.ScheduleEvent(GetTicksPerSecond() / 1000 - cyclesLate, et_AudioRender);
+}
+
 void IPC_HLE_UpdateCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
   if (SConfig::GetInstance().bWii)
@@ -182,7 +195,9 @@ void ThrottleCallback(Core::System& system, u64 deadline, s64 cyclesLate)
 
   const s64 diff = deadline - time;
   const float emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
-  const bool frame_limiter = emulation_speed > 0.0f && !Core::GetIsThrottlerTempDisabled();
+  // When rendering audio offline, nothing needs to happen in real time.
+  const bool frame_limiter = emulation_speed > 0.0f && !Core::GetIsThrottlerTempDisabled() &&
+                             !AudioCommon::IsRenderingOffline(system);
   u32 next_event = GetTicksPerSecond() / 1000;
 
   {
@@ -237,6 +252,41 @@ void DecrementerSet()
   }
 }
 
+void DSPUpdateRateLowered()
+{
+  auto& system = Core::System::GetInstance();
+  auto& core_timing = system.GetCoreTiming();
+
+  // The DSP was handed the budget for the whole slice up to the pending update when the slice
+  // started. Take back the part of it that the earlier update cuts off, so that the DSP doesn't
+  // get ahead of the CPU.
+  const s64 slice = DSP::GetDSPEmulator()->DSP_UpdateRate();
+  const std::optional<s64> ticks_left = core_timing.GetTicksUntilEvent(et_DSP);
+  if (ticks_left)
+    DSP::ShortenDSPSlice(static_cast<int>(*ticks_left - slice));
+  core_timing.RemoveEvent(et_DSP);
+  core_timing.ScheduleEvent(slice, et_DSP);
+}
+
+void AfterStateLoad()
+{
+  auto& system = Core::System::GetInstance();
+  auto& core_timing = system.GetCoreTiming();
+
+  // Keep rendering audio offline if the savestate was made without it, and stop if it was made
+  // with it but the render isn't running now.
+  const bool is_render_scheduled = core_timing.GetTicksUntilEvent(et_AudioRender).has_value();
+  if (AudioCommon::IsRenderingOffline(system))
+  {
+    if (!is_render_scheduled)
+      core_timing.ScheduleEvent(0, et_AudioRender);
+  }
+  else if (is_render_scheduled)
+  {
+    core_timing.RemoveEvent(et_AudioRender);
+  }
+}
+
 u32 GetFakeDecrementer()
 {
   auto& system = Core::System::GetInstance();
@@ -347,11 +397,14 @@ void Init()
   et_IPC_HLE = core_timing.RegisterEvent("IPC_HLE_UpdateCallback", IPC_HLE_UpdateCallback);
   et_PatchEngine = core_timing.RegisterEvent("PatchEngine", PatchEngineCallback);
   et_Throttle = core_timing.RegisterEvent("Throttle", ThrottleCallback);
+  et_AudioRender = core_timing.RegisterEvent("AudioRender", AudioRenderCallback);
 
   core_timing.ScheduleEvent(VideoInterface::GetTicksPerHalfLine(), et_VI);
   core_timing.ScheduleEvent(0, et_DSP);
   core_timing.ScheduleEvent(GetAudioDMACallbackPeriod(), et_AudioDMA);
   core_timing.ScheduleEvent(0, et_Throttle, 0);
+  if (AudioCommon::IsRenderingOffline(system))
+    core_timing.ScheduleEvent(0, et_AudioRender);
 
   core_timing.ScheduleEvent(VideoInterface::GetTicksPerField(), et_PatchEngine);
 
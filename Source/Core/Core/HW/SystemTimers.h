@@ -59,6 +59,15 @@ u32 GetFakeDecrementer();
 
 void TimeBaseSet();
 u64 GetFakeTimeBase();
+
+// Notify timing system that the DSP emulator lowered its update rate, so that the next DSP update
+// happens at the new rate.
+void DSPUpdateRateLowered();
+
+// Called after a savestate has been loaded. The scheduled events come from the savestate, which
+// may have been made with different settings.
+void AfterStateLoad();
+
 // Custom RTC
 s64 GetLocalTimeRTCOffset();
 
@@ -315,6 +315,8 @@ std::optional<IPCReply> FSDevice::Read(const ReadWriteRequest& request)
   return MakeIPCReply([&](Ticks t) {
     auto& system = Core::System::GetInstance();
     auto& memory = system.GetMemory();
+    // The host file is read straight into emulated RAM, which fails on write-tracked pages.
+    memory.MarkRangeWritten(request.buffer, request.size);
     return Read(request.fd, memory.GetPointer(request.buffer), request.size, request.buffer, t);
   });
 }
@@ -516,6 +516,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
           case IOCTLV_NET_SSL_READ:
           {
             WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+            memory.MarkRangeWritten(BufferIn2, BufferInSize2);
             const int ret =
                 mbedtls_ssl_read(&ssl->ctx, memory.GetPointer(BufferIn2), BufferInSize2);
 
@@ -650,6 +651,8 @@ void WiiSocket::Update(bool read, bool write, bool except)
           socklen_t addrlen = sizeof(sockaddr_in);
           auto* from = BufferOutSize2 ? reinterpret_cast<sockaddr*>(&local_name) : nullptr;
           socklen_t* fromlen = BufferOutSize2 ? &addrlen : nullptr;
+          // The kernel writes into the buffer, which fails on write-tracked pages.
+          memory.MarkRangeWritten(BufferOut, BufferOutSize);
           const int ret = recvfrom(fd, data, data_len, flags, from, fromlen);
           ReturnValue =
               WiiSockMan::GetNetErrorCode(ret, BufferOutSize2 ? "SO_RECVFROM" : "SO_RECV", true);
@@ -296,6 +296,7 @@ std::optional<IPCReply> WFSSRVDevice::IOCtl(const IOCtlRequest& request)
       fd_obj->file.Seek(position, File::SeekOrigin::Begin);
     }
     size_t read_bytes;
+    memory.MarkRangeWritten(addr, size);
     fd_obj->file.ReadArray(memory.GetPointer(addr), size, &read_bytes);
     // TODO(wfs): Handle read errors.
     if (absolute)
@@ -14,8 +14,10 @@
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 
+#include "Core/HW/Memmap.h"
 #include "Core/MachineContext.h"
 #include "Core/PowerPC/JitInterface.h"
+#include "Core/System.h"
 
 #if defined(__FreeBSD__) || defined(__NetBSD__)
 #include <signal.h>
@@ -60,6 +62,9 @@ static LONG NTAPI Handler(PEXCEPTION_POINTERS pPtrs)
     uintptr_t fault_address = (uintptr_t)pPtrs->ExceptionRecord->ExceptionInformation[1];
     SContext* ctx = pPtrs->ContextRecord;
 
+    if (Core::System::GetInstance().GetMemory().HandleWriteTrackingFault(fault_address))
+      return EXCEPTION_CONTINUE_EXECUTION;
+
     if (JitInterface::HandleFault(fault_address, ctx))
     {
       return EXCEPTION_CONTINUE_EXECUTION;
@@ -274,6 +279,10 @@ static void sigsegv_handler(int sig, siginfo_t* info, void* raw_context)
   }
   uintptr_t bad_address = (uintptr_t)info->si_addr;
 
+  // Writes to write-tracked RAM just need the page to be made writable again.
+  if (Core::System::GetInstance().GetMemory().HandleWriteTrackingFault(bad_address))
+    return;
+
 // Get all the information we can out of the context.
 #ifdef __OpenBSD__
   ucontext_t* ctx = context;
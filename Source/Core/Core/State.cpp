@@ -34,6 +34,7 @@
 #include "Core/GeckoCode.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
@@ -95,7 +96,7 @@ static size_t s_state_writes_in_queue;
 static std::condition_variable s_state_write_queue_is_empty;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 156;  // Last changed in PR 11184
+constexpr u32 STATE_VERSION = 157;  // Last changed for the adaptive DSP LLE update rate
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -236,6 +237,9 @@ static void DoState(PointerWrap& p)
   p.DoMarker("Wiimote");
   Gecko::DoState(p);
   p.DoMarker("Gecko");
+
+  if (p.IsReadMode())
+    SystemTimers::AfterStateLoad();
 }
 
 void LoadFromBuffer(std::vector<u8>& buffer)
@@ -4,12 +4,16 @@
 #include "DiscIO/Blob.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
+#include "Common/Align.h"
 #include "Common/CDUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -77,6 +81,57 @@ void SectorReader::SetChunkSize(int block_cnt)
   SetSectorSize(m_block_size);
 }
 
+bool BlobReader::ReadBulk(u64 offset, u64 size, u8* out_ptr)
+{
+  // Each thread reads whole pieces, which are aligned to the blocks of the format so that no block
+  // has to be decompressed by more than one thread. Wii partition data is also hashed and encrypted
+  // in 2 MiB groups, which aren't always aligned, so the pieces are large enough that a group which
+  // is split between two pieces doesn't happen often.
+  constexpr u64 MIN_PIECE_SIZE = 0x800000;
+  const u64 block_size = GetBlockSize();
+  const u64 piece_size =
+      block_size == 0 ? MIN_PIECE_SIZE : Common::AlignUp(MIN_PIECE_SIZE, block_size);
+
+  const u64 first_piece = offset / piece_size;
+  const u64 end_piece = (offset + size + piece_size - 1) / piece_size;
+  const u64 number_of_pieces = end_piece - first_piece;
+  const size_t number_of_threads = static_cast<size_t>(
+      std::min<u64>(std::max(1u, std::thread::hardware_concurrency()), number_of_pieces));
+  if (number_of_threads < 2)
+    return Read(offset, size, out_ptr);
+
+  while (m_bulk_readers.size() < number_of_threads - 1)
+  {
+    std::unique_ptr<BlobReader> reader = CopyReader();
+    if (!reader)
+      break;
+    m_bulk_readers.push_back(std::move(reader));
+  }
+  if (m_bulk_readers.empty())
+    return Read(offset, size, out_ptr);
+
+  std::atomic<u64> next_piece = first_piece;
+  std::atomic<bool> success = true;
+  const auto read_pieces = [&](BlobReader* reader) {
+    for (u64 piece = next_piece++; piece < end_piece && success; piece = next_piece++)
+    {
+      const u64 piece_offset = std::max(offset, piece * piece_size);
+      const u64 piece_end = std::min(offset + size, (piece + 1) * piece_size);
+      if (!reader->Read(piece_offset, piece_end - piece_offset, out_ptr + (piece_offset - offset)))
+        success = false;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < std::min(number_of_threads - 1, m_bulk_readers.size()); ++i)
+    threads.emplace_back(read_pieces, m_bulk_readers[i].get());
+  read_pieces(this);
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return success;
+}
+
 SectorReader::~SectorReader()
 {
 }
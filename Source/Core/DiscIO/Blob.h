@@ -85,6 +85,11 @@ public:
     return Common::FromBigEndian(temp);
   }
 
+  // Like Read, but meant for large reads, such as reading a whole image. Formats where blocks have
+  // to be decompressed split the read up and decompress the blocks on several threads.
+  // NOT thread-safe either.
+  bool ReadBulk(u64 offset, u64 size, u8* out_ptr);
+
   virtual bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const
   {
     return false;
@@ -97,6 +102,13 @@ public:
 
 protected:
   BlobReader() {}
+
+  // Returns a reader for the same file with its own file handle, which ReadBulk can use from
+  // another thread, or nullptr if the format doesn't gain anything from reading in parallel.
+  virtual std::unique_ptr<BlobReader> CopyReader() const { return nullptr; }
+
+private:
+  std::vector<std::unique_ptr<BlobReader>> m_bulk_readers;
 };
 
 // Provides caching and byte-operation-to-block-operations facilities.
@@ -66,6 +66,8 @@ public:
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  std::unique_ptr<BlobReader> CopyReader() const override;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -57,7 +57,8 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
     return false;
   }
 
-  constexpr size_t DESIRED_BUFFER_SIZE = 0x80000;
+  // Large enough for ReadBulk to decompress compressed formats on several threads.
+  constexpr size_t DESIRED_BUFFER_SIZE = 0x4000000;
   u64 buffer_size = infile->GetBlockSize();
   if (buffer_size == 0)
   {
@@ -88,7 +89,7 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
     }
     const u64 inpos = i * buffer_size;
     const u64 sz = std::min(buffer_size, infile->GetDataSize() - inpos);
-    if (!infile->Read(inpos, sz, buffer.data()))
+    if (!infile->ReadBulk(inpos, sz, buffer.data()))
     {
       PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
       success = false;
@@ -48,6 +48,11 @@ public:
   Volume() {}
   virtual ~Volume() {}
   virtual bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const = 0;
+  // Like Read, but meant for large reads, such as reading a whole image. See BlobReader::ReadBulk.
+  virtual bool ReadBulk(u64 offset, u64 length, u8* buffer, const Partition& partition) const
+  {
+    return Read(offset, length, buffer, partition);
+  }
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset, const Partition& partition) const
   {
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <limits>
 #include <map>
@@ -27,6 +28,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
@@ -40,6 +42,18 @@
 
 namespace DiscIO
 {
+// How many chunks after the current one the read-ahead thread decompresses during sequential reads.
+constexpr size_t READ_AHEAD_CHUNKS = 2;
+
+static std::atomic<size_t> s_max_cached_chunks = 8;
+static std::atomic<bool> s_read_ahead = true;
+
+void SetWIARVZChunkCacheOptions(size_t cached_chunks, bool read_ahead)
+{
+  s_max_cached_chunks = cached_chunks;
+  s_read_ahead = read_ahead;
+}
+
 static void PushBack(std::vector<u8>* vector, const u8* begin, const u8* end)
 {
   const size_t offset_in_vector = vector->size();
@@ -79,13 +93,23 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_encryption_cache(this)
+    : m_file(std::move(file)), m_path(path), m_max_cached_chunks(s_max_cached_chunks),
+      m_read_ahead_enabled(s_read_ahead), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  StopReadAhead();
+
+  if (m_cache_misses != 0)
+  {
+    INFO_LOG_FMT(DISCIO, "Chunk cache for {}: {} hits, {} read ahead, {} misses", m_path,
+                 m_cache_hits, m_read_ahead_hits, m_cache_misses);
+  }
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -280,6 +304,18 @@ std::unique_ptr<WIARVZFileReader<RVZ>> WIARVZFileReader<RVZ>::Create(File::IOFil
   return blob->m_valid ? std::move(blob) : nullptr;
 }
 
+template <bool RVZ>
+std::unique_ptr<BlobReader> WIARVZFileReader<RVZ>::CopyReader() const
+{
+  std::unique_ptr<WIARVZFileReader> reader = Create(File::IOFile(m_path, "rb"), m_path);
+
+  // Copies are used by BlobReader::ReadBulk, which gives each of them pieces that are far apart.
+  if (reader)
+    reader->m_read_ahead_enabled = false;
+
+  return reader;
+}
+
 template <bool RVZ>
 BlobType WIARVZFileReader<RVZ>::GetBlobType() const
 {
@@ -501,45 +537,50 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
+    const u64 full_chunk_size = chunk_size;
 
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
-
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
-
-      group_data_size &= 0x7FFFFFFF;
-
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
+    const ChunkParameters parameters = GetGroupChunkParameters(
+        total_group_index, group_offset_in_data, chunk_size, exception_lists);
 
-    if (group_data_size == 0)
+    if (parameters.compressed_size == 0)
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+      Chunk& chunk = ReadCompressedData(parameters);
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        InvalidateCachedChunk(parameters.offset_in_file);
         return false;
       }
 
+      // Once the reads have moved on to the next group, keep decompressing ahead of them.
+      if (m_read_ahead_enabled && total_group_index == m_last_group_index + 1)
+      {
+        std::vector<ChunkParameters> read_ahead;
+        for (u64 j = i + 1; j < number_of_groups && j <= i + READ_AHEAD_CHUNKS; ++j)
+        {
+          const u64 next_offset_in_data = j * full_chunk_size;
+          if (group_index + j >= m_group_entries.size() || next_offset_in_data >= data_size)
+            break;
+
+          const ChunkParameters next = GetGroupChunkParameters(
+              group_index + j, next_offset_in_data,
+              std::min(full_chunk_size, data_size - next_offset_in_data), exception_lists);
+          if (next.compressed_size != 0)
+            read_ahead.push_back(next);
+        }
+        QueueReadAhead(std::move(read_ahead));
+      }
+      m_last_group_index = total_group_index;
+
       if (m_write_to_exception_list && m_exception_list_last_group_index != total_group_index)
       {
         const u64 exception_list_index = offset_in_group / VolumeWii::GROUP_DATA_SIZE;
@@ -559,6 +600,31 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::ChunkParameters
+WIARVZFileReader<RVZ>::GetGroupChunkParameters(u64 total_group_index, u64 group_offset_in_data,
+                                               u64 chunk_size, u32 exception_lists) const
+{
+  const GroupEntry& group = m_group_entries[total_group_index];
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+  return {group_offset_in_file, group_data_size, chunk_size,         compression_type,
+          exception_lists,      rvz_packed_size, group_offset_in_data};
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -566,11 +632,55 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  return ReadCompressedData({offset_in_file, compressed_size, decompressed_size, compression_type,
+                             exception_lists, rvz_packed_size, data_offset});
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk&
+WIARVZFileReader<RVZ>::ReadCompressedData(const ChunkParameters& parameters)
+{
+  const u64 offset_in_file = parameters.offset_in_file;
+  const auto it = std::find_if(m_cached_chunks.begin(), m_cached_chunks.end(),
+                               [offset_in_file](const auto& entry) {
+                                 return entry.first == offset_in_file;
+                               });
+  if (it != m_cached_chunks.end())
+  {
+    ++m_cache_hits;
+    m_cached_chunks.splice(m_cached_chunks.begin(), m_cached_chunks, it);
+    return it->second;
+  }
+
+  std::optional<Chunk> chunk = TakeReadAheadChunk(offset_in_file);
+  if (chunk)
+    ++m_read_ahead_hits;
+  else
+    ++m_cache_misses;
+
+  if (m_cached_chunks.size() >= m_max_cached_chunks)
+    m_cached_chunks.pop_back();
+  m_cached_chunks.emplace_front(offset_in_file,
+                                chunk ? std::move(*chunk) : CreateChunk(&m_file, parameters));
+  return m_cached_chunks.front().second;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InvalidateCachedChunk(u64 offset_in_file)
+{
+  m_cached_chunks.remove_if(
+      [offset_in_file](const auto& entry) { return entry.first == offset_in_file; });
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const
+{
+  const u64 decompressed_size = parameters.decompressed_size;
+  const u32 rvz_packed_size = parameters.rvz_packed_size;
 
   std::unique_ptr<Decompressor> decompressor;
-  switch (compression_type)
+  switch (parameters.compression_type)
   {
   case WIARVZCompressionType::None:
     decompressor = std::make_unique<NoneDecompressor>();
@@ -595,13 +705,131 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
     break;
   }
 
-  const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
+  const bool compressed_exception_lists =
+      parameters.compression_type > WIARVZCompressionType::Purge;
+
+  return Chunk(file, parameters.offset_in_file, parameters.compressed_size, decompressed_size,
+               parameters.exception_lists, compressed_exception_lists, rvz_packed_size,
+               parameters.data_offset, std::move(decompressor));
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::QueueReadAhead(std::vector<ChunkParameters> chunks)
+{
+  // Chunks that are already decompressed don't need to be read ahead.
+  std::erase_if(chunks, [this](const ChunkParameters& parameters) {
+    return std::any_of(m_cached_chunks.begin(), m_cached_chunks.end(),
+                       [&parameters](const auto& entry) {
+                         return entry.first == parameters.offset_in_file;
+                       });
+  });
+
+  std::lock_guard lk(m_read_ahead_mutex);
+
+  std::erase_if(chunks, [this](const ChunkParameters& parameters) {
+    return m_read_ahead_in_progress == parameters.offset_in_file ||
+           std::any_of(m_read_ahead_chunks.begin(), m_read_ahead_chunks.end(),
+                       [&parameters](const auto& entry) {
+                         return entry.first == parameters.offset_in_file;
+                       });
+  });
+  if (chunks.empty())
+    return;
+
+  if (!m_read_ahead_thread.joinable())
+  {
+    if (!m_read_ahead_file.Open(m_path, "rb"))
+    {
+      m_read_ahead_enabled = false;
+      return;
+    }
+    m_read_ahead_thread = std::thread(&WIARVZFileReader::ReadAheadThread, this);
+  }
+
+  m_read_ahead_queue.assign(chunks.begin(), chunks.end());
+  m_read_ahead_queued.notify_one();
+}
+
+template <bool RVZ>
+std::optional<typename WIARVZFileReader<RVZ>::Chunk>
+WIARVZFileReader<RVZ>::TakeReadAheadChunk(u64 offset_in_file)
+{
+  if (!m_read_ahead_thread.joinable())
+    return std::nullopt;
+
+  std::unique_lock lk(m_read_ahead_mutex);
+  while (true)
+  {
+    const auto it = std::find_if(m_read_ahead_chunks.begin(), m_read_ahead_chunks.end(),
+                                 [offset_in_file](const auto& entry) {
+                                   return entry.first == offset_in_file;
+                                 });
+    if (it != m_read_ahead_chunks.end())
+    {
+      Chunk chunk = std::move(it->second);
+      m_read_ahead_chunks.erase(it);
+      return chunk;
+    }
+
+    if (m_read_ahead_in_progress != offset_in_file)
+      break;
+
+    m_read_ahead_done.wait(lk);
+  }
+
+  // The chunk is needed now, so don't decompress it twice.
+  std::erase_if(m_read_ahead_queue, [offset_in_file](const ChunkParameters& parameters) {
+    return parameters.offset_in_file == offset_in_file;
+  });
+  return std::nullopt;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ReadAheadThread()
+{
+  Common::SetCurrentThreadName("WIA/RVZ read-ahead");
+
+  std::unique_lock lk(m_read_ahead_mutex);
+  while (true)
+  {
+    m_read_ahead_queued.wait(
+        lk, [this] { return m_read_ahead_stop || !m_read_ahead_queue.empty(); });
+    if (m_read_ahead_stop)
+      return;
+
+    const ChunkParameters parameters = m_read_ahead_queue.front();
+    m_read_ahead_queue.pop_front();
+    m_read_ahead_in_progress = parameters.offset_in_file;
+    lk.unlock();
+
+    Chunk chunk = CreateChunk(&m_read_ahead_file, parameters);
+    const bool success = chunk.DecompressAll();
+
+    lk.lock();
+    m_read_ahead_in_progress.reset();
+    if (success)
+    {
+      // Chunks that weren't used before the reads moved elsewhere are dropped.
+      if (m_read_ahead_chunks.size() >= READ_AHEAD_CHUNKS)
+        m_read_ahead_chunks.pop_front();
+      m_read_ahead_chunks.emplace_back(parameters.offset_in_file, std::move(chunk));
+    }
+    m_read_ahead_done.notify_all();
+  }
+}
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::StopReadAhead()
+{
+  if (!m_read_ahead_thread.joinable())
+    return;
+
+  {
+    std::lock_guard lk(m_read_ahead_mutex);
+    m_read_ahead_stop = true;
+  }
+  m_read_ahead_queued.notify_one();
+  m_read_ahead_thread.join();
 }
 
 template <bool RVZ>
@@ -651,10 +879,29 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     return false;
   }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  if (!DecompressUpTo(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  if (!m_decompressor || !m_file)
+    return false;
+
+  return DecompressUpTo(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUpTo(u64 end)
+{
+  while (end > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -667,7 +914,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -747,7 +994,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -4,10 +4,16 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -40,6 +46,10 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 constexpr u32 WIA_MAGIC = 0x01414957;  // "WIA\x1" (byteswapped to little endian)
 constexpr u32 RVZ_MAGIC = 0x015A5652;  // "RVZ\x1" (byteswapped to little endian)
 
+// Sets how many decompressed chunks each WIA/RVZ reader keeps, and whether readers decompress the
+// chunks that follow a sequential read on another thread. Applies to readers created afterwards.
+void SetWIARVZChunkCacheOptions(size_t cached_chunks, bool read_ahead);
+
 template <bool RVZ>
 class WIARVZFileReader : public BlobReader
 {
@@ -192,6 +202,8 @@ private:
           u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
+    // Decompresses all of the chunk, after which reading from it no longer uses the file.
+    bool DecompressAll();
 
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
@@ -204,6 +216,7 @@ private:
     }
 
   private:
+    bool DecompressUpTo(u64 end);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -227,8 +240,21 @@ private:
     u64 m_data_offset = 0;
   };
 
+  // Where to find a chunk in the file, and how to decompress it.
+  struct ChunkParameters
+  {
+    u64 offset_in_file;
+    u64 compressed_size;
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 exception_lists;
+    u32 rvz_packed_size;
+    u64 data_offset;
+  };
+
   explicit WIARVZFileReader(File::IOFile file, const std::string& path);
   bool Initialize(const std::string& path);
+  std::unique_ptr<BlobReader> CopyReader() const override;
   bool HasDataOverlap() const;
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
@@ -236,9 +262,22 @@ private:
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
+  // compressed_size is 0 for groups that only contain zeroes.
+  ChunkParameters GetGroupChunkParameters(u64 total_group_index, u64 group_offset_in_data,
+                                          u64 chunk_size, u32 exception_lists) const;
+  Chunk CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const;
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk& ReadCompressedData(const ChunkParameters& parameters);
+  void InvalidateCachedChunk(u64 offset_in_file);
+
+  // Decompresses the given chunks on the read-ahead thread, replacing any that are still queued.
+  void QueueReadAhead(std::vector<ChunkParameters> chunks);
+  // Returns the chunk if the read-ahead thread has decompressed it, waiting if it's in progress.
+  std::optional<Chunk> TakeReadAheadChunk(u64 offset_in_file);
+  void ReadAheadThread();
+  void StopReadAhead();
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -365,8 +404,28 @@ private:
   WIARVZCompressionType m_compression_type;
 
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  std::string m_path;
+
+  // Decompressed chunks by offset in the file, most recently used first.
+  std::list<std::pair<u64, Chunk>> m_cached_chunks;
+  size_t m_max_cached_chunks;
+  u64 m_last_group_index = std::numeric_limits<u64>::max();
+  u64 m_cache_hits = 0;
+  u64 m_read_ahead_hits = 0;
+  u64 m_cache_misses = 0;
+
+  bool m_read_ahead_enabled;
+  std::thread m_read_ahead_thread;
+  // Only used by the read-ahead thread, so that it doesn't move the position of m_file.
+  File::IOFile m_read_ahead_file;
+  std::mutex m_read_ahead_mutex;
+  std::condition_variable m_read_ahead_queued;
+  std::condition_variable m_read_ahead_done;
+  std::deque<ChunkParameters> m_read_ahead_queue;
+  std::optional<u64> m_read_ahead_in_progress;
+  std::list<std::pair<u64, Chunk>> m_read_ahead_chunks;
+  bool m_read_ahead_stop = false;
+
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -17,10 +17,12 @@
 #include <Windows.h>
 #endif
 
+#include "Common/Config/Config.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
@@ -201,6 +203,14 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--frame_hashes")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write a hash of every presented frame to the specified file");
+  parser->add_option("--hash_efb_copies")
+      .action("store_true")
+      .help("Also hash every EFB copy to RAM (Requires --frame_hashes)");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -264,6 +274,15 @@ int main(int argc, char* argv[])
   UICommon::Init();
   UICommon::InitControllers(wsi);
 
+  if (options.is_set("frame_hashes"))
+  {
+    Config::SetCurrent(Config::GFX_FRAME_HASH_PATH,
+                       static_cast<const char*>(options.get("frame_hashes")));
+    Config::SetCurrent(Config::GFX_DUMP_FRAME_HASHES, true);
+    Config::SetCurrent(Config::GFX_DUMP_EFB_COPY_HASHES,
+                       static_cast<bool>(options.get("hash_efb_copies")));
+  }
+
   Common::ScopeGuard ui_common_guard([] {
     UICommon::ShutdownControllers();
     UICommon::Shutdown();
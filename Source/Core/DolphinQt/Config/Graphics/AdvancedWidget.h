@@ -42,6 +42,7 @@ private:
   GraphicsBool* m_show_graphs;
   GraphicsBool* m_show_speed;
   GraphicsBool* m_show_speed_colors;
+  GraphicsBool* m_show_audio_latency;
   GraphicsInteger* m_perf_samp_window;
   GraphicsBool* m_log_render_time;
 
@@ -352,7 +352,7 @@ void FIFOAnalyzer::UpdateDetails()
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
   const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const auto& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
@@ -369,7 +369,7 @@ void FIFOAnalyzer::UpdateDetails()
     const u32 start_offset = object_offset;
     m_object_data_offsets.push_back(start_offset);
 
-    object_offset += OpcodeDecoder::RunCommand(&fifo_frame.fifoData[object_start + start_offset],
+    object_offset += OpcodeDecoder::RunCommand(&fifo_frame->fifoData[object_start + start_offset],
                                                object_size - start_offset, callback);
 
     QString new_label =
@@ -435,13 +435,13 @@ void FIFOAnalyzer::BeginSearch()
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
   const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
   const u32 object_size = object_end - object_start;
 
-  const u8* const object = &fifo_frame.fifoData[object_start];
+  const u8* const object = &fifo_frame->fifoData[object_start];
 
   // TODO: Support searching for bit patterns
   for (u32 cmd_nr = 0; cmd_nr < m_object_data_offsets.size(); cmd_nr++)
@@ -767,7 +767,7 @@ void FIFOAnalyzer::UpdateDescription()
   const u32 entry_nr = m_detail_list->currentRow();
 
   const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
 
   const u32 object_start = frame_info.parts[start_part_nr].m_start;
   const u32 object_end = frame_info.parts[end_part_nr].m_end;
@@ -775,7 +775,7 @@ void FIFOAnalyzer::UpdateDescription()
   const u32 entry_start = m_object_data_offsets[entry_nr];
 
   auto callback = DescriptionCallback(frame_info.parts[end_part_nr].m_cpmem);
-  OpcodeDecoder::RunCommand(&fifo_frame.fifoData[object_start + entry_start],
+  OpcodeDecoder::RunCommand(&fifo_frame->fifoData[object_start + entry_start],
                             object_size - entry_start, callback);
   m_entry_detail_browser->setText(callback.text);
 }
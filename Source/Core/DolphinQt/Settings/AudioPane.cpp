@@ -93,6 +93,11 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_low_latency = new QCheckBox(tr("Adaptive Low Latency"));
+  m_low_latency->setToolTip(
+      tr("Buffers only as much audio as the audio backend needs, which keeps audio in sync with "
+         "video. Buffering grows again whenever the audio crackles."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -124,6 +129,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
+  backend_layout->addRow(m_low_latency);
 
 #ifdef _WIN32
   m_wasapi_device_label = new QLabel(tr("Device:"));
@@ -182,6 +188,7 @@ void AudioPane::ConnectWidgets()
     connect(m_latency_spin, qOverload<int>(&QSpinBox::valueChanged), this,
             &AudioPane::SaveSettings);
   }
+  connect(m_low_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
@@ -244,6 +251,7 @@ void AudioPane::LoadSettings()
   // Latency
   if (m_latency_control_supported)
     m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
+  m_low_latency->setChecked(Config::Get(Config::MAIN_AUDIO_LOW_LATENCY));
 
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
@@ -310,6 +318,7 @@ void AudioPane::SaveSettings()
   // Latency
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LOW_LATENCY, m_low_latency->isChecked());
 
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
@@ -66,6 +66,7 @@ private:
   QLabel* m_dolby_quality_latency_label;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QCheckBox* m_low_latency;
 #ifdef _WIN32
   QLabel* m_wasapi_device_label;
   QComboBox* m_wasapi_device_combo;
@@ -0,0 +1,321 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/BenchmarkCommand.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <OptionParser.h>
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Flag.h"
+#include "Common/ScopeGuard.h"
+#include "Common/Timer.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoBackendBase.h"
+
+namespace DolphinTool
+{
+namespace
+{
+constexpr std::array<std::pair<GPUStage, const char*>, 4> STAGE_NAMES = {{
+    {GPUStage::OpcodeDecoding, "opcode_decoding"},
+    {GPUStage::VertexLoading, "vertex_loading"},
+    {GPUStage::TextureCache, "texture_cache"},
+    {GPUStage::BackendSubmission, "backend_submission"},
+}};
+
+double NsToUs(u64 ns)
+{
+  return static_cast<double>(ns) / 1000.0;
+}
+
+picojson::value SummarizeTimes(std::vector<u64> times_ns)
+{
+  picojson::object summary;
+  if (times_ns.empty())
+    return picojson::value(summary);
+
+  std::sort(times_ns.begin(), times_ns.end());
+  u64 total_ns = 0;
+  for (const u64 time_ns : times_ns)
+    total_ns += time_ns;
+
+  const size_t p95_index = std::min(times_ns.size() - 1, times_ns.size() * 95 / 100);
+  summary["mean_us"] = picojson::value(NsToUs(total_ns) / static_cast<double>(times_ns.size()));
+  summary["median_us"] = picojson::value(NsToUs(times_ns[times_ns.size() / 2]));
+  summary["p95_us"] = picojson::value(NsToUs(times_ns[p95_index]));
+  summary["min_us"] = picojson::value(NsToUs(times_ns.front()));
+  summary["max_us"] = picojson::value(NsToUs(times_ns.back()));
+  summary["total_us"] = picojson::value(NsToUs(total_ns));
+  return picojson::value(summary);
+}
+
+WindowSystemInfo GetHeadlessWindowSystemInfo()
+{
+  WindowSystemInfo wsi;
+  wsi.type = WindowSystemType::Headless;
+  wsi.display_connection = nullptr;
+  wsi.render_window = nullptr;
+  wsi.render_surface = nullptr;
+  return wsi;
+}
+}  // namespace
+
+int BenchmarkCommand::Main(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: benchmark [options]...");
+
+  parser.add_option("-u", "--user")
+      .action("store")
+      .help("User folder path. Will be automatically created if this option is not set.");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the FIFO log (.dff) FILE to replay.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to write the JSON report to. Default is standard output.")
+      .metavar("FILE");
+
+  parser.add_option("-b", "--backend")
+      .type("string")
+      .action("store")
+      .help("Video backend to replay with, e.g. \"Null\", \"Software Renderer\", \"Vulkan\" or "
+            "\"OGL\". Default is Null.")
+      .set_default("Null");
+
+  parser.add_option("-n", "--iterations")
+      .type("int")
+      .action("store")
+      .help("Number of times to replay every frame of the log. Default is 10.")
+      .set_default(10);
+
+  parser.add_option("-w", "--warmup")
+      .type("int")
+      .action("store")
+      .help("Number of times to replay the log before measuring, so that shaders and textures "
+            "are already cached. Default is 1.")
+      .set_default(1);
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  // Validate options
+
+  // --input
+  const std::string input_file_path = static_cast<const char*>(options.get("input"));
+  if (input_file_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  // --iterations and --warmup
+  const int iterations = static_cast<int>(options.get("iterations"));
+  const int warmup_iterations = static_cast<int>(options.get("warmup"));
+  if (iterations < 1 || warmup_iterations < 0)
+  {
+    std::cerr << "Error: Invalid number of iterations" << std::endl;
+    return 1;
+  }
+  m_iterations = static_cast<u32>(iterations);
+  m_warmup_iterations = static_cast<u32>(warmup_iterations);
+
+  const WindowSystemInfo wsi = GetHeadlessWindowSystemInfo();
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+  UICommon::InitControllers(wsi);
+
+  Common::ScopeGuard ui_common_guard([] {
+    UICommon::ShutdownControllers();
+    UICommon::Shutdown();
+  });
+
+  std::unique_ptr<BootParameters> boot = BootParameters::GenerateFromFile(input_file_path);
+  if (!boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+  {
+    std::cerr << "Error: The input file is not a FIFO log" << std::endl;
+    return 1;
+  }
+
+  // --backend
+  const std::string backend = static_cast<const char*>(options.get("backend"));
+  const auto& backends = VideoBackendBase::GetAvailableBackends();
+  if (std::none_of(backends.begin(), backends.end(),
+                   [&](const auto& b) { return b->GetName() == backend; }))
+  {
+    std::cerr << "Error: Unknown video backend \"" << backend << "\". Available backends:";
+    for (const auto& b : backends)
+      std::cerr << " \"" << b->GetName() << "\"";
+    std::cerr << std::endl;
+    return 1;
+  }
+
+  // Run the GPU on the CPU thread, so that each frame has been fully processed by the time the
+  // next one is written, and replay as fast as possible.
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, backend);
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  Config::SetCurrent(Config::GFX_VSYNC, false);
+
+  Common::Flag core_stopped;
+  const int state_changed_callback_id = Core::AddOnStateChangedCallback([&](Core::State state) {
+    if (state == Core::State::Uninitialized)
+    {
+      core_stopped.Set();
+      m_done.Set();
+    }
+  });
+
+  g_stats.measure_stage_times = true;
+  FifoPlayer::GetInstance().SetFrameWrittenCallback([this] { OnFrameWritten(); });
+
+  Common::ScopeGuard core_guard([&] {
+    FifoPlayer::GetInstance().SetFrameWrittenCallback({});
+    g_stats.measure_stage_times = false;
+    int callback_id = state_changed_callback_id;
+    Core::RemoveOnStateChangedCallback(&callback_id);
+  });
+
+  if (!BootManager::BootCore(std::move(boot), wsi))
+  {
+    std::cerr << "Error: Could not start replaying the FIFO log" << std::endl;
+    return 1;
+  }
+
+  while (!m_done.WaitFor(std::chrono::milliseconds(100)))
+    Core::HostDispatchJobs();
+
+  const bool completed = !core_stopped.IsSet();
+  Core::Stop();
+  Core::Shutdown();
+
+  if (!completed)
+  {
+    std::cerr << "Error: Emulation stopped before the replay finished" << std::endl;
+    return 1;
+  }
+
+  const std::string report = FormatReport(input_file_path, backend);
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (output_file_path.empty())
+  {
+    std::cout << report << std::endl;
+  }
+  else if (!File::WriteStringToFile(output_file_path, report))
+  {
+    std::cerr << "Error: Could not write the report to " << output_file_path << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+void BenchmarkCommand::OnFrameWritten()
+{
+  if (m_finished)
+    return;
+
+  const FifoPlayer& player = FifoPlayer::GetInstance();
+  const u64 now_ns = Common::Timer::NowNs();
+  const u32 frame = player.GetCurrentFrameNum();
+
+  if (m_previous_frame)
+  {
+    if (m_iteration >= m_warmup_iterations)
+    {
+      FrameSample sample{m_iteration - m_warmup_iterations, *m_previous_frame,
+                         now_ns - m_previous_frame_start_ns, {}};
+      for (const auto& [stage, name] : STAGE_NAMES)
+        sample.stage_ns[stage] = g_stats.stage_time_ns[stage] - m_previous_stage_ns[stage];
+      m_samples.push_back(sample);
+    }
+
+    // The player starts over from the first frame once every frame has been written.
+    if (frame == player.GetFrameRangeStart())
+      m_iteration++;
+  }
+
+  if (m_iteration == m_warmup_iterations + m_iterations)
+  {
+    m_finished = true;
+    m_done.Set();
+    return;
+  }
+
+  m_previous_frame = frame;
+  m_previous_frame_start_ns = now_ns;
+  m_previous_stage_ns = g_stats.stage_time_ns;
+}
+
+std::string BenchmarkCommand::FormatReport(const std::string& input_file_path,
+                                           const std::string& backend) const
+{
+  picojson::array frames;
+  std::vector<u64> total_times_ns;
+  std::vector<std::vector<u64>> stage_times_ns(STAGE_NAMES.size());
+  for (const FrameSample& sample : m_samples)
+  {
+    picojson::object frame;
+    frame["iteration"] = picojson::value(static_cast<double>(sample.iteration));
+    frame["frame"] = picojson::value(static_cast<double>(sample.frame));
+    frame["total_us"] = picojson::value(NsToUs(sample.total_ns));
+    total_times_ns.push_back(sample.total_ns);
+
+    for (size_t i = 0; i < STAGE_NAMES.size(); i++)
+    {
+      const auto& [stage, name] = STAGE_NAMES[i];
+      frame[std::string(name) + "_us"] = picojson::value(NsToUs(sample.stage_ns[stage]));
+      stage_times_ns[i].push_back(sample.stage_ns[stage]);
+    }
+
+    frames.emplace_back(std::move(frame));
+  }
+
+  picojson::object summary;
+  summary["total"] = SummarizeTimes(std::move(total_times_ns));
+  for (size_t i = 0; i < STAGE_NAMES.size(); i++)
+    summary[STAGE_NAMES[i].second] = SummarizeTimes(std::move(stage_times_ns[i]));
+
+  picojson::object report;
+  report["input"] = picojson::value(input_file_path);
+  report["backend"] = picojson::value(backend);
+  report["iterations"] = picojson::value(static_cast<double>(m_iterations));
+  report["warmup_iterations"] = picojson::value(static_cast<double>(m_warmup_iterations));
+  report["summary"] = picojson::value(std::move(summary));
+  report["frames"] = picojson::value(std::move(frames));
+  return picojson::value(std::move(report)).serialize(true);
+}
+
+}  // namespace DolphinTool
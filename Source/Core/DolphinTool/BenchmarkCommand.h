@@ -0,0 +1,52 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "DolphinTool/Command.h"
+#include "VideoCommon/Statistics.h"
+
+namespace DolphinTool
+{
+// Replays a FIFO log headlessly and reports how much CPU time each frame spends in each stage of
+// processing the GPU commands, as JSON.
+class BenchmarkCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+
+private:
+  struct FrameSample
+  {
+    u32 iteration;
+    u32 frame;
+    u64 total_ns;
+    Common::EnumMap<u64, GPUStage::BackendSubmission> stage_ns;
+  };
+
+  // Called by the FIFO player on the CPU thread before each frame is written.
+  void OnFrameWritten();
+
+  std::string FormatReport(const std::string& input_file_path, const std::string& backend) const;
+
+  u32 m_warmup_iterations = 0;
+  u32 m_iterations = 0;
+
+  // Only accessed on the CPU thread until m_done has been set.
+  u32 m_iteration = 0;
+  std::optional<u32> m_previous_frame;
+  u64 m_previous_frame_start_ns = 0;
+  Common::EnumMap<u64, GPUStage::BackendSubmission> m_previous_stage_ns{};
+  std::vector<FrameSample> m_samples;
+  bool m_finished = false;
+  Common::Event m_done;
+};
+
+}  // namespace DolphinTool
@@ -0,0 +1,69 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <iostream>
+#include <memory>
+
+#include <OptionParser.h>
+
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+
+namespace DolphinTool
+{
+int TexturePackCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: texpack [options]...");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the custom texture DIRECTORY of a game.")
+      .metavar("DIRECTORY");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack FILE to write. To be used, it must be placed in the "
+            "Load/Textures directory and named after the game ID, e.g. GALE01.texpack.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // Validate options
+  const std::string input_directory = static_cast<const char*>(options.get("input"));
+  if (input_directory.empty() || !File::IsDirectory(input_directory))
+  {
+    std::cerr << "Error: No input directory set" << std::endl;
+    return 1;
+  }
+
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (output_file_path.empty())
+  {
+    std::cerr << "Error: No output set" << std::endl;
+    return 1;
+  }
+
+  if (!HiresTexturePack::Create(input_directory, output_file_path))
+  {
+    std::cerr << "Error: Failed to write the texture pack" << std::endl;
+    return 1;
+  }
+
+  HiresTexturePack pack;
+  if (!pack.Open(output_file_path))
+  {
+    std::cerr << "Error: The written texture pack could not be read back" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Packed " << pack.GetEntries().size() << " textures" << std::endl;
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,20 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DolphinTool/Command.h"
+
+namespace DolphinTool
+{
+// Packs a directory of custom textures into a single texture pack file.
+class TexturePackCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+};
+
+}  // namespace DolphinTool
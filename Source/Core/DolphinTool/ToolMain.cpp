@@ -8,15 +8,17 @@
 #include <vector>
 
 #include "Common/Version.h"
+#include "DolphinTool/BenchmarkCommand.h"
 #include "DolphinTool/Command.h"
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/TexturePackCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static int PrintUsage(int code)
 {
   std::cerr << "usage: dolphin-tool COMMAND -h" << std::endl << std::endl;
-  std::cerr << "commands supported: [convert, verify, header]" << std::endl;
+  std::cerr << "commands supported: [convert, verify, header, benchmark, texpack]" << std::endl;
 
   return code;
 }
@@ -45,6 +47,10 @@ int main(int argc, char* argv[])
     command = std::make_unique<DolphinTool::VerifyCommand>();
   else if (command_str == "header")
     command = std::make_unique<DolphinTool::HeaderCommand>();
+  else if (command_str == "benchmark")
+    command = std::make_unique<DolphinTool::BenchmarkCommand>();
+  else if (command_str == "texpack")
+    command = std::make_unique<DolphinTool::TexturePackCommand>();
   else
     return PrintUsage(1);
 
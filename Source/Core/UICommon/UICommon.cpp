@@ -40,6 +40,8 @@
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
 
+#include "DiscIO/WIABlob.h"
+
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 #include "InputCommon/GCAdapter.h"
 
@@ -115,6 +117,9 @@ static void RefreshConfig()
 {
   Common::SetEnableAlert(Config::Get(Config::MAIN_USE_PANIC_HANDLERS));
   Common::SetAbortOnPanicAlert(Config::Get(Config::MAIN_ABORT_ON_PANIC_ALERT));
+  DiscIO::SetWIARVZChunkCacheOptions(
+      static_cast<size_t>(std::max(1, Config::Get(Config::MAIN_WIA_CHUNK_CACHE_SIZE))),
+      Config::Get(Config::MAIN_WIA_READ_AHEAD));
 }
 
 void Init()
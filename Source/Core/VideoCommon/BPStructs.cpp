@@ -38,6 +38,7 @@
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -89,6 +90,9 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager,
           bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
           bp.address == BPMEM_CLEAR_PIXEL_PERF))
     {
+      INCSTAT(g_stats.this_frame.num_redundant_bp_loads);
+      if (!g_vertex_manager->IsFlushed())
+        INCSTAT(g_stats.this_frame.num_flushes_avoided);
       return;
     }
   }
@@ -640,6 +640,9 @@ struct CPState final
 
   // Mutates the CP state based on the given command and value.
   void LoadCPReg(u8 sub_cmd, u32 value);
+  // Returns true if LoadCPReg would leave the vertex format and arrays unchanged. Matrix index
+  // writes are never considered redundant, since VertexShaderManager tracks those itself.
+  bool IsRedundantWrite(u8 sub_cmd, u32 value) const;
   // Fills memory with data from CP regs.  There should be space for 0x100 values in memory.
   void FillCPMemoryArray(u32* memory) const;
 
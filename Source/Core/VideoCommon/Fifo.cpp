@@ -59,6 +59,12 @@ void FifoManager::DoState(PointerWrap& p)
     // We're good and paused, right?
     m_video_buffer_seen_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
   }
+  if (p.IsReadMode())
+  {
+    // The CP state may have changed the size of a pending primitive, so decode it again.
+    m_pending_command_size = 0;
+    m_pp_pending_command_size = 0;
+  }
 
   p.Do(m_sync_ticks);
   p.Do(m_syncing_suspended);
@@ -264,8 +270,12 @@ void FifoManager::ReadDataFromFifoOnCPU(Core::System& system, u32 readPtr)
   }
   auto& memory = system.GetMemory();
   memory.CopyFromEmu(m_video_buffer_write_ptr, readPtr, GPFifo::GATHER_PIPE_SIZE);
-  m_video_buffer_pp_read_ptr = OpcodeDecoder::RunFifo<true>(
-      DataReader(m_video_buffer_pp_read_ptr, write_ptr + GPFifo::GATHER_PIPE_SIZE), nullptr);
+  u8* const end_ptr = write_ptr + GPFifo::GATHER_PIPE_SIZE;
+  if (static_cast<size_t>(end_ptr - m_video_buffer_pp_read_ptr) >= m_pp_pending_command_size)
+  {
+    m_video_buffer_pp_read_ptr = OpcodeDecoder::RunFifo<true>(
+        DataReader(m_video_buffer_pp_read_ptr, end_ptr), nullptr, &m_pp_pending_command_size);
+  }
   // This would have to be locked if the GPU thread didn't spin.
   m_video_buffer_write_ptr = write_ptr + GPFifo::GATHER_PIPE_SIZE;
 }
@@ -278,6 +288,8 @@ void FifoManager::ResetVideoBuffer()
   m_video_buffer_pp_read_ptr = m_video_buffer;
   m_fifo_aux_write_ptr = m_fifo_aux_data;
   m_fifo_aux_read_ptr = m_fifo_aux_data;
+  m_pending_command_size = 0;
+  m_pp_pending_command_size = 0;
 }
 
 // Description: Main FIFO update loop
@@ -304,8 +316,12 @@ void FifoManager::RunGpuLoop(Core::System& system)
           // See comment in SyncGPU
           if (write_ptr > seen_ptr)
           {
-            m_video_buffer_read_ptr =
-                OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr), nullptr);
+            if (static_cast<size_t>(write_ptr - m_video_buffer_read_ptr) >= m_pending_command_size)
+            {
+              m_video_buffer_read_ptr =
+                  OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr), nullptr,
+                                         &m_pending_command_size);
+            }
             m_video_buffer_seen_ptr = write_ptr;
           }
         }
@@ -341,8 +357,12 @@ void FifoManager::RunGpuLoop(Core::System& system)
                        distance);
 
             u8* write_ptr = m_video_buffer_write_ptr;
-            m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-                DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            if (static_cast<size_t>(write_ptr - m_video_buffer_read_ptr) >= m_pending_command_size)
+            {
+              m_video_buffer_read_ptr =
+                  OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr),
+                                         &cyclesExecuted, &m_pending_command_size);
+            }
 
             fifo.CPReadPointer.store(readPtr, std::memory_order_relaxed);
             fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
@@ -461,8 +481,12 @@ int FifoManager::RunGpuOnCpu(Core::System& system, int ticks)
       }
       ReadDataFromFifo(system, fifo.CPReadPointer.load(std::memory_order_relaxed));
       u32 cycles = 0;
-      m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-          DataReader(m_video_buffer_read_ptr, m_video_buffer_write_ptr), &cycles);
+      u8* write_ptr = m_video_buffer_write_ptr;
+      if (static_cast<size_t>(write_ptr - m_video_buffer_read_ptr) >= m_pending_command_size)
+      {
+        m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
+            DataReader(m_video_buffer_read_ptr, write_ptr), &cycles, &m_pending_command_size);
+      }
       available_ticks -= cycles;
     }
 
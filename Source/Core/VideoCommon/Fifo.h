@@ -116,6 +116,13 @@ private:
   // polls, it's just atomic.
   // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
+  // Sizes of the incomplete commands at the read_ptr and the pp_read_ptr, as reported by the
+  // opcode decoder. The FIFO isn't decoded again until that much data has been read, which avoids
+  // decoding large primitives once for every 32 bytes of them that arrive. Owned by whichever
+  // thread owns the corresponding read pointer.
+  u32 m_pending_command_size = 0;
+  u32 m_pp_pending_command_size = 0;
+
   std::atomic<int> m_sync_ticks = 0;
   bool m_syncing_suspended = false;
   Common::Event m_sync_wakeup_event;
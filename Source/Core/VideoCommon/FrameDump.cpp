@@ -7,9 +7,14 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -31,6 +36,7 @@ extern "C" {
 #include "Common/Logging/LogManager.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/WorkQueueThread.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -39,6 +45,10 @@ extern "C" {
 
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/YUVConverter.h"
+
+// Number of converted frames that can be waiting for the encoder at once.
+constexpr size_t ENCODE_QUEUE_SIZE = 3;
 
 struct FrameDumpContext
 {
@@ -46,9 +56,19 @@ struct FrameDumpContext
   AVStream* stream = nullptr;
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
-  AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  // Frames are converted to the codec's pixel format on the frame dump thread, with the help of
+  // the converter's worker threads, and then encoded on the encode thread while the next frame is
+  // being converted.
+  VideoCommon::YUVConverter converter;
+  Common::WorkQueueThread<AVFrame*> encode_thread;
+  std::array<AVFrame*, ENCODE_QUEUE_SIZE> scaled_frames{};
+  std::mutex encode_lock;
+  std::condition_variable scaled_frame_released;
+  // Frames that aren't queued for or being encoded.
+  std::vector<AVFrame*> free_scaled_frames;
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -297,14 +317,21 @@ bool FrameDump::CreateVideoFile()
   }
 
   m_context->src_frame = av_frame_alloc();
-  m_context->scaled_frame = av_frame_alloc();
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+  {
+    scaled_frame = av_frame_alloc();
+    if (!scaled_frame)
+      return false;
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
-  m_context->scaled_frame->width = m_context->width;
-  m_context->scaled_frame->height = m_context->height;
+    scaled_frame->format = m_context->codec->pix_fmt;
+    scaled_frame->width = m_context->width;
+    scaled_frame->height = m_context->height;
 
-  if (av_frame_get_buffer(m_context->scaled_frame, 1))
-    return false;
+    if (av_frame_get_buffer(scaled_frame, 1))
+      return false;
+  }
+  m_context->free_scaled_frames.assign(m_context->scaled_frames.begin(),
+                                       m_context->scaled_frames.end());
 
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
@@ -330,6 +357,12 @@ bool FrameDump::CreateVideoFile()
                  m_context->stream->time_base.num);
   }
 
+  m_context->encode_thread.Reset([this](AVFrame* frame) { EncodeFrame(frame); });
+
+  // Leave some threads for the encoder and the emulator.
+  const u32 num_conversion_threads = std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u);
+  m_context->converter.ResizeWorkerThreads(num_conversion_threads - 1);
+
   OSD::AddMessage(fmt::format("Dumping Frames to \"{}\" ({}x{})", dump_path, m_context->width,
                               m_context->height));
   return true;
@@ -372,34 +405,92 @@ void FrameDump::AddFrame(const FrameData& frame)
     }
   }
 
-  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
+  // Wait for the encoder to finish with one of the converted frames.
+  AVFrame* scaled_frame;
+  {
+    std::unique_lock lock(m_context->encode_lock);
+    m_context->scaled_frame_released.wait(
+        lock, [this] { return !m_context->free_scaled_frames.empty(); });
+    scaled_frame = m_context->free_scaled_frames.back();
+    m_context->free_scaled_frames.pop_back();
+  }
 
-  m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
-  m_context->src_frame->linesize[0] = frame.stride;
-  m_context->src_frame->format = pix_fmt;
-  m_context->src_frame->width = m_context->width;
-  m_context->src_frame->height = m_context->height;
+  // The encoder may still hold a reference to the buffer from a previous frame.
+  if (const int error = av_frame_make_writable(scaled_frame))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not make frame writable: {}", AVErrorString(error));
+    ReleaseScaledFrame(scaled_frame);
+    return;
+  }
 
-  // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
+  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
+
+  if (m_context->codec->pix_fmt == AV_PIX_FMT_YUV420P && frame.width == m_context->width &&
+      frame.height == m_context->height)
   {
-    sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+    // The common case, which is done without swscale so that it can be split across threads.
+    const VideoCommon::YUV420Planes planes{
+        scaled_frame->data[0],
+        scaled_frame->data[1],
+        scaled_frame->data[2],
+        static_cast<u32>(scaled_frame->linesize[0]),
+        static_cast<u32>(scaled_frame->linesize[1]),
+        static_cast<u32>(scaled_frame->linesize[2]),
+    };
+    m_context->converter.ConvertRGBAToYUV420(frame.data, static_cast<u32>(frame.stride),
+                                             static_cast<u32>(frame.width),
+                                             static_cast<u32>(frame.height), planes);
+  }
+  else
+  {
+    m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
+    m_context->src_frame->linesize[0] = frame.stride;
+    m_context->src_frame->format = pix_fmt;
+    m_context->src_frame->width = m_context->width;
+    m_context->src_frame->height = m_context->height;
+
+    // Convert image from RGBA to desired pixel format.
+    m_context->sws = sws_getCachedContext(
+        m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
+        m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (m_context->sws)
+    {
+      sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
+                frame.height, scaled_frame->data, scaled_frame->linesize);
+    }
   }
 
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  scaled_frame->pts = pts;
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
-  {
+  // frame.data is no longer needed once this returns, so the caller can reuse it while the
+  // converted frame is encoded.
+  m_context->encode_thread.EmplaceItem(scaled_frame);
+}
+
+void FrameDump::EncodeFrame(AVFrame* scaled_frame)
+{
+  if (const int error = avcodec_send_frame(m_context->codec, scaled_frame))
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
-    return;
-  }
+  else
+    ProcessPackets();
 
-  ProcessPackets();
+  ReleaseScaledFrame(scaled_frame);
+}
+
+void FrameDump::ReleaseScaledFrame(AVFrame* scaled_frame)
+{
+  std::lock_guard lock(m_context->encode_lock);
+  m_context->free_scaled_frames.push_back(scaled_frame);
+  m_context->scaled_frame_released.notify_one();
+}
+
+void FrameDump::WaitForEncoder()
+{
+  std::unique_lock lock(m_context->encode_lock);
+  m_context->scaled_frame_released.wait(lock, [this] {
+    return m_context->free_scaled_frames.size() == m_context->scaled_frames.size();
+  });
 }
 
 void FrameDump::ProcessPackets()
@@ -445,6 +536,9 @@ void FrameDump::Stop()
   if (!IsStarted())
     return;
 
+  // The encoder is idle once every queued frame has been encoded, so it can be flushed here.
+  WaitForEncoder();
+
   // Signal end of stream to encoder.
   if (const int flush_error = avcodec_send_frame(m_context->codec, nullptr))
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", AVErrorString(flush_error));
@@ -464,8 +558,12 @@ bool FrameDump::IsStarted() const
 
 void FrameDump::CloseVideoFile()
 {
+  m_context->encode_thread.Shutdown();
+  m_context->converter.StopWorkerThreads();
+
   av_frame_free(&m_context->src_frame);
-  av_frame_free(&m_context->scaled_frame);
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+    av_frame_free(&scaled_frame);
 
   avcodec_free_context(&m_context->codec);
 
@@ -8,6 +8,7 @@
 
 #include "Common/CommonTypes.h"
 
+struct AVFrame;
 struct FrameDumpContext;
 class PointerWrap;
 
@@ -52,6 +53,12 @@ private:
   void CheckForConfigChange(const FrameData&);
   void ProcessPackets();
 
+  // Called on the encode thread for each converted frame.
+  void EncodeFrame(AVFrame* scaled_frame);
+  void ReleaseScaledFrame(AVFrame* scaled_frame);
+  // Waits until every converted frame has been encoded.
+  void WaitForEncoder();
+
 #if defined(HAVE_FFMPEG)
   std::unique_ptr<FrameDumpContext> m_context;
 #endif
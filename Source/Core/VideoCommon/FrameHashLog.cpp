@@ -0,0 +1,95 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameHashLog.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+
+bool FrameHashLog::Open(const std::string& path)
+{
+  std::lock_guard guard(m_lock);
+  File::CreateFullPath(path);
+  if (!m_file.Open(path, "w"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open frame hash log {}", path);
+    return false;
+  }
+
+  INFO_LOG_FMT(VIDEO, "Writing frame hashes to {}", path);
+  return true;
+}
+
+void FrameHashLog::Close()
+{
+  std::lock_guard guard(m_lock);
+  if (!m_file.IsOpen())
+    return;
+
+  // Copies made after the last dumped frame still belong in the log.
+  for (const EFBCopyLine& line : m_pending_efb_copies)
+    m_file.WriteString(line.text);
+  m_pending_efb_copies.clear();
+  m_file.Close();
+}
+
+bool FrameHashLog::IsOpen() const
+{
+  std::lock_guard guard(m_lock);
+  return m_file.IsOpen();
+}
+
+void FrameHashLog::AddEFBCopy(int frame_number, u32 address, const u8* data, u32 width, u32 height,
+                              u32 stride)
+{
+  if (!IsOpen())
+    return;
+
+  const u64 hash = HashRows(data, width, height, stride, &m_efb_copy_scratch);
+  std::string text =
+      fmt::format("efbcopy {} {:08x} {}x{} {:016x}\n", frame_number, address, width, height, hash);
+
+  std::lock_guard guard(m_lock);
+  m_pending_efb_copies.push_back({frame_number, std::move(text)});
+}
+
+void FrameHashLog::AddFrame(int frame_number, const u8* data, int width, int height, int stride)
+{
+  if (!IsOpen())
+    return;
+
+  const u64 hash = HashRows(data, static_cast<u32>(width) * 4, static_cast<u32>(height),
+                            static_cast<u32>(stride), &m_frame_scratch);
+
+  std::lock_guard guard(m_lock);
+  WritePendingEFBCopies(frame_number);
+  m_file.WriteString(fmt::format("frame {} {}x{} {:016x}\n", frame_number, width, height, hash));
+}
+
+u64 FrameHashLog::HashRows(const u8* data, u32 row_size, u32 num_rows, u32 stride,
+                           std::vector<u8>* scratch)
+{
+  if (stride == row_size)
+    return Common::GetFullHash64(data, static_cast<size_t>(row_size) * num_rows);
+
+  scratch->resize(static_cast<size_t>(row_size) * num_rows);
+  for (u32 y = 0; y < num_rows; y++)
+    std::memcpy(scratch->data() + y * row_size, data + y * stride, row_size);
+  return Common::GetFullHash64(scratch->data(), scratch->size());
+}
+
+void FrameHashLog::WritePendingEFBCopies(int frame_number)
+{
+  const auto end = std::find_if(
+      m_pending_efb_copies.begin(), m_pending_efb_copies.end(),
+      [frame_number](const EFBCopyLine& line) { return line.frame_number > frame_number; });
+  for (auto it = m_pending_efb_copies.begin(); it != end; ++it)
+    m_file.WriteString(it->text);
+  m_pending_efb_copies.erase(m_pending_efb_copies.begin(), end);
+}
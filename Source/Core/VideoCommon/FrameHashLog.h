@@ -0,0 +1,59 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+// Writes a hash of every presented frame, and optionally of every EFB copy to RAM, to a text file.
+// Comparing the logs of two builds shows the first frame where their output differs, without
+// having to dump and compare full frames.
+//
+// Each line is one of:
+//   efbcopy <frame> <address> <width>x<height> <hash>
+//   frame <frame> <width>x<height> <hash>
+// where the EFB copies of a frame are listed before the frame itself.
+class FrameHashLog
+{
+public:
+  bool Open(const std::string& path);
+  void Close();
+  bool IsOpen() const;
+
+  // Called on the video thread once an EFB copy has been written to guest memory. width is in
+  // bytes, as EFB copies to RAM can be in any texture format.
+  void AddEFBCopy(int frame_number, u32 address, const u8* data, u32 width, u32 height,
+                  u32 stride);
+
+  // Called on the frame dump thread, in presentation order, with RGBA8 frame data.
+  void AddFrame(int frame_number, const u8* data, int width, int height, int stride);
+
+private:
+  struct EFBCopyLine
+  {
+    int frame_number;
+    std::string text;
+  };
+
+  static u64 HashRows(const u8* data, u32 row_size, u32 num_rows, u32 stride,
+                      std::vector<u8>* scratch);
+
+  // Writes the EFB copies made up to and including the given frame.
+  void WritePendingEFBCopies(int frame_number);
+
+  mutable std::mutex m_lock;
+  File::IOFile m_file;
+
+  // EFB copies are made on the video thread ahead of the frame dump thread, so they are held here
+  // until their frame has been written, keeping the log in the same order between runs.
+  std::vector<EFBCopyLine> m_pending_efb_copies;
+
+  // Used to hash images whose rows aren't contiguous.
+  std::vector<u8> m_efb_copy_scratch;
+  std::vector<u8> m_frame_scratch;
+};
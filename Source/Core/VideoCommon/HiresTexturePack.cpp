@@ -0,0 +1,172 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/HiresTexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace
+{
+constexpr std::string_view TEXTURE_NAME_PREFIX = "tex1_";
+constexpr std::string_view ARBITRARY_MIPMAPS_SUFFIX = "_arb";
+}  // namespace
+
+bool HiresTexturePack::Open(const std::string& path)
+{
+  m_entries.clear();
+  if (!m_file.Open(path))
+    return false;
+
+  const u8* const data = m_file.GetData();
+  const u64 size = m_file.GetSize();
+
+  Header header;
+  if (size < sizeof(header))
+    return false;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != MAGIC || header.version != VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} has an unsupported format", path);
+    return false;
+  }
+
+  const u64 index_size = static_cast<u64>(header.entry_count) * sizeof(IndexEntry);
+  const u64 names_offset = sizeof(header) + index_size;
+  if (names_offset + header.names_size > size)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} is truncated", path);
+    return false;
+  }
+
+  const char* const names = reinterpret_cast<const char*>(data + names_offset);
+  m_entries.reserve(header.entry_count);
+  for (u32 i = 0; i < header.entry_count; i++)
+  {
+    IndexEntry entry;
+    std::memcpy(&entry, data + sizeof(header) + i * sizeof(IndexEntry), sizeof(entry));
+    if (static_cast<u64>(entry.name_offset) + entry.name_length > header.names_size ||
+        entry.data_offset > size || entry.data_size > size - entry.data_offset)
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack {} has an invalid entry", path);
+      m_entries.clear();
+      return false;
+    }
+
+    m_entries.push_back({std::string(names + entry.name_offset, entry.name_length),
+                         (entry.flags & ENTRY_FLAG_ARBITRARY_MIPMAPS) != 0,
+                         std::span(data + entry.data_offset, entry.data_size)});
+  }
+
+  return true;
+}
+
+bool HiresTexturePack::Create(const std::string& directory, const std::string& path)
+{
+  struct PackedFile
+  {
+    std::string path;
+    std::string name;
+    bool has_arbitrary_mipmaps;
+    u64 size;
+  };
+
+  std::vector<PackedFile> files;
+  for (const std::string& file_path : FindTextureFiles(directory))
+  {
+    PackedFile file{file_path};
+    if (!GetTextureName(file_path, &file.name, &file.has_arbitrary_mipmaps))
+      continue;
+
+    file.size = File::GetSize(file_path);
+    if (file.size > std::numeric_limits<u32>::max())
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture {} is too large to be packed", file_path);
+      return false;
+    }
+    files.push_back(std::move(file));
+  }
+
+  // Sort the files, so that packing the same textures always gives the same pack.
+  std::sort(files.begin(), files.end(),
+            [](const PackedFile& a, const PackedFile& b) { return a.name < b.name; });
+
+  std::vector<IndexEntry> index;
+  std::string names;
+  for (const PackedFile& file : files)
+  {
+    IndexEntry entry{};
+    entry.data_size = static_cast<u32>(file.size);
+    entry.name_offset = static_cast<u32>(names.size());
+    entry.name_length = static_cast<u16>(file.name.size());
+    entry.flags = file.has_arbitrary_mipmaps ? ENTRY_FLAG_ARBITRARY_MIPMAPS : 0;
+    index.push_back(entry);
+    names += file.name;
+  }
+
+  u64 data_offset = sizeof(Header) + index.size() * sizeof(IndexEntry) + names.size();
+  for (IndexEntry& entry : index)
+  {
+    entry.data_offset = data_offset;
+    data_offset += entry.data_size;
+  }
+
+  const Header header{MAGIC, VERSION, static_cast<u32>(index.size()),
+                      static_cast<u32>(names.size())};
+
+  // Write to a temporary file first, so that a failure doesn't leave a broken pack behind.
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(path);
+  File::IOFile out(temp_path, "wb");
+  bool success = out.WriteArray(&header, 1) && out.WriteArray(index.data(), index.size()) &&
+                 out.WriteString(names);
+
+  std::vector<u8> buffer;
+  for (auto it = files.begin(); success && it != files.end(); ++it)
+  {
+    buffer.resize(it->size);
+    File::IOFile in(it->path, "rb");
+    success = in.ReadBytes(buffer.data(), buffer.size()) &&
+              out.WriteBytes(buffer.data(), buffer.size());
+    if (!success)
+      ERROR_LOG_FMT(VIDEO, "Failed to pack texture {}", it->path);
+  }
+
+  success = out.Close() && success;
+  if (!success)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write texture pack {}", path);
+    File::Delete(temp_path);
+    return false;
+  }
+
+  return File::RenameSync(temp_path, path);
+}
+
+std::vector<std::string> HiresTexturePack::FindTextureFiles(const std::string& directory)
+{
+  return Common::DoFileSearch({directory}, {".png", ".dds"}, /*recursive*/ true);
+}
+
+bool HiresTexturePack::GetTextureName(const std::string& path, std::string* name,
+                                      bool* has_arbitrary_mipmaps)
+{
+  std::string filename;
+  SplitPath(path, nullptr, &filename, nullptr);
+  if (!filename.starts_with(TEXTURE_NAME_PREFIX))
+    return false;
+
+  const size_t arb_index = filename.rfind(ARBITRARY_MIPMAPS_SUFFIX);
+  *has_arbitrary_mipmaps = arb_index != std::string::npos;
+  if (*has_arbitrary_mipmaps)
+    filename.erase(arb_index, ARBITRARY_MIPMAPS_SUFFIX.size());
+
+  *name = std::move(filename);
+  return true;
+}
@@ -0,0 +1,100 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+
+// On disk format:
+// header{
+// u32 'DTPK';
+// u32 version;
+// u32 entry_count;
+// u32 names_size;
+//}
+
+// entry[entry_count]{
+// u64 data_offset;
+// u32 data_size;
+// u32 name_offset;  // into names
+// u16 name_length;
+// u8 flags;
+// u8 padding;
+//}
+
+// char names[names_size];
+
+// u8 data[];  // the texture files, referenced by the entries
+
+// A custom texture pack stored in a single file. Opening a pack only reads its index, instead of
+// searching a directory tree that may hold thousands of files. The texture files are
+// memory-mapped, and are only read when they are loaded.
+class HiresTexturePack
+{
+public:
+  struct Entry
+  {
+    // Name of the texture file without its extension and _arb suffix.
+    std::string name;
+    bool has_arbitrary_mipmaps;
+    std::span<const u8> data;
+  };
+
+  static constexpr std::string_view FILE_EXTENSION = ".texpack";
+
+  HiresTexturePack() = default;
+  HiresTexturePack(const HiresTexturePack&) = delete;
+  HiresTexturePack& operator=(const HiresTexturePack&) = delete;
+
+  bool Open(const std::string& path);
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+  // Writes every custom texture in the directory and its subdirectories to a new pack.
+  static bool Create(const std::string& directory, const std::string& path);
+
+  // Returns the paths of the custom texture files in the directory and its subdirectories.
+  static std::vector<std::string> FindTextureFiles(const std::string& directory);
+
+  // Gets the name used to look up the texture file at path. Returns false for files which aren't
+  // custom textures.
+  static bool GetTextureName(const std::string& path, std::string* name,
+                             bool* has_arbitrary_mipmaps);
+
+private:
+  enum EntryFlags : u8
+  {
+    ENTRY_FLAG_ARBITRARY_MIPMAPS = 1 << 0,
+  };
+
+#pragma pack(push, 1)
+  struct Header
+  {
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 names_size;
+  };
+
+  struct IndexEntry
+  {
+    u64 data_offset;
+    u32 data_size;
+    u32 name_offset;
+    u16 name_length;
+    u8 flags;
+    u8 padding;
+  };
+#pragma pack(pop)
+
+  static constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+  static constexpr u32 VERSION = 1;
+
+  File::MappedFile m_file;
+  std::vector<Entry> m_entries;
+};
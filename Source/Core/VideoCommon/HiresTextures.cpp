@@ -4,12 +4,15 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
-#include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -30,6 +33,7 @@
 #include "Common/Timer.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -37,10 +41,10 @@ struct DiskTexture
 {
   std::string path;
   bool has_arbitrary_mipmaps;
+  // The file contents, if the texture is stored in the texture pack.
+  std::span<const u8> packed_data;
 };
 
-constexpr std::string_view s_format_prefix{"tex1_"};
-
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
 static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
 static std::mutex s_textureCacheMutex;
@@ -48,6 +52,96 @@ static Common::Flag s_textureCacheAbortLoading;
 
 static std::thread s_prefetcher;
 
+// Holds the files of the textures in s_textureMap when they were loaded from a texture pack.
+static std::unique_ptr<HiresTexturePack> s_texture_pack;
+
+// Texture streaming state, protected by s_textureCacheMutex.
+struct StreamingRequest
+{
+  std::string name;
+  u32 width;
+  u32 height;
+};
+
+struct StreamedTexture
+{
+  std::string name;
+  std::shared_ptr<HiresTexture> texture;
+  size_t size;
+};
+
+constexpr u32 MAX_STREAMING_THREADS = 4;
+
+static std::vector<std::thread> s_streaming_threads;
+static std::condition_variable s_streaming_wake;
+static bool s_streaming_exit = false;
+
+// Textures waiting to be loaded, with the most recently requested first.
+static std::list<StreamingRequest> s_streaming_queue;
+static std::unordered_map<std::string, std::list<StreamingRequest>::iterator> s_queued_textures;
+static std::unordered_set<std::string> s_loading_textures;
+static std::unordered_set<std::string> s_failed_textures;
+
+// Loaded textures, with the most recently used first. Once they take up more than the memory
+// budget, the least recently used textures are evicted.
+static std::list<StreamedTexture> s_streamed_textures;
+static std::unordered_map<std::string, std::list<StreamedTexture>::iterator> s_streamed_texture_map;
+static size_t s_streamed_texture_size = 0;
+static size_t s_streaming_memory_budget = 0;
+
+// Uses the texture pack for the game instead of searching its texture directories, if there is
+// one.
+static bool LoadTexturePack(const std::string& game_id)
+{
+  const std::string root_directory = File::GetUserPath(D_HIRESTEXTURES_IDX);
+  for (const std::string& id : {game_id, game_id.substr(0, 3)})
+  {
+    const std::string path = root_directory + id + std::string(HiresTexturePack::FILE_EXTENSION);
+    if (!File::Exists(path))
+      continue;
+
+    auto pack = std::make_unique<HiresTexturePack>();
+    if (!pack->Open(path))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to open texture pack {}", path);
+      continue;
+    }
+
+    bool failed_insert = false;
+    for (const HiresTexturePack::Entry& entry : pack->GetEntries())
+    {
+      const auto [it, inserted] = s_textureMap.try_emplace(
+          entry.name, DiskTexture{fmt::format("{}:{}", path, entry.name),
+                                  entry.has_arbitrary_mipmaps, entry.data});
+      if (!inserted)
+        failed_insert = true;
+    }
+
+    if (failed_insert)
+      ERROR_LOG_FMT(VIDEO, "One or more textures in pack '{}' were already inserted", path);
+
+    INFO_LOG_FMT(VIDEO, "Using {} custom textures from {}", pack->GetEntries().size(), path);
+    s_texture_pack = std::move(pack);
+    return true;
+  }
+
+  return false;
+}
+
+// Returns the contents of a custom texture file. Unless the texture is in the texture pack, the
+// file is read into buffer.
+static std::span<const u8> ReadTextureFile(const DiskTexture& texture, std::vector<u8>* buffer)
+{
+  if (texture.packed_data.data())
+    return texture.packed_data;
+
+  File::IOFile file(texture.path, "rb");
+  buffer->resize(file.GetSize());
+  if (!file.ReadBytes(buffer->data(), buffer->size()))
+    buffer->clear();
+  return *buffer;
+}
+
 void HiresTexture::Init()
 {
   // Note: Update is not called here so that we handle dynamic textures on startup more gracefully
@@ -65,6 +159,7 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopStreaming();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
@@ -77,29 +172,27 @@ void HiresTexture::Update()
     s_textureCache.clear();
   }
 
+  // The texture map may point into the texture pack, so rebuild it along with the pack.
+  s_textureMap.clear();
+  s_texture_pack.reset();
+
   const std::string& game_id = SConfig::GetInstance().GetGameID();
-  const std::set<std::string> texture_directories =
-      GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+  std::set<std::string> texture_directories;
+  if (!LoadTexturePack(game_id))
+  {
+    texture_directories =
+        GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
+  }
 
   for (const auto& texture_directory : texture_directories)
   {
-    const auto texture_paths =
-        Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
-
     bool failed_insert = false;
-    for (auto& path : texture_paths)
+    for (const std::string& path : HiresTexturePack::FindTextureFiles(texture_directory))
     {
       std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
-
-      if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
+      bool has_arbitrary_mipmaps;
+      if (HiresTexturePack::GetTextureName(path, &filename, &has_arbitrary_mipmaps))
       {
-        const size_t arb_index = filename.rfind("_arb");
-        const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
-        if (has_arbitrary_mipmaps)
-          filename.erase(arb_index, 4);
-
         const auto [it, inserted] =
             s_textureMap.try_emplace(filename, DiskTexture{path, has_arbitrary_mipmaps});
         if (!inserted)
@@ -135,6 +228,10 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Clear();
     s_prefetcher = std::thread(Prefetch);
   }
+  else if (g_ActiveConfig.bHiresTextureStreaming)
+  {
+    StartStreaming();
+  }
 }
 
 void HiresTexture::Clear()
@@ -144,8 +241,89 @@ void HiresTexture::Clear()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopStreaming();
   s_textureMap.clear();
   s_textureCache.clear();
+  s_texture_pack.reset();
+}
+
+void HiresTexture::StartStreaming()
+{
+  s_streaming_memory_budget =
+      static_cast<size_t>(std::max(g_ActiveConfig.iHiresTextureMemoryBudget, 0)) * 1024 * 1024;
+  s_streaming_exit = false;
+
+  const u32 num_threads =
+      std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_STREAMING_THREADS);
+  for (u32 i = 0; i < num_threads; i++)
+    s_streaming_threads.emplace_back(StreamingThreadRun);
+}
+
+void HiresTexture::StopStreaming()
+{
+  if (s_streaming_threads.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+    s_streaming_exit = true;
+    s_streaming_wake.notify_all();
+  }
+
+  for (std::thread& thread : s_streaming_threads)
+    thread.join();
+  s_streaming_threads.clear();
+
+  s_streaming_queue.clear();
+  s_queued_textures.clear();
+  s_failed_textures.clear();
+  s_streamed_textures.clear();
+  s_streamed_texture_map.clear();
+  s_streamed_texture_size = 0;
+}
+
+void HiresTexture::StreamingThreadRun()
+{
+  Common::SetCurrentThreadName("Custom texture loader");
+
+  std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  while (true)
+  {
+    s_streaming_wake.wait(lk, [] { return s_streaming_exit || !s_streaming_queue.empty(); });
+    if (s_streaming_exit)
+      break;
+
+    const StreamingRequest request = std::move(s_streaming_queue.front());
+    s_streaming_queue.pop_front();
+    s_queued_textures.erase(request.name);
+    s_loading_textures.insert(request.name);
+
+    lk.unlock();
+    std::unique_ptr<HiresTexture> texture = Load(request.name, request.width, request.height);
+    lk.lock();
+
+    s_loading_textures.erase(request.name);
+    if (!texture)
+    {
+      // Don't queue it again every time it is used.
+      s_failed_textures.insert(request.name);
+      continue;
+    }
+
+    const size_t size = texture->GetMemorySize();
+    s_streamed_textures.push_front({request.name, std::move(texture), size});
+    s_streamed_texture_map.emplace(request.name, s_streamed_textures.begin());
+    s_streamed_texture_size += size;
+
+    // Always keep the texture that was just loaded, even if it is over the budget on its own.
+    while (s_streamed_texture_size > s_streaming_memory_budget && s_streamed_textures.size() > 1)
+    {
+      const StreamedTexture& evicted = s_streamed_textures.back();
+      s_streamed_texture_size -= evicted.size;
+      s_streamed_texture_map.erase(evicted.name);
+      s_streamed_textures.pop_back();
+    }
+  }
 }
 
 void HiresTexture::Prefetch()
@@ -261,10 +439,17 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
   return mip_count;
 }
 
-std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
+std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info,
+                                                   std::string* pending_name)
 {
   const std::string base_filename = GenBaseName(texture_info);
 
+  if (!s_streaming_threads.empty())
+  {
+    return SearchStreamed(base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight(),
+                          pending_name);
+  }
+
   std::lock_guard<std::mutex> lk(s_textureCacheMutex);
 
   auto iter = s_textureCache.find(base_filename);
@@ -284,6 +469,50 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
   return ptr;
 }
 
+std::shared_ptr<HiresTexture> HiresTexture::SearchStreamed(const std::string& base_filename,
+                                                           u32 width, u32 height,
+                                                           std::string* pending_name)
+{
+  if (base_filename.empty())
+    return nullptr;
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+
+  const auto streamed_iter = s_streamed_texture_map.find(base_filename);
+  if (streamed_iter != s_streamed_texture_map.end())
+  {
+    s_streamed_textures.splice(s_streamed_textures.begin(), s_streamed_textures,
+                               streamed_iter->second);
+    return streamed_iter->second->texture;
+  }
+
+  if (s_failed_textures.contains(base_filename))
+    return nullptr;
+
+  // Load the most recently requested textures first, as those are the ones being drawn now.
+  const auto queued_iter = s_queued_textures.find(base_filename);
+  if (queued_iter != s_queued_textures.end())
+  {
+    s_streaming_queue.splice(s_streaming_queue.begin(), s_streaming_queue, queued_iter->second);
+  }
+  else if (!s_loading_textures.contains(base_filename))
+  {
+    s_streaming_queue.push_front({base_filename, width, height});
+    s_queued_textures.emplace(base_filename, s_streaming_queue.begin());
+    s_streaming_wake.notify_one();
+  }
+
+  if (pending_name)
+    *pending_name = base_filename;
+  return nullptr;
+}
+
+bool HiresTexture::IsLoadPending(const std::string& name)
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  return s_queued_textures.contains(name) || s_loading_textures.contains(name);
+}
+
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
                                                  u32 height)
 {
@@ -298,7 +527,9 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
   const DiskTexture& first_mip_file = filename_iter->second;
   ret->m_has_arbitrary_mipmaps = first_mip_file.has_arbitrary_mipmaps;
-  LoadDDSTexture(ret.get(), first_mip_file.path);
+  std::vector<u8> buffer;
+  const std::span<const u8> first_mip_data = ReadTextureFile(first_mip_file, &buffer);
+  LoadDDSTexture(ret.get(), first_mip_data, first_mip_file.path);
 
   // Load remaining mip levels, or from the start if it's not a DDS texture.
   for (u32 mip_level = static_cast<u32>(ret->m_levels.size());; mip_level++)
@@ -311,21 +542,17 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     if (filename_iter == s_textureMap.end())
       break;
 
+    // The first file has already been read for the DDS check above.
+    const std::span<const u8> data =
+        mip_level == 0 ? first_mip_data : ReadTextureFile(filename_iter->second, &buffer);
+
     // Try loading DDS textures first, that way we maintain compression of DXT formats.
-    // TODO: Reduce the number of open() calls here. We could use one fd.
     Level level;
-    if (!LoadDDSTexture(level, filename_iter->second.path, mip_level))
+    if (!LoadDDSTexture(level, data, filename_iter->second.path, mip_level) &&
+        !LoadTexture(level, data))
     {
-      File::IOFile file;
-      file.Open(filename_iter->second.path, "rb");
-      std::vector<u8> buffer(file.GetSize());
-      file.ReadBytes(buffer.data(), file.GetSize());
-
-      if (!LoadTexture(level, buffer))
-      {
-        ERROR_LOG_FMT(VIDEO, "Custom texture {} failed to load", filename);
-        break;
-      }
+      ERROR_LOG_FMT(VIDEO, "Custom texture {} failed to load", filename);
+      break;
     }
 
     ret->m_levels.push_back(std::move(level));
@@ -398,9 +625,9 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   return ret;
 }
 
-bool HiresTexture::LoadTexture(Level& level, const std::vector<u8>& buffer)
+bool HiresTexture::LoadTexture(Level& level, std::span<const u8> data)
 {
-  if (!Common::LoadPNG(buffer, &level.data, &level.width, &level.height))
+  if (!Common::LoadPNG(data, &level.data, &level.width, &level.height))
     return false;
 
   if (level.data.empty())
@@ -471,3 +698,11 @@ bool HiresTexture::HasArbitraryMipmaps() const
 {
   return m_has_arbitrary_mipmaps;
 }
+
+size_t HiresTexture::GetMemorySize() const
+{
+  size_t size = 0;
+  for (const Level& level : m_levels)
+    size += level.data.size();
+  return size;
+}
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -25,7 +26,14 @@ public:
   static void Clear();
   static void Shutdown();
 
-  static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info);
+  // Returns the custom texture for texture_info, if there is one. When custom textures are
+  // streamed, a texture that isn't loaded yet is queued for loading in the background instead, and
+  // its name is returned in pending_name so that the caller can check back with IsLoadPending.
+  static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info,
+                                              std::string* pending_name = nullptr);
+
+  // Returns true while a texture returned as pending by Search is queued or being loaded.
+  static bool IsLoadPending(const std::string& name);
 
   static std::string GenBaseName(const TextureInfo& texture_info, bool dump = false);
 
@@ -49,11 +57,21 @@ public:
 private:
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
                                             u32 height);
-  static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
-  static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
-  static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
+  static bool LoadDDSTexture(HiresTexture* tex, std::span<const u8> data,
+                             const std::string& filename);
+  static bool LoadDDSTexture(Level& level, std::span<const u8> data, const std::string& filename,
+                             u32 mip_level);
+  static bool LoadTexture(Level& level, std::span<const u8> data);
   static void Prefetch();
 
+  static std::shared_ptr<HiresTexture> SearchStreamed(const std::string& base_filename, u32 width,
+                                                      u32 height, std::string* pending_name);
+  static void StartStreaming();
+  static void StopStreaming();
+  static void StreamingThreadRun();
+
+  size_t GetMemorySize() const;
+
   HiresTexture() = default;
   bool m_has_arbitrary_mipmaps = false;
 };
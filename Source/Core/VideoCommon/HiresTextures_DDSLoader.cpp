@@ -8,9 +8,9 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <span>
 
 #include "Common/Align.h"
-#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
 #include "VideoCommon/VideoConfig.h"
@@ -227,7 +227,39 @@ void ConvertTexture_R8G8B8(HiresTexture::Level* level)
   level->data = std::move(new_data);
 }
 
-bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
+// Reads a DDS file that has been loaded into memory.
+class DDSReader
+{
+public:
+  explicit DDSReader(std::span<const u8> data) : m_data(data) {}
+
+  bool ReadBytes(void* dst, size_t size)
+  {
+    if (size > m_data.size() - m_position)
+      return false;
+
+    std::memcpy(dst, m_data.data() + m_position, size);
+    m_position += size;
+    return true;
+  }
+
+  bool Seek(size_t position)
+  {
+    if (position > m_data.size())
+      return false;
+
+    m_position = position;
+    return true;
+  }
+
+  size_t GetSize() const { return m_data.size(); }
+
+private:
+  std::span<const u8> m_data;
+  size_t m_position = 0;
+};
+
+bool ParseDDSHeader(DDSReader& file, DDSLoadInfo* info)
 {
   // Exit as early as possible for non-DDS textures, since all extensions are currently
   // passed through this function.
@@ -400,7 +432,7 @@ bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
   return true;
 }
 
-bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::string& filename,
+bool ReadMipLevel(HiresTexture::Level* level, DDSReader& file, const std::string& filename,
                   u32 mip_level, const DDSLoadInfo& info, u32 width, u32 height, u32 row_length,
                   size_t size)
 {
@@ -434,20 +466,17 @@ bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::str
 
 }  // namespace
 
-bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename)
+bool HiresTexture::LoadDDSTexture(HiresTexture* tex, std::span<const u8> data,
+                                  const std::string& filename)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
-    return false;
-
+  DDSReader file(data);
   DDSLoadInfo info;
   if (!ParseDDSHeader(file, &info))
     return false;
 
   // Read first mip level, as it may have a custom pitch.
   Level first_level;
-  if (!file.Seek(info.first_mip_offset, File::SeekOrigin::Begin) ||
+  if (!file.Seek(info.first_mip_offset) ||
       !ReadMipLevel(&first_level, file, filename, 0, info, info.width, info.height,
                     info.first_mip_row_length, info.first_mip_size))
   {
@@ -481,14 +510,11 @@ bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename
   return true;
 }
 
-bool HiresTexture::LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level)
+bool HiresTexture::LoadDDSTexture(Level& level, std::span<const u8> data,
+                                  const std::string& filename, u32 mip_level)
 {
   // Only loading a single mip level.
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
-    return false;
-
+  DDSReader file(data);
   DDSLoadInfo info;
   if (!ParseDDSHeader(file, &info))
     return false;
@@ -6,16 +6,143 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <numeric>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// Indices of a primitive which repeat with a fixed period. Repeat r writes
+// base + offsets[i] + r * advance[i] for each index i, or a primitive restart where offsets[i] is
+// s_primitive_restart. The advance is per index, so that a fan can keep its center vertex.
+template <size_t Period>
+struct IndexPattern
+{
+  std::array<u16, Period> offsets;
+  std::array<u16, Period> advance;
+};
+
+constexpr size_t SIMD_LANES = 8;
+
+// A pattern repeated until it fills a whole number of SIMD vectors, so that the indices of the
+// next group of repeats are one vector add away.
+template <size_t Period>
+struct UnrolledIndexPattern
+{
+  static constexpr size_t LANES = std::lcm(Period, SIMD_LANES);
+  static constexpr u32 REPEATS = LANES / Period;
+
+  constexpr explicit UnrolledIndexPattern(const IndexPattern<Period>& pattern)
+  {
+    for (size_t i = 0; i < LANES; i++)
+    {
+      const u16 offset = pattern.offsets[i % Period];
+      const u16 advance = pattern.advance[i % Period];
+      const bool restart = offset == s_primitive_restart;
+      offsets[i] = restart ? s_primitive_restart : offset + (i / Period) * advance;
+      group_advance[i] = restart ? 0 : advance * REPEATS;
+      base_mask[i] = restart ? 0 : UINT16_MAX;
+    }
+  }
+
+  alignas(16) std::array<u16, LANES> offsets{};
+  alignas(16) std::array<u16, LANES> group_advance{};
+  alignas(16) std::array<u16, LANES> base_mask{};
+};
+
+template <const auto& pattern>
+u16* WritePattern(u16* index_ptr, u32 base, u32 repeats)
+{
+  static constexpr UnrolledIndexPattern unrolled(pattern);
+  using Unrolled = decltype(unrolled);
+  constexpr size_t NUM_VECTORS = Unrolled::LANES / SIMD_LANES;
+
+  u32 repeat = 0;
+#if defined(_M_X86)
+  if (repeats >= Unrolled::REPEATS)
+  {
+    const __m128i base_vector = _mm_set1_epi16(static_cast<s16>(base));
+    __m128i indices[NUM_VECTORS];
+    __m128i advance[NUM_VECTORS];
+    for (size_t i = 0; i < NUM_VECTORS; i++)
+    {
+      const auto load = [i](const auto& lanes) {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(&lanes[i * SIMD_LANES]));
+      };
+      indices[i] = _mm_add_epi16(load(unrolled.offsets),
+                                 _mm_and_si128(base_vector, load(unrolled.base_mask)));
+      advance[i] = load(unrolled.group_advance);
+    }
+
+    for (; repeat + Unrolled::REPEATS <= repeats; repeat += Unrolled::REPEATS)
+    {
+      for (size_t i = 0; i < NUM_VECTORS; i++)
+      {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr), indices[i]);
+        indices[i] = _mm_add_epi16(indices[i], advance[i]);
+        index_ptr += SIMD_LANES;
+      }
+    }
+  }
+#elif defined(_M_ARM_64)
+  if (repeats >= Unrolled::REPEATS)
+  {
+    const uint16x8_t base_vector = vdupq_n_u16(static_cast<u16>(base));
+    uint16x8_t indices[NUM_VECTORS];
+    uint16x8_t advance[NUM_VECTORS];
+    for (size_t i = 0; i < NUM_VECTORS; i++)
+    {
+      const auto load = [i](const auto& lanes) { return vld1q_u16(&lanes[i * SIMD_LANES]); };
+      indices[i] =
+          vaddq_u16(load(unrolled.offsets), vandq_u16(base_vector, load(unrolled.base_mask)));
+      advance[i] = load(unrolled.group_advance);
+    }
+
+    for (; repeat + Unrolled::REPEATS <= repeats; repeat += Unrolled::REPEATS)
+    {
+      for (size_t i = 0; i < NUM_VECTORS; i++)
+      {
+        vst1q_u16(index_ptr, indices[i]);
+        indices[i] = vaddq_u16(indices[i], advance[i]);
+        index_ptr += SIMD_LANES;
+      }
+    }
+  }
+#endif
+
+  // Write the repeats which don't fill a whole group, without writing past the last index.
+  for (; repeat < repeats; repeat++)
+  {
+    for (size_t i = 0; i < pattern.offsets.size(); i++)
+    {
+      const u16 offset = pattern.offsets[i];
+      *index_ptr++ = offset == s_primitive_restart ?
+                         s_primitive_restart :
+                         static_cast<u16>(base + offset + repeat * pattern.advance[i]);
+    }
+  }
+  return index_ptr;
+}
+
+constexpr u16 RESTART = s_primitive_restart;
+
+constexpr IndexPattern<1> SEQUENTIAL_PATTERN{{0}, {1}};
+
+u16* WriteSequential(u16* index_ptr, u32 base, u32 count)
+{
+  return WritePattern<SEQUENTIAL_PATTERN>(index_ptr, base, count);
+}
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -27,35 +154,36 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
   return index_ptr;
 }
 
+constexpr IndexPattern<4> LIST_PATTERN_PR{{0, 1, 2, RESTART}, {3, 3, 3, 0}};
+
 template <bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
-  {
-    index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
-  }
-  return index_ptr;
+  if constexpr (pr)
+    return WritePattern<LIST_PATTERN_PR>(index_ptr, index, num_verts / 3);
+  else
+    return WriteSequential(index_ptr, index, num_verts / 3 * 3);
 }
 
+// Each pair of triangles in a strip is 012, 132, with the winding of the second one flipped.
+constexpr IndexPattern<6> STRIP_PATTERN{{0, 1, 2, 1, 3, 2}, {2, 2, 2, 2, 2, 2}};
+
 template <bool pr>
 u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
-    {
-      *index_ptr++ = index + i;
-    }
+    index_ptr = WriteSequential(index_ptr, index, num_verts);
     *index_ptr++ = s_primitive_restart;
   }
-  else
+  else if (num_verts > 2)
   {
-    bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    const u32 num_pairs = (num_verts - 2) / 2;
+    index_ptr = WritePattern<STRIP_PATTERN>(index_ptr, index, num_pairs);
+    if ((num_verts - 2) % 2 != 0)
     {
-      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
-
-      wind ^= true;
+      const u32 i = index + num_pairs * 2;
+      index_ptr = WriteTriangle<pr>(index_ptr, i, i + 1, i + 2);
     }
   }
   return index_ptr;
@@ -80,6 +208,9 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
  * so we use 6 indices for 3 triangles
  */
 
+constexpr IndexPattern<3> FAN_PATTERN{{0, 1, 2}, {0, 1, 1}};
+constexpr IndexPattern<6> FAN_PATTERN_PR{{1, 2, 0, 3, 4, RESTART}, {3, 3, 0, 3, 3, 0}};
+
 template <bool pr>
 u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 {
@@ -87,29 +218,27 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 
   if constexpr (pr)
   {
-    for (; i + 3 <= num_verts; i += 3)
+    const u32 num_strips = num_verts > 2 ? (num_verts - 2) / 3 : 0;
+    index_ptr = WritePattern<FAN_PATTERN_PR>(index_ptr, index, num_strips);
+    i += num_strips * 3;
+
+    for (; i + 2 <= num_verts; i += 2)
     {
       *index_ptr++ = index + i - 1;
       *index_ptr++ = index + i + 0;
       *index_ptr++ = index;
       *index_ptr++ = index + i + 1;
-      *index_ptr++ = index + i + 2;
       *index_ptr++ = s_primitive_restart;
     }
 
-    for (; i + 2 <= num_verts; i += 2)
+    for (; i < num_verts; ++i)
     {
-      *index_ptr++ = index + i - 1;
-      *index_ptr++ = index + i + 0;
-      *index_ptr++ = index;
-      *index_ptr++ = index + i + 1;
-      *index_ptr++ = s_primitive_restart;
+      index_ptr = WriteTriangle<pr>(index_ptr, index, index + i - 1, index + i);
     }
   }
-
-  for (; i < num_verts; ++i)
+  else if (num_verts > 2)
   {
-    index_ptr = WriteTriangle<pr>(index_ptr, index, index + i - 1, index + i);
+    index_ptr = WritePattern<FAN_PATTERN>(index_ptr, index, num_verts - 2);
   }
   return index_ptr;
 }
@@ -131,29 +260,19 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
  * A simple triangle has to be rendered for three vertices.
  * ZWW do this for sun rays
  */
+constexpr IndexPattern<6> QUADS_PATTERN{{0, 1, 2, 0, 2, 3}, {4, 4, 4, 4, 4, 4}};
+constexpr IndexPattern<5> QUADS_PATTERN_PR{{1, 2, 0, 3, RESTART}, {4, 4, 4, 4, 0}};
+
 template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
-  u32 i = 3;
-  for (; i < num_verts; i += 4)
-  {
-    if constexpr (pr)
-    {
-      *index_ptr++ = index + i - 2;
-      *index_ptr++ = index + i - 1;
-      *index_ptr++ = index + i - 3;
-      *index_ptr++ = index + i - 0;
-      *index_ptr++ = s_primitive_restart;
-    }
-    else
-    {
-      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 3, index + i - 2, index + i - 1);
-      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 3, index + i - 1, index + i - 0);
-    }
-  }
+  if constexpr (pr)
+    index_ptr = WritePattern<QUADS_PATTERN_PR>(index_ptr, index, num_verts / 4);
+  else
+    index_ptr = WritePattern<QUADS_PATTERN>(index_ptr, index, num_verts / 4);
 
   // three vertices remaining, so render a triangle
-  if (i == num_verts)
+  if (num_verts % 4 == 3)
   {
     index_ptr = WriteTriangle<pr>(index_ptr, index + num_verts - 3, index + num_verts - 2,
                                   index + num_verts - 1);
@@ -170,95 +289,69 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
-  {
-    *index_ptr++ = index + i - 1;
-    *index_ptr++ = index + i;
-  }
-  return index_ptr;
+  return WriteSequential(index_ptr, index, num_verts / 2 * 2);
 }
 
+constexpr IndexPattern<2> LINE_STRIP_PATTERN{{0, 1}, {1, 1}};
+
 // Shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
-  {
-    *index_ptr++ = index + i - 1;
-    *index_ptr++ = index + i;
-  }
-  return index_ptr;
+  if (num_verts < 2)
+    return index_ptr;
+  return WritePattern<LINE_STRIP_PATTERN>(index_ptr, index, num_verts - 1);
 }
 
+// VS Expand uses (index >> 2) as the base vertex
+// Bit 0 indicates which side of the line (left/right for a vertical line)
+// Bit 1 indicates which point of the line (top/bottom for a vertical line)
+// VS Expand assumes the two points will be adjacent vertices
+constexpr IndexPattern<5> LINES_VS_EXPAND_PATTERN_PR{{0, 1, 6, 7, RESTART}, {8, 8, 8, 8, 0}};
+constexpr IndexPattern<6> LINES_VS_EXPAND_PATTERN{{0, 1, 6, 1, 6, 7}, {8, 8, 8, 8, 8, 8}};
+constexpr IndexPattern<5> LINE_STRIP_VS_EXPAND_PATTERN_PR{{0, 1, 6, 7, RESTART}, {4, 4, 4, 4, 0}};
+constexpr IndexPattern<6> LINE_STRIP_VS_EXPAND_PATTERN{{0, 1, 6, 1, 6, 7}, {4, 4, 4, 4, 4, 4}};
+
 template <bool pr, bool linestrip>
 u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
-  // VS Expand uses (index >> 2) as the base vertex
-  // Bit 0 indicates which side of the line (left/right for a vertical line)
-  // Bit 1 indicates which point of the line (top/bottom for a vertical line)
-  // VS Expand assumes the two points will be adjacent vertices
-  constexpr u32 advance = linestrip ? 1 : 2;
-  for (u32 i = 1; i < num_verts; i += advance)
+  const u32 base = index << 2;
+  if constexpr (linestrip)
   {
-    u32 p0 = (index + i - 1) << 2;
-    u32 p1 = (index + i - 0) << 2;
+    if (num_verts < 2)
+      return index_ptr;
     if constexpr (pr)
-    {
-      *index_ptr++ = p0 + 0;
-      *index_ptr++ = p0 + 1;
-      *index_ptr++ = p1 + 2;
-      *index_ptr++ = p1 + 3;
-      *index_ptr++ = s_primitive_restart;
-    }
+      return WritePattern<LINE_STRIP_VS_EXPAND_PATTERN_PR>(index_ptr, base, num_verts - 1);
     else
-    {
-      *index_ptr++ = p0 + 0;
-      *index_ptr++ = p0 + 1;
-      *index_ptr++ = p1 + 2;
-      *index_ptr++ = p0 + 1;
-      *index_ptr++ = p1 + 2;
-      *index_ptr++ = p1 + 3;
-    }
+      return WritePattern<LINE_STRIP_VS_EXPAND_PATTERN>(index_ptr, base, num_verts - 1);
+  }
+  else if constexpr (pr)
+  {
+    return WritePattern<LINES_VS_EXPAND_PATTERN_PR>(index_ptr, base, num_verts / 2);
+  }
+  else
+  {
+    return WritePattern<LINES_VS_EXPAND_PATTERN>(index_ptr, base, num_verts / 2);
   }
-  return index_ptr;
 }
 
 u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 0; i != num_verts; ++i)
-  {
-    *index_ptr++ = index + i;
-  }
-  return index_ptr;
+  return WriteSequential(index_ptr, index, num_verts);
 }
 
+// VS Expand uses (index >> 2) as the base vertex
+// Bottom two bits indicate which of (TL, TR, BL, BR) this is
+constexpr IndexPattern<5> POINTS_VS_EXPAND_PATTERN_PR{{0, 1, 2, 3, RESTART}, {4, 4, 4, 4, 0}};
+constexpr IndexPattern<6> POINTS_VS_EXPAND_PATTERN{{0, 1, 2, 1, 2, 3}, {4, 4, 4, 4, 4, 4}};
+
 template <bool pr>
 u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
-  // VS Expand uses (index >> 2) as the base vertex
-  // Bottom two bits indicate which of (TL, TR, BL, BR) this is
-  for (u32 i = 0; i < num_verts; ++i)
-  {
-    u32 base = (index + i) << 2;
-    if constexpr (pr)
-    {
-      *index_ptr++ = base + 0;
-      *index_ptr++ = base + 1;
-      *index_ptr++ = base + 2;
-      *index_ptr++ = base + 3;
-      *index_ptr++ = s_primitive_restart;
-    }
-    else
-    {
-      *index_ptr++ = base + 0;
-      *index_ptr++ = base + 1;
-      *index_ptr++ = base + 2;
-      *index_ptr++ = base + 1;
-      *index_ptr++ = base + 2;
-      *index_ptr++ = base + 3;
-    }
-  }
-  return index_ptr;
+  if constexpr (pr)
+    return WritePattern<POINTS_VS_EXPAND_PATTERN_PR>(index_ptr, index << 2, num_verts);
+  else
+    return WritePattern<POINTS_VS_EXPAND_PATTERN>(index_ptr, index << 2, num_verts);
 }
 }  // Anonymous namespace
 
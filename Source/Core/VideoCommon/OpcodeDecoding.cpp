@@ -14,6 +14,8 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <optional>
+
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
@@ -53,6 +55,19 @@ public:
   OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
   {
     m_cycles += 12;
+
+    // Games set up the vertex format before nearly every draw, usually without changing it. Those
+    // writes don't need to mark the vertex loaders or array bases as dirty.
+    if (GetCPState().IsRedundantWrite(command, value))
+    {
+      if constexpr (!is_preprocess)
+      {
+        INCSTAT(g_stats.this_frame.num_cp_loads);
+        INCSTAT(g_stats.this_frame.num_redundant_cp_loads);
+      }
+      return;
+    }
+
     const u8 sub_command = command & CP_COMMAND_MASK;
     if constexpr (!is_preprocess)
     {
@@ -257,21 +272,77 @@ public:
   bool m_in_display_list = false;
 };
 
+// Returns the size of an incomplete command, or the number of bytes needed to determine it.
 template <bool is_preprocess>
-u8* RunFifo(DataReader src, u32* cycles)
+static u32 GetIncompleteCommandSize(const u8* data, u32 available)
+{
+  const Opcode cmd = static_cast<Opcode>(data[0]);
+
+  switch (cmd)
+  {
+  case Opcode::GX_LOAD_CP_REG:
+    return 6;
+
+  case Opcode::GX_LOAD_XF_REG:
+    if (available < 5)
+      return 5;
+    return 5 + (((Common::swap32(&data[1]) >> 16) & 0xf) + 1) * 4;
+
+  case Opcode::GX_LOAD_INDX_A:
+  case Opcode::GX_LOAD_INDX_B:
+  case Opcode::GX_LOAD_INDX_C:
+  case Opcode::GX_LOAD_INDX_D:
+  case Opcode::GX_LOAD_BP_REG:
+    return 5;
+
+  case Opcode::GX_CMD_CALL_DL:
+    return 9;
+
+  default:
+    if (cmd >= Opcode::GX_PRIMITIVE_START && cmd <= Opcode::GX_PRIMITIVE_END)
+    {
+      if (available < 3)
+        return 3;
+
+      // The decoder has already refreshed the loader while trying to run this command.
+      const u8 vat = data[0] & GX_VAT_MASK;
+      const u32 vertex_size = VertexLoaderManager::RefreshLoader<is_preprocess>(vat)->m_vertex_size;
+      return 3 + Common::swap16(&data[1]) * vertex_size;
+    }
+    return 0;
+  }
+}
+
+template <bool is_preprocess>
+u8* RunFifo(DataReader src, u32* cycles, u32* pending_size)
 {
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
+
+  // Preprocessing runs ahead on the CPU thread, so only time the commands being executed.
+  std::optional<ScopedStageTimer> stage_timer;
+  if constexpr (!is_preprocess)
+    stage_timer.emplace(GPUStage::OpcodeDecoding);
+
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
 
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
 
+  if (pending_size != nullptr)
+  {
+    const u32 remaining = static_cast<u32>(src.size()) - size;
+    if (remaining != 0)
+      *pending_size = GetIncompleteCommandSize<is_preprocess>(src.GetPointer() + size, remaining);
+    else
+      *pending_size = 0;
+  }
+
   src.Skip(size);
   return src.GetPointer();
 }
 
-template u8* RunFifo<true>(DataReader src, u32* cycles);
-template u8* RunFifo<false>(DataReader src, u32* cycles);
+template u8* RunFifo<true>(DataReader src, u32* cycles, u32* pending_size);
+template u8* RunFifo<false>(DataReader src, u32* cycles, u32* pending_size);
 
 }  // namespace OpcodeDecoder
@@ -273,8 +273,12 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
   return size;
 }
 
+// Runs every complete command in src and returns a pointer to the first command that isn't. If
+// pending_size is not null, it is set to the size of that command once enough of it is known, or 0
+// if the end of src was reached. Running the FIFO again before that many bytes are available would
+// only decode the same incomplete command again.
 template <bool is_preprocess = false>
-u8* RunFifo(DataReader src, u32* cycles);
+u8* RunFifo(DataReader src, u32* cycles, u32* pending_size = nullptr);
 
 }  // namespace OpcodeDecoder
 
@@ -6,7 +6,10 @@
 #include <imgui.h>
 #include <implot.h>
 
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/SoundStream.h"
 #include "Core/HW/VideoInterface.h"
+#include "Core/System.h"
 #include "VideoCommon/VideoConfig.h"
 
 PerformanceMetrics g_perf_metrics;
@@ -49,6 +52,22 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
   return DT_s(m_speed_counter.GetLastRawDt()).count() * VideoInterface::GetTargetRefreshRate();
 }
 
+double PerformanceMetrics::GetAudioLatency() const
+{
+  const SoundStream* sound_stream = Core::System::GetInstance().GetSoundStream();
+  if (!sound_stream)
+    return 0.0;
+  return sound_stream->GetMixer()->GetLatencyController().GetLatency();
+}
+
+u64 PerformanceMetrics::GetAudioUnderruns() const
+{
+  const SoundStream* sound_stream = Core::System::GetInstance().GetSoundStream();
+  if (!sound_stream)
+    return 0;
+  return sound_stream->GetMixer()->GetLatencyController().GetUnderrunCount();
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale) const
 {
   const float bg_alpha = 0.7f;
@@ -203,6 +222,23 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale) const
     }
   }
 
+  if (g_ActiveConfig.bShowAudioLatency)
+  {
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, (12.f + 17.f * 2) * backbuffer_scale));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+    window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("AudioStats", nullptr, imgui_flags))
+    {
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Aud:%5.1lfms", GetAudioLatency());
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "XRun:%6llu",
+                         static_cast<unsigned long long>(GetAudioUnderruns()));
+      ImGui::End();
+    }
+  }
+
   if (g_ActiveConfig.bShowSpeed)
   {
     // Position in the top-right corner of the screen.
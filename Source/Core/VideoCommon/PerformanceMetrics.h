@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/PerformanceTracker.h"
 
 class PerformanceMetrics
@@ -28,6 +29,9 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  double GetAudioLatency() const;
+  u64 GetAudioUnderruns() const;
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale) const;
 
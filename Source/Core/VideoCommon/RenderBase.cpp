@@ -164,6 +164,7 @@ void Renderer::Shutdown()
   // First stop any framedumping, which might need to dump the last xfb frame. This process
   // can require additional graphics sub-systems so it needs to be done first
   ShutdownFrameDumping();
+  m_frame_hash_log.Close();
   ShutdownImGui();
   m_post_processor.reset();
   m_bounding_box.reset();
@@ -1319,6 +1320,8 @@ void Renderer::UpdateWidescreenHeuristic()
 
 void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks)
 {
+  ScopedStageTimer stage_timer(GPUStage::BackendSubmission);
+
   if (SConfig::GetInstance().bWii)
     m_is_game_widescreen = Config::Get(Config::SYSCONF_WIDESCREEN);
 
@@ -1342,6 +1345,7 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
   // This is required even if frame dumping has stopped, since the frame dump is one frame
   // behind the renderer.
   FlushFrameDump();
+  UpdateFrameHashLog();
 
   if (g_ActiveConfig.bGraphicMods)
   {
@@ -1507,6 +1511,9 @@ bool Renderer::IsFrameDumping() const
   if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
     return true;
 
+  if (m_frame_hash_log.IsOpen())
+    return true;
+
   return false;
 }
 
@@ -1517,7 +1524,9 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
   int source_width = src_rect.GetWidth();
   int source_height = src_rect.GetHeight();
   int target_width, target_height;
-  if (!g_ActiveConfig.bInternalResolutionFrameDumps && !IsHeadless())
+  // Frame hashes must not depend on the window size, so they always use the internal resolution.
+  if (!g_ActiveConfig.bInternalResolutionFrameDumps && !IsHeadless() &&
+      !m_frame_hash_log.IsOpen())
   {
     auto target_rect = GetTargetRectangle();
     target_width = target_rect.GetWidth();
@@ -1528,6 +1537,10 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
     std::tie(target_width, target_height) = CalculateOutputDimensions(source_width, source_height);
   }
 
+  // Drop the frame here if the dump thread has fallen too far behind, before doing any work.
+  if (!WaitForFrameDumpReadback())
+    return;
+
   // We only need to render a copy if we need to stretch/scale the XFB copy.
   MathUtil::Rectangle<int> copy_rect = src_rect;
   if (source_width != target_width || source_height != target_height)
@@ -1544,8 +1557,9 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
   if (!CheckFrameDumpReadbackTexture(target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
+  AbstractStagingTexture* const readback =
+      m_frame_dump_readbacks[m_frame_dump_queued % NUM_FRAME_DUMP_READBACKS].texture.get();
+  readback->CopyFromTexture(src_texture, copy_rect, 0, 0, readback->GetRect());
   m_last_frame_state = m_frame_dump.FetchState(ticks, frame_number);
   m_frame_dump_needs_flush = true;
 }
@@ -1579,7 +1593,8 @@ bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
 
 bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex =
+      m_frame_dump_readbacks[m_frame_dump_queued % NUM_FRAME_DUMP_READBACKS].texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -1593,18 +1608,41 @@ bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height
   return true;
 }
 
+bool Renderer::WaitForFrameDumpReadback()
+{
+  UnmapProcessedFrameDumps();
+  if (m_frame_dump_queued - m_frame_dump_unmapped < NUM_FRAME_DUMP_READBACKS)
+    return true;
+
+  // Frame hash logs need every frame, so never drop them while one is open.
+  if (g_ActiveConfig.bDumpDropLateFrames && !m_frame_hash_log.IsOpen())
+  {
+    g_stats.num_frame_dump_drops++;
+    return false;
+  }
+
+  // Wait for the dump thread to finish with the oldest frame.
+  g_stats.num_frame_dump_stalls++;
+  while (m_frame_dump_processed.load(std::memory_order_acquire) == m_frame_dump_unmapped)
+    m_frame_dump_done.Wait();
+  UnmapProcessedFrameDumps();
+  return true;
+}
+
+void Renderer::UnmapProcessedFrameDumps()
+{
+  const u32 processed = m_frame_dump_processed.load(std::memory_order_acquire);
+  for (; m_frame_dump_unmapped != processed; m_frame_dump_unmapped++)
+    m_frame_dump_readbacks[m_frame_dump_unmapped % NUM_FRAME_DUMP_READBACKS].texture->Unmap();
+}
+
 void Renderer::FlushFrameDump()
 {
   if (!m_frame_dump_needs_flush)
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
-
   // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
+  auto& output = m_frame_dump_readbacks[m_frame_dump_queued % NUM_FRAME_DUMP_READBACKS].texture;
   output->Flush();
   if (output->Map())
   {
@@ -1631,7 +1669,7 @@ void Renderer::ShutdownFrameDumping()
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
+  // Ensure all queued frames have been encoded.
   FinishFrameData();
 
   // Wake thread up, and wait for it to exit.
@@ -1642,13 +1680,43 @@ void Renderer::ShutdownFrameDumping()
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  for (FrameDumpReadback& readback : m_frame_dump_readbacks)
+    readback.texture.reset();
+}
+
+void Renderer::UpdateFrameHashLog()
+{
+  if (g_ActiveConfig.bDumpFrameHashes == m_frame_hash_log.IsOpen())
+    return;
+
+  if (g_ActiveConfig.bDumpFrameHashes)
+  {
+    std::string path = g_ActiveConfig.sFrameHashPath;
+    if (path.empty())
+    {
+      path = fmt::format("{}{}_framehashes.txt", File::GetUserPath(D_DUMP_IDX),
+                         SConfig::GetInstance().GetGameID());
+    }
+
+    // Don't try again every frame if the log can't be created.
+    if (!m_frame_hash_log.Open(path))
+      Config::SetCurrent(Config::GFX_DUMP_FRAME_HASHES, false);
+    return;
+  }
+
+  // Let the dump thread hash the frames that are still queued before closing the log.
+  FlushFrameDump();
+  FinishFrameData();
+  m_frame_hash_log.Close();
+  if (!IsFrameDumping())
+    ShutdownFrameDumping();
 }
 
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
 {
-  m_frame_dump_data = FrameDump::FrameData{data, w, h, stride, m_last_frame_state};
+  const u32 index = m_frame_dump_queued.load(std::memory_order_relaxed);
+  m_frame_dump_readbacks[index % NUM_FRAME_DUMP_READBACKS].data =
+      FrameDump::FrameData{data, w, h, stride, m_last_frame_state};
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -1659,19 +1727,17 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
   }
 
   // Wake worker thread up.
+  m_frame_dump_queued.store(index + 1, std::memory_order_release);
   m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
 }
 
 void Renderer::FinishFrameData()
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  const u32 queued = m_frame_dump_queued.load(std::memory_order_relaxed);
+  while (m_frame_dump_processed.load(std::memory_order_acquire) != queued)
+    m_frame_dump_done.Wait();
 
-  m_frame_dump_output_texture->Unmap();
+  UnmapProcessedFrameDumps();
 }
 
 void Renderer::FrameDumpThreadFunc()
@@ -1697,46 +1763,56 @@ void Renderer::FrameDumpThreadFunc()
     if (!m_frame_dump_thread_running.IsSet())
       break;
 
-    auto frame = m_frame_dump_data;
-
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    // Process every frame queued since the last wakeup.
+    u32 index = m_frame_dump_processed.load(std::memory_order_relaxed);
+    while (index != m_frame_dump_queued.load(std::memory_order_acquire))
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+      const FrameDump::FrameData frame =
+          m_frame_dump_readbacks[index % NUM_FRAME_DUMP_READBACKS].data;
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
-
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
-    {
-      if (!frame_dump_started)
+      // Save screenshot
+      if (m_screenshot_request.TestAndClear())
       {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
+        std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        if (DumpFrameToPNG(frame, m_screenshot_name))
+          OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+
+        // Reset settings
+        m_screenshot_name.clear();
+        m_screenshot_completed.Set();
       }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+      m_frame_hash_log.AddFrame(frame.state.frame_number, frame.data, frame.width, frame.height,
+                                frame.stride);
+
+      if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
       {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
+        if (!frame_dump_started)
+        {
+          if (dump_to_ffmpeg)
+            frame_dump_started = StartFrameDumpToFFMPEG(frame);
+          else
+            frame_dump_started = StartFrameDumpToImage(frame);
+
+          // Stop frame dumping if we fail to start.
+          if (!frame_dump_started)
+            Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        }
+
+        // If we failed to start frame dumping, don't write a frame.
+        if (frame_dump_started)
+        {
+          if (dump_to_ffmpeg)
+            DumpFrameToFFMPEG(frame);
+          else
+            DumpFrameToImage(frame);
+        }
       }
-    }
 
-    m_frame_dump_done.Set();
+      m_frame_dump_processed.store(++index, std::memory_order_release);
+      m_frame_dump_done.Set();
+    }
   }
 
   if (frame_dump_started)
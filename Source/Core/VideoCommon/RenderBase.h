@@ -14,6 +14,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -29,6 +30,7 @@
 #include "VideoCommon/AsyncShaderCompiler.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FrameDump.h"
+#include "VideoCommon/FrameHashLog.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
 #include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/RenderState.h"
@@ -244,6 +246,8 @@ public:
   void StorePixelFormat(PixelFormat new_format) { m_prev_efb_format = new_format; }
   bool EFBHasAlphaChannel() const;
   VideoCommon::PostProcessing* GetPostProcessor() const { return m_post_processor.get(); }
+  int GetFrameCount() const { return m_frame_count; }
+  FrameHashLog& GetFrameHashLog() { return m_frame_hash_log; }
   // Final surface changing
   // This is called when the surface is resized (WX) or the window changes (Android).
   void ChangeSurface(void* new_surface_handle);
@@ -377,24 +381,34 @@ private:
   // Holds emulation state during the last swap when dumping.
   FrameDump::FrameState m_last_frame_state;
 
-  // Communication of frame between video and dump threads.
-  FrameDump::FrameData m_frame_dump_data;
-
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
+  // Ring of readback textures, so that rendering can get a few frames ahead of the frame dump
+  // thread before having to wait for it or drop frames. Frame n uses readback n % size.
+  struct FrameDumpReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    // Communication of the mapped frame between video and dump threads.
+    FrameDump::FrameData data;
+  };
+  static constexpr u32 NUM_FRAME_DUMP_READBACKS = 4;
+  std::array<FrameDumpReadback, NUM_FRAME_DUMP_READBACKS> m_frame_dump_readbacks;
+  // Number of frames queued for the dump thread, and the number it has finished with.
+  std::atomic<u32> m_frame_dump_queued = 0;
+  std::atomic<u32> m_frame_dump_processed = 0;
+  // Number of finished frames whose readback texture has been unmapped again.
+  u32 m_frame_dump_unmapped = 0;
+  // Set when the next readback texture holds a frame that needs to be dumped.
   bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
 
+  // Frame hashes are computed by the frame dump thread from the same readbacks as frame dumps.
+  FrameHashLog m_frame_hash_log;
+
   // Tracking of XFB textures so we don't render duplicate frames.
   u64 m_last_xfb_id = std::numeric_limits<u64>::max();
   u64 m_last_xfb_ticks = 0;
@@ -428,19 +442,30 @@ private:
 
   void ShutdownFrameDumping();
 
+  // Opens or closes the frame hash log when it is enabled or disabled.
+  void UpdateFrameHashLog();
+
   bool IsFrameDumping() const;
 
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
+  // Checks that the next frame dump readback texture exists and is the correct size.
   bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
 
+  // Makes sure the next frame dump readback texture isn't in use by the dump thread, by waiting
+  // for it or, if late frames are dropped, returning false.
+  bool WaitForFrameDumpReadback();
+
+  // Unmaps the readback textures of frames the dump thread has finished with.
+  void UnmapProcessedFrameDumps();
+
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks, int frame_number);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
+  // Asynchronously encodes the specified pointer of frame data to the frame dump. The data must
+  // be the mapped pointer of the next readback texture.
   void DumpFrameData(const u8* data, int w, int h, int stride);
 
   // Ensures all rendered frames are queued for encoding.
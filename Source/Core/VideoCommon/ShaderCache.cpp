@@ -3,6 +3,8 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <cstring>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -14,6 +16,7 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -67,6 +70,8 @@ void ShaderCache::InitializeShaderCache()
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
     WaitForAsyncCompiler();
+  else
+    UpdatePrecompileProgress();
 
   // Switch to the runtime shader compiler thread configuration.
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
@@ -93,12 +98,36 @@ void ShaderCache::Reload()
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
     WaitForAsyncCompiler();
+  else
+    UpdatePrecompileProgress();
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
 }
 
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+  UpdatePrecompileProgress();
+}
+
+void ShaderCache::UpdatePrecompileProgress()
+{
+  if (m_precompile_pipeline_count == 0)
+    return;
+
+  if (m_precompiled_pipeline_count < m_precompile_pipeline_count)
+  {
+    OSD::AddTypedMessage(OSD::MessageType::ShaderCompileProgress,
+                         fmt::format("Compiling shaders: {}/{}", m_precompiled_pipeline_count,
+                                     m_precompile_pipeline_count),
+                         OSD::Duration::SHORT, OSD::Color::CYAN);
+    return;
+  }
+
+  OSD::AddTypedMessage(OSD::MessageType::ShaderCompileProgress,
+                       fmt::format("Compiled {} shaders", m_precompile_pipeline_count),
+                       OSD::Duration::NORMAL, OSD::Color::GREEN);
+  m_precompile_pipeline_count = 0;
+  m_precompiled_pipeline_count = 0;
 }
 
 void ShaderCache::Shutdown()
@@ -194,6 +223,13 @@ void ShaderCache::WaitForAsyncCompiler()
     m_async_shader_compiler->RetrieveWorkItems();
   }
 
+  // Progress was already shown above.
+  if (m_precompiled_pipeline_count == m_precompile_pipeline_count)
+  {
+    m_precompile_pipeline_count = 0;
+    m_precompiled_pipeline_count = 0;
+  }
+
   // Just render nothing to clear the screen
   g_renderer->BeginUIFrame();
   g_renderer->EndUIFrame();
@@ -228,43 +264,46 @@ static void UnserializePipelineUid(const SerializedUidType& uid, UidType& real_u
 template <ShaderStage stage, typename K, typename T>
 void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid)
 {
-  class CacheReader : public LinearDiskCacheReader<K, u8>
-  {
-  public:
-    CacheReader(T& cache_) : cache(cache_) {}
-    void Read(const K& key, const u8* value, u32 value_size)
-    {
-      auto shader = g_renderer->CreateShaderFromBinary(stage, value, value_size);
-      if (shader)
-      {
-        auto& entry = cache.shader_map[key];
-        entry.shader = std::move(shader);
-        entry.pending = false;
+  // Only the index is read here. The shaders are created from their binaries when first used.
+  std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+  u32 count = cache.disk_cache.Open(filename);
+  INFO_LOG_FMT(VIDEO, "Indexed {} cached shaders from {}", count, filename);
+}
 
-        switch (stage)
-        {
-        case ShaderStage::Vertex:
-          INCSTAT(g_stats.num_vertex_shaders_created);
-          INCSTAT(g_stats.num_vertex_shaders_alive);
-          break;
-        case ShaderStage::Pixel:
-          INCSTAT(g_stats.num_pixel_shaders_created);
-          INCSTAT(g_stats.num_pixel_shaders_alive);
-          break;
-        default:
-          break;
-        }
-      }
-    }
+// Creates a shader from the binary stored in the disk cache, if there is one.
+template <typename Uid>
+static std::unique_ptr<AbstractShader>
+CreateShaderFromDiskCache(ShaderStage stage, const IndexedDiskCache<Uid, u8>& disk_cache,
+                          const Uid& uid)
+{
+  u32 binary_size;
+  const u8* binary = disk_cache.Lookup(uid, &binary_size);
+  if (!binary)
+    return nullptr;
 
-  private:
-    T& cache;
-  };
+  return g_renderer->CreateShaderFromBinary(stage, binary, binary_size);
+}
 
-  std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(cache);
-  u32 count = cache.disk_cache.OpenAndRead(filename, reader);
-  INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
+// Stores the shader's binary in the disk cache, unless the cache already holds the same binary.
+// A different binary replaces the stored one, as it is stale if the shader had to be recompiled.
+template <typename Uid>
+static void AppendShaderBinary(IndexedDiskCache<Uid, u8>& disk_cache, const Uid& uid,
+                               const AbstractShader& shader)
+{
+  const AbstractShader::BinaryData binary = shader.GetBinary();
+  if (binary.empty())
+    return;
+
+  u32 cached_size;
+  const u8* cached = disk_cache.Lookup(uid, &cached_size);
+  if (cached ? (cached_size == binary.size() &&
+                std::memcmp(cached, binary.data(), binary.size()) == 0) :
+               disk_cache.Contains(uid))
+  {
+    return;
+  }
+
+  disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
 }
 
 template <typename T>
@@ -384,6 +423,7 @@ void ShaderCache::LoadCaches()
 void ShaderCache::ClearCaches()
 {
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_gx_pipeline_uid_cache_order.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
@@ -417,21 +457,46 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  m_precompile_pipeline_count = 0;
+  m_precompiled_pipeline_count = 0;
+
+  // Work items with the same priority are compiled in the order they are queued, so queue the
+  // pipelines from the UID cache in the order the game first used them. This way, the pipelines
+  // needed at the start of the game are ready first when it isn't waiting for all of them.
+  for (const GXPipelineUid& uid : m_gx_pipeline_uid_cache_order)
+  {
+    auto it = m_gx_pipeline_cache.find(uid);
+    if (it != m_gx_pipeline_cache.end() && !it->second.first && !it->second.second)
+    {
+      QueuePipelineCompile(uid, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+      m_precompile_pipeline_count++;
+    }
+  }
+
+  // Queue all remaining uids with a null pipeline for compilation.
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
+    if (!it.second.first && !it.second.second)
+    {
       QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+      m_precompile_pipeline_count++;
+    }
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
-    if (!it.second.first)
+    if (!it.second.first && !it.second.second)
+    {
       QueueUberPipelineCompile(it.first, COMPILE_PRIORITY_UBERSHADER_PIPELINE);
+      m_precompile_pipeline_count++;
+    }
   }
 }
 
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Vertex, m_vs_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
@@ -440,6 +505,10 @@ std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexSha
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
+  if (auto shader =
+          CreateShaderFromDiskCache(ShaderStage::Vertex, m_uber_vs_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer(),
@@ -448,6 +517,9 @@ ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) con
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Pixel, m_ps_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
@@ -456,6 +528,10 @@ std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShade
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
+  if (auto shader =
+          CreateShaderFromDiskCache(ShaderStage::Pixel, m_uber_ps_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer(),
@@ -471,11 +547,7 @@ const AbstractShader* ShaderCache::InsertVertexShader(const VertexShaderUid& uid
   if (shader && !entry.shader)
   {
     if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_vs_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+      AppendShaderBinary(m_vs_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_vertex_shaders_created);
     INCSTAT(g_stats.num_vertex_shaders_alive);
     entry.shader = std::move(shader);
@@ -493,11 +565,7 @@ const AbstractShader* ShaderCache::InsertVertexUberShader(const UberShader::Vert
   if (shader && !entry.shader)
   {
     if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_uber_vs_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+      AppendShaderBinary(m_uber_vs_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_vertex_shaders_created);
     INCSTAT(g_stats.num_vertex_shaders_alive);
     entry.shader = std::move(shader);
@@ -515,11 +583,7 @@ const AbstractShader* ShaderCache::InsertPixelShader(const PixelShaderUid& uid,
   if (shader && !entry.shader)
   {
     if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_ps_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+      AppendShaderBinary(m_ps_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_pixel_shaders_created);
     INCSTAT(g_stats.num_pixel_shaders_alive);
     entry.shader = std::move(shader);
@@ -537,11 +601,7 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
   if (shader && !entry.shader)
   {
     if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_uber_ps_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+      AppendShaderBinary(m_uber_ps_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_pixel_shaders_created);
     INCSTAT(g_stats.num_pixel_shaders_alive);
     entry.shader = std::move(shader);
@@ -552,11 +612,16 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
 const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid& uid)
 {
-  const ShaderCode source_code =
-      GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
   std::unique_ptr<AbstractShader> shader =
-      g_renderer->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
-                                         fmt::format("Geometry shader: {}", *uid.GetUidData()));
+      CreateShaderFromDiskCache(ShaderStage::Geometry, m_gs_cache.disk_cache, uid);
+  if (!shader)
+  {
+    const ShaderCode source_code =
+        GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
+    shader =
+        g_renderer->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
+                                           fmt::format("Geometry shader: {}", *uid.GetUidData()));
+  }
 
   auto& entry = m_gs_cache.shader_map[uid];
   entry.pending = false;
@@ -564,11 +629,7 @@ const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid&
   if (shader && !entry.shader)
   {
     if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_gs_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+      AppendShaderBinary(m_gs_cache.disk_cache, uid, *shader);
     entry.shader = std::move(shader);
   }
 
@@ -973,6 +1034,7 @@ void ShaderCache::ClosePipelineUIDCache()
 {
   // This is left as a method in case we need to append extra data to the file in the future.
   m_gx_pipeline_uid_cache_file.Close();
+  m_gx_pipeline_uid_cache_order.clear();
 }
 
 void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
@@ -987,6 +1049,7 @@ void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
   // Flag it as empty with a null pipeline object, for later compilation.
   auto& entry = m_gx_pipeline_cache[real_uid];
   entry.second = false;
+  m_gx_pipeline_uid_cache_order.push_back(real_uid);
 }
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
@@ -1167,6 +1230,8 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       if (stages_ready)
       {
         shader_cache->InsertGXPipeline(uid, std::move(pipeline));
+        if (priority != COMPILE_PRIORITY_ONDEMAND_PIPELINE)
+          shader_cache->m_precompiled_pipeline_count++;
       }
       else
       {
@@ -1242,6 +1307,8 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
       if (stages_ready)
       {
         shader_cache->InsertGXUberPipeline(uid, std::move(UberPipeline));
+        if (priority != COMPILE_PRIORITY_ONDEMAND_PIPELINE)
+          shader_cache->m_precompiled_pipeline_count++;
       }
       else
       {
@@ -12,9 +12,11 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/IndexedDiskCache.h"
 #include "Common/LinearDiskCache.h"
 
 #include "VideoCommon/AbstractPipeline.h"
@@ -122,6 +124,7 @@ private:
   void LoadPipelineUIDCache();
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
+  void UpdatePrecompileProgress();
   void QueueUberShaderPipelines();
   bool CompileSharedPipelines();
 
@@ -215,7 +218,7 @@ private:
       bool pending = false;
     };
     std::map<Uid, Shader> shader_map;
-    LinearDiskCache<Uid, u8> disk_cache;
+    IndexedDiskCache<Uid, u8> disk_cache;
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -228,6 +231,13 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
+  // UIDs in the order they were read from the UID cache. As UIDs are appended to the cache when
+  // they are first used, this is the order the game needs them in, and precompiling follows it.
+  std::vector<GXPipelineUid> m_gx_pipeline_uid_cache_order;
+  // Progress of the pipelines queued by CompileMissingPipelines, shown on screen when the game is
+  // not waiting for them to finish.
+  size_t m_precompile_pipeline_count = 0;
+  size_t m_precompiled_pipeline_count = 0;
   LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
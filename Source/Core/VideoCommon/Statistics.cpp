@@ -8,6 +8,7 @@
 
 #include <imgui.h>
 
+#include "Common/Timer.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -25,6 +26,26 @@ void Statistics::ResetFrame()
   }
 }
 
+void ScopedStageTimer::Enter(GPUStage stage)
+{
+  const u64 now = Common::Timer::NowNs();
+  m_parent_stage = g_stats.current_stage;
+  if (m_parent_stage)
+    g_stats.stage_time_ns[*m_parent_stage] += now - g_stats.current_stage_start_ns;
+
+  g_stats.current_stage = stage;
+  g_stats.current_stage_start_ns = now;
+}
+
+void ScopedStageTimer::Leave()
+{
+  const u64 now = Common::Timer::NowNs();
+  g_stats.stage_time_ns[*g_stats.current_stage] += now - g_stats.current_stage_start_ns;
+
+  g_stats.current_stage = m_parent_stage;
+  g_stats.current_stage_start_ns = now;
+}
+
 void Statistics::SwapDL()
 {
   std::swap(this_frame.num_dl_prims, this_frame.num_prims);
@@ -75,6 +96,8 @@ void Statistics::Display() const
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
+  draw_statistic("Frame dump stalls/drops", "%d/%d", num_frame_dump_stalls,
+                 num_frame_dump_drops);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
@@ -87,12 +110,22 @@ void Statistics::Display() const
   draw_statistic("CP loads (DL)", "%d", this_frame.num_cp_loads_in_dl);
   draw_statistic("BP loads", "%d", this_frame.num_bp_loads);
   draw_statistic("BP loads (DL)", "%d", this_frame.num_bp_loads_in_dl);
+  draw_statistic("Redundant XF/CP/BP loads", "%d/%d/%d", this_frame.num_redundant_xf_loads,
+                 this_frame.num_redundant_cp_loads, this_frame.num_redundant_bp_loads);
+  draw_statistic("Flushes avoided", "%d", this_frame.num_flushes_avoided);
+  draw_statistic("XF memory loads batched", "%d", this_frame.num_batched_xf_memory_loads);
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("EFB copies to RAM:", "%d (%d readbacks avoided)",
+                 this_frame.num_efb_copies_to_ram, this_frame.num_efb_copy_readbacks_avoided);
+  draw_statistic("Textures decoded:", "%d (%d split)", this_frame.num_textures_decoded,
+                 this_frame.num_textures_decoded_split);
+  draw_statistic("Texture decode time:", "%d us", this_frame.texture_decode_time_us);
+  draw_statistic("Texture rehashes skipped:", "%d", this_frame.num_texture_rehashes_skipped);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
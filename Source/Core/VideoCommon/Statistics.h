@@ -4,10 +4,22 @@
 #pragma once
 
 #include <array>
+#include <optional>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+#include "Common/EnumMap.h"
 #include "VideoCommon/BPFunctions.h"
 
+// Stages of processing GPU commands, for measuring where the CPU time is spent.
+enum class GPUStage
+{
+  OpcodeDecoding,
+  VertexLoading,
+  TextureCache,
+  BackendSubmission,
+};
+
 struct Statistics
 {
   int num_pixel_shaders_created;
@@ -21,6 +33,10 @@ struct Statistics
 
   int num_vertex_loaders;
 
+  // Frames the frame dumper was too far behind for, which had to wait or were dropped.
+  int num_frame_dump_stalls;
+  int num_frame_dump_drops;
+
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
@@ -45,6 +61,15 @@ struct Statistics
     int num_cp_loads_in_dl;
     int num_xf_loads_in_dl;
 
+    // Loads that didn't change any register, and were dropped.
+    int num_redundant_bp_loads;
+    int num_redundant_cp_loads;
+    int num_redundant_xf_loads;
+    // Dropped loads that would otherwise have flushed buffered vertices.
+    int num_flushes_avoided;
+    // XF memory loads that didn't touch anything the buffered vertices use, so didn't flush them.
+    int num_batched_xf_memory_loads;
+
     int num_prims;
     int num_dl_prims;
     int num_shader_changes;
@@ -71,12 +96,27 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+    int num_efb_copies_to_ram;
+    int num_efb_copy_readbacks_avoided;
+
+    int num_textures_decoded;
+    int num_textures_decoded_split;
+    int texture_decode_time_us;
+    int num_texture_rehashes_skipped;
 
     int num_draw_done;
     int num_token;
     int num_token_int;
   };
   ThisFrame this_frame;
+
+  // CPU time spent in each stage, in nanoseconds. These are never reset, and are only measured
+  // while measure_stage_times is set, which must not be changed while the GPU is running.
+  bool measure_stage_times = false;
+  Common::EnumMap<u64, GPUStage::BackendSubmission> stage_time_ns{};
+  std::optional<GPUStage> current_stage;
+  u64 current_stage_start_ns = 0;
+
   void ResetFrame();
   void SwapDL();
   void AddScissorRect();
@@ -87,6 +127,33 @@ struct Statistics
 
 extern Statistics g_stats;
 
+// Adds the time spent in its scope to the stage's time. The enclosing stage's timer is paused
+// meanwhile, so each stage's time excludes the stages it calls into.
+class ScopedStageTimer
+{
+public:
+  explicit ScopedStageTimer(GPUStage stage) : m_active(g_stats.measure_stage_times)
+  {
+    if (m_active)
+      Enter(stage);
+  }
+  ~ScopedStageTimer()
+  {
+    if (m_active)
+      Leave();
+  }
+
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+  void Enter(GPUStage stage);
+  void Leave();
+
+  bool m_active;
+  std::optional<GPUStage> m_parent_stage;
+};
+
 #define STATISTICS
 
 #ifdef STATISTICS
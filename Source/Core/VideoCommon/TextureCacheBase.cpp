@@ -25,6 +25,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Timer.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -62,6 +63,16 @@ static int xfb_count = 0;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
+// Hashes texture memory. A sample count of zero hashes every byte, which uses the full-coverage
+// hash as it is both faster and better distributed than the sampling hash with sampling disabled.
+static u64 GetTextureMemoryHash(const u8* src, u32 len, u32 samples)
+{
+  if (samples == 0)
+    return Common::GetFullHash64(src, len);
+
+  return Common::GetHash64(src, len, samples);
+}
+
 TextureCacheBase::TCacheEntry::TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                                            std::unique_ptr<AbstractFramebuffer> fb)
     : texture(std::move(tex)), framebuffer(std::move(fb))
@@ -84,6 +95,30 @@ void TextureCacheBase::CheckTempSize(size_t required_size)
   temp = static_cast<u8*>(Common::AllocateAlignedMemory(temp_size, 16));
 }
 
+void TextureCacheBase::DecodeTextureOnCPU(u8* dst, const u8* src, u32 expanded_width,
+                                          u32 expanded_height, TextureFormat format,
+                                          const u8* palette, TLUTFormat palette_format)
+{
+  const u64 start_time = Common::Timer::NowUs();
+
+  // The format overlay is drawn over the whole texture, so it can't be split.
+  if (!backup_config.texfmt_overlay &&
+      m_decode_workers.ShouldSplit(expanded_width, expanded_height, format))
+  {
+    m_decode_workers.Decode(dst, src, expanded_width, expanded_height, format, palette,
+                            palette_format);
+    INCSTAT(g_stats.this_frame.num_textures_decoded_split);
+  }
+  else
+  {
+    TexDecoder_Decode(dst, src, expanded_width, expanded_height, format, palette, palette_format);
+  }
+
+  INCSTAT(g_stats.this_frame.num_textures_decoded);
+  ADDSTAT(g_stats.this_frame.texture_decode_time_us,
+          static_cast<int>(Common::Timer::NowUs() - start_time));
+}
+
 TextureCacheBase::TextureCacheBase()
 {
   SetBackupConfig(g_ActiveConfig);
@@ -94,6 +129,8 @@ TextureCacheBase::TextureCacheBase()
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
                                      backup_config.texfmt_overlay_center);
 
+  m_decode_workers.ResizeWorkerThreads(g_ActiveConfig.GetTextureDecoderThreads());
+
   HiresTexture::Init();
 
   TMEM::InvalidateAll();
@@ -151,7 +188,9 @@ void TextureCacheBase::ForceReload()
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bHiresTextureStreaming != backup_config.hires_texture_streaming ||
+      config.iHiresTextureMemoryBudget != backup_config.hires_texture_memory_budget)
   {
     HiresTexture::Update();
   }
@@ -174,6 +213,8 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  m_decode_workers.ResizeWorkerThreads(config.GetTextureDecoderThreads());
+
   SetBackupConfig(config);
 }
 
@@ -251,6 +292,11 @@ bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 r
   return true;
 }
 
+bool TextureCacheBase::TCacheEntry::CustomTextureFinishedStreaming() const
+{
+  return !pending_custom_tex.empty() && !HiresTexture::IsLoadPending(pending_custom_tex);
+}
+
 void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 {
   backup_config.color_samples = config.iSafeTextureCache_ColorSamples;
@@ -258,6 +304,8 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.hires_texture_streaming = config.bHiresTextureStreaming;
+  backup_config.hires_texture_memory_budget = config.iHiresTextureMemoryBudget;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
@@ -1224,8 +1272,44 @@ private:
   std::vector<Level> levels;
 };
 
+bool TextureCacheBase::IsBackingMemoryUnchanged(TCacheEntry* entry)
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  if (!memory.IsWriteTrackingEnabled())
+    return entry->base_hash == entry->CalculateHash();
+
+  const u32 range_size = entry->GetMemoryRangeSize();
+  if (entry->write_tracked_hash == entry->base_hash &&
+      !memory.WasRangeWritten(entry->addr, range_size, entry->write_generation))
+  {
+    INCSTAT(g_stats.this_frame.num_texture_rehashes_skipped);
+    return true;
+  }
+
+  // Start tracking before hashing, so that a write racing with the hash is not missed.
+  const std::optional<u64> write_generation = memory.TrackWrites(entry->addr, range_size);
+  if (entry->base_hash != entry->CalculateHash())
+  {
+    entry->write_tracked_hash.reset();
+    return false;
+  }
+
+  if (write_generation)
+  {
+    entry->write_tracked_hash = entry->base_hash;
+    entry->write_generation = *write_generation;
+  }
+  else
+  {
+    entry->write_tracked_hash.reset();
+  }
+  return true;
+}
+
 TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  ScopedStageTimer stage_timer(GPUStage::TextureCache);
+
   // if this stage was not invalidated by changes to texture registers, keep the current texture
   if (TMEM::IsValid(texture_info.GetStage()) && bound_textures[texture_info.GetStage()])
   {
@@ -1239,7 +1323,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture
 
     // Otherwise, hash the backing memory and check it's unchanged.
     // FIXME: this doesn't correctly handle textures from tmem.
-    if (!entry->tmem_only && entry->base_hash == entry->CalculateHash())
+    if (!entry->tmem_only && IsBackingMemoryUnchanged(entry))
     {
       return entry;
     }
@@ -1317,15 +1401,15 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  base_hash = GetTextureMemoryHash(texture_info.GetData(), texture_info.GetTextureSize(),
+                                  textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
     palette_size = *texture_info.GetPaletteSize();
-    full_hash =
-        base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
-                                      textureCacheSafetyColorSampleSize);
+    full_hash = base_hash ^ GetTextureMemoryHash(texture_info.GetTlutAddress(),
+                                                 *texture_info.GetPaletteSize(),
+                                                 textureCacheSafetyColorSampleSize);
   }
   else
   {
@@ -1453,6 +1537,12 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
+        if (entry->CustomTextureFinishedStreaming())
+        {
+          iter = InvalidateTexture(iter);
+          continue;
+        }
+
         entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
         entry->texture->FinishedRendering();
@@ -1519,7 +1609,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
           entry->native_width == texture_info.GetRawWidth() &&
-          entry->native_height == texture_info.GetRawHeight())
+          entry->native_height == texture_info.GetRawHeight() &&
+          !entry->CustomTextureFinishedStreaming())
       {
         entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
@@ -1538,9 +1629,10 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  std::string pending_custom_tex;
   if (g_ActiveConfig.bHiresTextures)
   {
-    hires_tex = HiresTexture::Search(texture_info);
+    hires_tex = HiresTexture::Search(texture_info, &pending_custom_tex);
 
     if (hires_tex)
     {
@@ -1623,9 +1715,9 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
       dst_buffer = temp;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        DecodeTextureOnCPU(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
+                           texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
+                           texture_info.GetTlutFormat());
       }
       else
       {
@@ -1656,6 +1748,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
                        texture_info.GetLevelCount());
   entry->SetHashes(base_hash, full_hash);
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->pending_custom_tex = std::move(pending_custom_tex);
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
@@ -1693,9 +1786,9 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        DecodeTextureOnCPU(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
+                           mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
+                           texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
 
@@ -2055,6 +2148,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     float gamma, bool clamp_top, bool clamp_bottom,
     const CopyFilterCoefficients::Values& filter_coefficients)
 {
+  ScopedStageTimer stage_timer(GPUStage::TextureCache);
+
   // Emulation methods:
   //
   // - EFB to RAM:
@@ -2295,29 +2390,44 @@ void TextureCacheBase::CopyRenderTargetToTexture(
                          AllCopyFilterCoefsNeeded(coefficients),
                          CopyFilterCanOverflow(coefficients), gamma != 1.0);
 
-    std::unique_ptr<AbstractStagingTexture> staging_texture = GetEFBCopyStagingTexture();
-    if (staging_texture)
+    // We can't defer if there is no VRAM copy (since we need to update the hash).
+    if (!copy_to_vram || !g_ActiveConfig.bDeferEFBCopies)
     {
-      CopyEFB(staging_texture.get(), format, tex_w, bytes_per_row, num_blocks_y, dstStride, srcRect,
-              scaleByHalf, linear_filter, y_scale, gamma, clamp_top, clamp_bottom, coefficients);
-
-      // We can't defer if there is no VRAM copy (since we need to update the hash).
-      if (!copy_to_vram || !g_ActiveConfig.bDeferEFBCopies)
+      std::unique_ptr<AbstractStagingTexture> staging_texture = GetEFBCopyStagingTexture();
+      if (staging_texture)
       {
+        CopyEFB(staging_texture.get(), 0, format, tex_w, bytes_per_row, num_blocks_y, dstStride,
+                srcRect, scaleByHalf, linear_filter, y_scale, gamma, clamp_top, clamp_bottom,
+                coefficients);
+
         // Immediately flush it.
-        WriteEFBCopyToRAM(dst, bytes_per_row / sizeof(u32), num_blocks_y, dstStride,
-                          std::move(staging_texture));
-      }
-      else
-      {
-        // Defer the flush until later.
-        entry->pending_efb_copy = std::move(staging_texture);
-        entry->pending_efb_copy_width = bytes_per_row / sizeof(u32);
-        entry->pending_efb_copy_height = num_blocks_y;
-        entry->pending_efb_copy_invalidated = false;
-        m_pending_efb_copies.push_back(entry);
+        WriteEFBCopyToRAM(dstAddr, dst, bytes_per_row / sizeof(u32), num_blocks_y, dstStride,
+                          staging_texture.get(), 0);
+        ReleaseEFBCopyStagingTexture(std::move(staging_texture));
       }
     }
+    else if (EFBCopyBatch* batch = GetEFBCopyBatch(num_blocks_y))
+    {
+      // Defer the flush until later, packing the copy below the previous pending copies. It is
+      // written at the next synchronization point rather than when the guest first reads it: the
+      // memory manager's write tracking only write-protects pages, so it can't catch reads. It
+      // isn't used to drop copies the CPU wrote over either, since a write to part of a page
+      // doesn't make the whole copy stale, and tracking is optional and needs fastmem.
+      entry->pending_efb_copy = batch;
+      entry->pending_efb_copy_row = batch->used_rows;
+      entry->pending_efb_copy_width = bytes_per_row / sizeof(u32);
+      entry->pending_efb_copy_height = num_blocks_y;
+      entry->pending_efb_copy_invalidated = false;
+      batch->used_rows += num_blocks_y;
+      batch->pending_copies++;
+      m_pending_efb_copies.push_back(entry);
+
+      CopyEFB(batch->texture.get(), entry->pending_efb_copy_row, format, tex_w, bytes_per_row,
+              num_blocks_y, dstStride, srcRect, scaleByHalf, linear_filter, y_scale, gamma,
+              clamp_top, clamp_bottom, coefficients);
+    }
+
+    INCSTAT(g_stats.this_frame.num_efb_copies_to_ram);
   }
   else
   {
@@ -2421,17 +2531,29 @@ void TextureCacheBase::FlushEFBCopies()
   if (m_pending_efb_copies.empty())
     return;
 
+  // Reading back the first copy of a batch waits for the GPU, after which the rest of its copies
+  // can be read without another synchronization.
+  ADDSTAT(g_stats.this_frame.num_efb_copy_readbacks_avoided,
+          static_cast<int>(m_pending_efb_copies.size() - m_efb_copy_batches.size()));
+
   for (TCacheEntry* entry : m_pending_efb_copies)
     FlushEFBCopy(entry);
   m_pending_efb_copies.clear();
 }
 
-void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
-                                         std::unique_ptr<AbstractStagingTexture> staging_texture)
+void TextureCacheBase::WriteEFBCopyToRAM(u32 dst_addr, u8* dst_ptr, u32 width, u32 height,
+                                         u32 stride, AbstractStagingTexture* staging_texture,
+                                         u32 staging_row)
 {
-  MathUtil::Rectangle<int> copy_rect(0, 0, static_cast<int>(width), static_cast<int>(height));
+  MathUtil::Rectangle<int> copy_rect(0, static_cast<int>(staging_row), static_cast<int>(width),
+                                     static_cast<int>(staging_row + height));
   staging_texture->ReadTexels(copy_rect, dst_ptr, stride);
-  ReleaseEFBCopyStagingTexture(std::move(staging_texture));
+
+  if (g_ActiveConfig.bDumpEFBCopyHashes)
+  {
+    g_renderer->GetFrameHashLog().AddEFBCopy(g_renderer->GetFrameCount(), dst_addr, dst_ptr,
+                                             width * 4, height, stride);
+  }
 }
 
 void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
@@ -2440,8 +2562,11 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
   u8* const dst = memory.GetPointer(entry->addr);
-  WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
-                    entry->memory_stride, std::move(entry->pending_efb_copy));
+  WriteEFBCopyToRAM(entry->addr, dst, entry->pending_efb_copy_width,
+                    entry->pending_efb_copy_height, entry->memory_stride,
+                    entry->pending_efb_copy->texture.get(), entry->pending_efb_copy_row);
+  ReleaseEFBCopyBatchCopy(entry->pending_efb_copy);
+  entry->pending_efb_copy = nullptr;
 
   // If the EFB copy was invalidated (e.g. the bloom case mentioned in InvalidateTexture), now is
   // the time to clean up the TCacheEntry. In which case, we don't need to compute the new hash of
@@ -2476,6 +2601,35 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   }
 }
 
+TextureCacheBase::EFBCopyBatch* TextureCacheBase::GetEFBCopyBatch(u32 num_rows)
+{
+  if (!m_efb_copy_batches.empty())
+  {
+    EFBCopyBatch* batch = m_efb_copy_batches.back().get();
+    if (batch->texture->GetHeight() - batch->used_rows >= num_rows)
+      return batch;
+  }
+
+  std::unique_ptr<AbstractStagingTexture> texture = GetEFBCopyStagingTexture();
+  if (!texture)
+    return nullptr;
+
+  auto batch = std::make_unique<EFBCopyBatch>();
+  batch->texture = std::move(texture);
+  return m_efb_copy_batches.emplace_back(std::move(batch)).get();
+}
+
+void TextureCacheBase::ReleaseEFBCopyBatchCopy(EFBCopyBatch* batch)
+{
+  if (--batch->pending_copies > 0)
+    return;
+
+  auto it = std::find_if(m_efb_copy_batches.begin(), m_efb_copy_batches.end(),
+                         [batch](const auto& ptr) { return ptr.get() == batch; });
+  ReleaseEFBCopyStagingTexture(std::move(batch->texture));
+  m_efb_copy_batches.erase(it);
+}
+
 std::unique_ptr<AbstractStagingTexture> TextureCacheBase::GetEFBCopyStagingTexture()
 {
   // Pull off the back first to re-use the most frequently used textures.
@@ -2700,7 +2854,9 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
       // existing pending copy, and not bother waiting for it in the future. This happens in
       // Xenoblade's sunset scene, where 35 copies are done per frame, and 25 of them are
       // copied to the same address, and can be skipped.
-      ReleaseEFBCopyStagingTexture(std::move(entry->pending_efb_copy));
+      INCSTAT(g_stats.this_frame.num_efb_copy_readbacks_avoided);
+      ReleaseEFBCopyBatchCopy(entry->pending_efb_copy);
+      entry->pending_efb_copy = nullptr;
       auto pending_it = std::find(m_pending_efb_copies.begin(), m_pending_efb_copies.end(), entry);
       if (pending_it != m_pending_efb_copies.end())
         m_pending_efb_copies.erase(pending_it);
@@ -2824,12 +2980,12 @@ void TextureCacheBase::CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_cop
   entry->texture->FinishedRendering();
 }
 
-void TextureCacheBase::CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams& params,
-                               u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
-                               u32 memory_stride, const MathUtil::Rectangle<int>& src_rect,
-                               bool scale_by_half, bool linear_filter, float y_scale, float gamma,
-                               bool clamp_top, bool clamp_bottom,
-                               const std::array<u32, 3>& filter_coefficients)
+void TextureCacheBase::CopyEFB(AbstractStagingTexture* dst, u32 dst_row,
+                               const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
+                               u32 num_blocks_y, u32 memory_stride,
+                               const MathUtil::Rectangle<int>& src_rect, bool scale_by_half,
+                               bool linear_filter, float y_scale, float gamma, bool clamp_top,
+                               bool clamp_bottom, const std::array<u32, 3>& filter_coefficients)
 {
   // Flush EFB pokes first, as they're expected to be included.
   g_framebuffer_manager->FlushEFBPokes();
@@ -2897,7 +3053,9 @@ void TextureCacheBase::CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams&
   g_renderer->SetSamplerState(0, linear_filter ? RenderState::GetLinearSamplerState() :
                                                  RenderState::GetPointSamplerState());
   g_renderer->Draw(0, 3);
-  dst->CopyFromTexture(m_efb_encoding_texture.get(), encode_rect, 0, 0, encode_rect);
+  const auto dst_rect = MathUtil::Rectangle<int>(0, static_cast<int>(dst_row), render_width,
+                                                 static_cast<int>(dst_row + render_height));
+  dst->CopyFromTexture(m_efb_encoding_texture.get(), encode_rect, 0, 0, dst_rect);
   g_renderer->EndUtilityDrawing();
 
   // Flush if there's sufficient draws between this copy and the last.
@@ -3035,6 +3193,14 @@ int TextureCacheBase::TCacheEntry::HashSampleSize() const
   return g_ActiveConfig.iSafeTextureCache_ColorSamples;
 }
 
+u32 TextureCacheBase::TCacheEntry::GetMemoryRangeSize() const
+{
+  if (memory_stride == BytesPerRow())
+    return size_in_bytes;
+
+  return memory_stride * (NumBlocksY() - 1) + BytesPerRow();
+}
+
 u64 TextureCacheBase::TCacheEntry::CalculateHash() const
 {
   const u32 bytes_per_row = BytesPerRow();
@@ -3046,7 +3212,7 @@ u64 TextureCacheBase::TCacheEntry::CalculateHash() const
   u8* ptr = memory.GetPointer(addr);
   if (memory_stride == bytes_per_row)
   {
-    return Common::GetHash64(ptr, size_in_bytes, hash_sample_size);
+    return GetTextureMemoryHash(ptr, size_in_bytes, hash_sample_size);
   }
   else
   {
@@ -3065,7 +3231,7 @@ u64 TextureCacheBase::TCacheEntry::CalculateHash() const
     {
       // Multiply by a prime number to mix the hash up a bit. This prevents identical blocks from
       // canceling each other out
-      temp_hash = (temp_hash * 397) ^ Common::GetHash64(ptr, bytes_per_row, samples_per_row);
+      temp_hash = (temp_hash * 397) ^ GetTextureMemoryHash(ptr, bytes_per_row, samples_per_row);
       ptr += memory_stride;
     }
     return temp_hash;
@@ -22,6 +22,7 @@
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
+#include "VideoCommon/TextureDecodeWorkers.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureInfo.h"
 
@@ -109,6 +110,15 @@ private:
   static const int FRAMECOUNT_INVALID = 0;
 
 public:
+  // Deferred EFB copies are packed into the rows of shared staging textures, so that all of the
+  // copies made between two flushes are read back with a single GPU synchronization.
+  struct EFBCopyBatch
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    u32 used_rows = 0;
+    u32 pending_copies = 0;
+  };
+
   struct TCacheEntry
   {
     // common members
@@ -133,6 +143,12 @@ public:
 
     bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
 
+    // base_hash and the newest write generation of the backing memory as of the last time it was
+    // hashed with write tracking enabled. While the hash matches base_hash and no page of the
+    // memory has a newer generation, hashing is skipped.
+    std::optional<u64> write_tracked_hash;
+    u64 write_generation = 0;
+
     // Texture dimensions from the GameCube's point of view
     u32 native_width = 0;
     u32 native_height = 0;
@@ -150,14 +166,19 @@ public:
     //   * partially updated textures which refer to this efb copy
     std::unordered_set<TCacheEntry*> references;
 
-    // Pending EFB copy
-    std::unique_ptr<AbstractStagingTexture> pending_efb_copy;
+    // Pending EFB copy, stored from pending_efb_copy_row in the batch's staging texture
+    EFBCopyBatch* pending_efb_copy = nullptr;
+    u32 pending_efb_copy_row = 0;
     u32 pending_efb_copy_width = 0;
     u32 pending_efb_copy_height = 0;
     bool pending_efb_copy_invalidated = false;
 
     std::string texture_info_name = "";
 
+    // Name of the custom texture for this entry, if it was still being streamed in when the entry
+    // was created.
+    std::string pending_custom_tex;
+
     explicit TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                          std::unique_ptr<AbstractFramebuffer> fb);
 
@@ -201,6 +222,10 @@ public:
 
     bool OverlapsMemoryRange(u32 range_address, u32 range_size) const;
 
+    // Returns true once the custom texture that was pending when this entry was created has
+    // finished streaming in, at which point the entry should be recreated to use it.
+    bool CustomTextureFinishedStreaming() const;
+
     bool IsEfbCopy() const { return is_efb_copy; }
     bool IsCopy() const { return is_xfb_copy || is_efb_copy; }
     u32 NumBlocksX() const;
@@ -208,6 +233,8 @@ public:
     u32 BytesPerRow() const;
 
     u64 CalculateHash() const;
+    // Size of the range of emulated memory that CalculateHash reads.
+    u32 GetMemoryRangeSize() const;
 
     int HashSampleSize() const;
     u32 GetWidth() const { return texture->GetConfig().width; }
@@ -282,8 +309,8 @@ protected:
                           u32 aligned_height, u32 row_stride, const u8* palette,
                           TLUTFormat palette_format);
 
-  virtual void CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native_width,
-                       u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+  virtual void CopyEFB(AbstractStagingTexture* dst, u32 dst_row, const EFBCopyParams& params,
+                       u32 native_width, u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
                        const MathUtil::Rectangle<int>& src_rect, bool scale_by_half,
                        bool linear_filter, float y_scale, float gamma, bool clamp_top,
                        bool clamp_bottom, const std::array<u32, 3>& filter_coefficients);
@@ -321,6 +348,14 @@ private:
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
   void CheckTempSize(size_t required_size);
 
+  // Decodes a texture level on the CPU, splitting it across the decode workers if it is large.
+  void DecodeTextureOnCPU(u8* dst, const u8* src, u32 expanded_width, u32 expanded_height,
+                          TextureFormat format, const u8* palette, TLUTFormat palette_format);
+
+  // Checks whether the memory backing a bound texture still matches its hash, skipping the hash
+  // when write tracking shows that the memory hasn't been written.
+  bool IsBackingMemoryUnchanged(TCacheEntry* entry);
+
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
@@ -345,10 +380,18 @@ private:
   GetVRAMCopyFilterCoefficients(const CopyFilterCoefficients::Values& coefficients);
 
   // Flushes a pending EFB copy to RAM from the host to the guest RAM.
-  void WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
-                         std::unique_ptr<AbstractStagingTexture> staging_texture);
+  void WriteEFBCopyToRAM(u32 dst_addr, u8* dst_ptr, u32 width, u32 height, u32 stride,
+                         AbstractStagingTexture* staging_texture, u32 staging_row);
   void FlushEFBCopy(TCacheEntry* entry);
 
+  // Returns a batch with room for a deferred EFB copy of num_rows rows, starting a new one if the
+  // current batch is full.
+  EFBCopyBatch* GetEFBCopyBatch(u32 num_rows);
+
+  // Called once a pending copy of the batch has been flushed or discarded. Returns the staging
+  // texture to the pool after the last one.
+  void ReleaseEFBCopyBatchCopy(EFBCopyBatch* batch);
+
   // Returns a staging texture of the maximum EFB copy size.
   std::unique_ptr<AbstractStagingTexture> GetEFBCopyStagingTexture();
 
@@ -372,6 +415,8 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool hires_texture_streaming;
+    int hires_texture_memory_budget;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
@@ -393,10 +438,16 @@ private:
   // Pool of readback textures used for deferred EFB copies.
   std::vector<std::unique_ptr<AbstractStagingTexture>> m_efb_copy_staging_texture_pool;
 
+  // Batches of deferred EFB copies, the last of which is filled by new copies.
+  std::vector<std::unique_ptr<EFBCopyBatch>> m_efb_copy_batches;
+
   // List of pending EFB copies. It is important that the order is preserved for these,
   // so that overlapping textures are written to guest RAM in the order they are issued.
   std::vector<TCacheEntry*> m_pending_efb_copies;
 
+  // Worker threads for splitting large software texture decodes.
+  VideoCommon::TextureDecodeWorkers m_decode_workers;
+
   // Staging texture used for readbacks.
   // We store this in the class so that the same staging texture can be used for multiple
   // readbacks, saving the overhead of allocating a new buffer every time.
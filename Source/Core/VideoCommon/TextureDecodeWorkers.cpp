@@ -0,0 +1,137 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/TextureDecodeWorkers.h"
+
+#include <algorithm>
+
+#include "Common/Assert.h"
+#include "Common/Thread.h"
+
+namespace VideoCommon
+{
+// Textures smaller than this (in texels) are decoded on the calling thread, as waking the
+// workers would cost more than it saves.
+constexpr u32 MIN_SPLIT_TEXELS = 256 * 256;
+
+// Number of slices queued per participating thread, so that a slow thread does not hold up
+// the whole decode.
+constexpr u32 SLICES_PER_THREAD = 2;
+
+TextureDecodeWorkers::~TextureDecodeWorkers()
+{
+  StopWorkerThreads();
+}
+
+void TextureDecodeWorkers::ResizeWorkerThreads(u32 num_worker_threads)
+{
+  if (m_worker_threads.size() == num_worker_threads)
+    return;
+
+  StopWorkerThreads();
+
+  for (u32 i = 0; i < num_worker_threads; i++)
+    m_worker_threads.emplace_back(&TextureDecodeWorkers::WorkerThreadRun, this);
+}
+
+bool TextureDecodeWorkers::HasWorkerThreads() const
+{
+  return !m_worker_threads.empty();
+}
+
+void TextureDecodeWorkers::StopWorkerThreads()
+{
+  if (!HasWorkerThreads())
+    return;
+
+  {
+    std::lock_guard guard(m_lock);
+    m_exit_flag.Set();
+    m_worker_wake.notify_all();
+  }
+
+  for (std::thread& thr : m_worker_threads)
+    thr.join();
+  m_worker_threads.clear();
+  m_exit_flag.Clear();
+}
+
+bool TextureDecodeWorkers::ShouldSplit(u32 expanded_width, u32 expanded_height,
+                                       TextureFormat format) const
+{
+  if (!HasWorkerThreads() || expanded_width * expanded_height < MIN_SPLIT_TEXELS)
+    return false;
+
+  return expanded_height / TexDecoder_GetBlockHeightInTexels(format) > 1;
+}
+
+void TextureDecodeWorkers::Decode(u8* dst, const u8* src, u32 width, u32 height,
+                                  TextureFormat format, const u8* tlut, TLUTFormat tlut_format)
+{
+  const u32 block_height = TexDecoder_GetBlockHeightInTexels(format);
+  const u32 num_block_rows = height / block_height;
+  ASSERT(height % block_height == 0);
+
+  const u32 num_threads = static_cast<u32>(m_worker_threads.size()) + 1;
+  const u32 num_slices = std::clamp(num_threads * SLICES_PER_THREAD, 1u, num_block_rows);
+  const u32 src_block_row_size = TexDecoder_GetTextureSizeInBytes(width, block_height, format);
+  const u32 dst_block_row_size = width * block_height * sizeof(u32);
+
+  std::unique_lock lock(m_lock);
+  m_job = {width, format, tlut, tlut_format};
+  m_slices.clear();
+
+  u32 block_row = 0;
+  for (u32 i = 0; i < num_slices; i++)
+  {
+    // Distribute the remainder over the first slices.
+    const u32 slice_block_rows =
+        num_block_rows / num_slices + (i < num_block_rows % num_slices ? 1 : 0);
+    m_slices.push_back({dst + block_row * dst_block_row_size,
+                        src + block_row * src_block_row_size, slice_block_rows * block_height});
+    block_row += slice_block_rows;
+  }
+
+  m_next_slice = 0;
+  m_slices_remaining = m_slices.size();
+  m_worker_wake.notify_all();
+
+  // Decode on this thread as well, rather than just waiting for the workers.
+  RunSlices(lock);
+  m_job_done.wait(lock, [this] { return m_slices_remaining == 0; });
+}
+
+void TextureDecodeWorkers::RunSlices(std::unique_lock<std::mutex>& lock)
+{
+  while (m_next_slice < m_slices.size())
+  {
+    const Slice slice = m_slices[m_next_slice++];
+    const Job job = m_job;
+    lock.unlock();
+
+    TexDecoder_Decode(slice.dst, slice.src, job.width, slice.height, job.format, job.tlut,
+                      job.tlut_format);
+
+    lock.lock();
+    if (--m_slices_remaining == 0)
+      m_job_done.notify_one();
+  }
+}
+
+void TextureDecodeWorkers::WorkerThreadRun()
+{
+  Common::SetCurrentThreadName("Texture decoder worker");
+
+  std::unique_lock lock(m_lock);
+  while (true)
+  {
+    m_worker_wake.wait(lock, [this] {
+      return m_exit_flag.IsSet() || m_next_slice < m_slices.size();
+    });
+    if (m_exit_flag.IsSet())
+      break;
+
+    RunSlices(lock);
+  }
+}
+}  // namespace VideoCommon
@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace VideoCommon
+{
+// Splits large software texture decodes into slices of whole block rows, and decodes the slices
+// in parallel on a set of worker threads. The calling thread decodes slices as well, and does not
+// return until the whole texture has been decoded, so the output is identical to a serial decode.
+class TextureDecodeWorkers
+{
+public:
+  TextureDecodeWorkers() = default;
+  ~TextureDecodeWorkers();
+
+  TextureDecodeWorkers(const TextureDecodeWorkers&) = delete;
+  TextureDecodeWorkers& operator=(const TextureDecodeWorkers&) = delete;
+
+  void ResizeWorkerThreads(u32 num_worker_threads);
+  bool HasWorkerThreads() const;
+  void StopWorkerThreads();
+
+  // Returns true if a texture with the given expanded dimensions is large enough to be worth
+  // splitting across the worker threads.
+  bool ShouldSplit(u32 expanded_width, u32 expanded_height, TextureFormat format) const;
+
+  // Same semantics as TexDecoder_Decode. width and height must be aligned to the block size.
+  // Textures should not be split while the texture format overlay is enabled, as the overlay
+  // would be drawn once per slice.
+  void Decode(u8* dst, const u8* src, u32 width, u32 height, TextureFormat format,
+              const u8* tlut, TLUTFormat tlut_format);
+
+private:
+  struct Job
+  {
+    u32 width;
+    TextureFormat format;
+    const u8* tlut;
+    TLUTFormat tlut_format;
+  };
+
+  struct Slice
+  {
+    u8* dst;
+    const u8* src;
+    u32 height;
+  };
+
+  void WorkerThreadRun();
+
+  // Decodes slices of the current job until none are left. m_lock must be held by the caller.
+  void RunSlices(std::unique_lock<std::mutex>& lock);
+
+  std::vector<std::thread> m_worker_threads;
+  Common::Flag m_exit_flag;
+
+  std::mutex m_lock;
+  std::condition_variable m_worker_wake;
+  std::condition_variable m_job_done;
+  Job m_job{};
+  std::vector<Slice> m_slices;
+  size_t m_next_slice = 0;
+  size_t m_slices_remaining = 0;
+};
+}  // namespace VideoCommon
@@ -350,6 +350,7 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
   {
     // Doing early return for the opposite case would be cleaner
     // but triggers a false unreachable code warning in MSVC debug builds.
+    ScopedStageTimer stage_timer(GPUStage::VertexLoading);
 
     CheckCPConfiguration(vtx_attr_group);
 
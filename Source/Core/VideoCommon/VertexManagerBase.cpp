@@ -3,8 +3,10 @@
 
 #include "VideoCommon/VertexManagerBase.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <iterator>
 #include <memory>
 
 #include "Common/ChunkFile.h"
@@ -19,6 +21,7 @@
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GeometryShaderManager.h"
@@ -165,6 +168,7 @@ DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive
     }
 
     m_is_flushed = false;
+    UpdateUsedXFMemory();
   }
 
   // Now that we've reset the buffer, there should be enough space. It's possible that we still
@@ -395,6 +399,7 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  ScopedStageTimer stage_timer(GPUStage::BackendSubmission);
   m_is_flushed = true;
 
   if (xfmem.numTexGen.numTexGens != bpmem.genMode.numtexgens ||
@@ -604,6 +609,88 @@ void VertexManagerBase::Flush()
   }
 }
 
+void VertexManagerBase::OnXFMemoryWrite(u32 address, u32 size)
+{
+  if (m_is_flushed)
+    return;
+
+  if (g_ActiveConfig.bBatchXFMemoryWrites && size != 0)
+  {
+    const u32 first_row = address / 4;
+    const u32 last_row = std::min((address + size - 1) / 4, NUM_XF_MEMORY_ROWS - 1);
+    bool used = false;
+    for (u32 row = first_row; row <= last_row && !used; row++)
+      used = m_used_xf_memory[row];
+
+    if (!used)
+    {
+      INCSTAT(g_stats.this_frame.num_batched_xf_memory_loads);
+      return;
+    }
+  }
+
+  Flush();
+}
+
+// Works out which matrices and lights the current batch will read from XF memory. None of the
+// state this depends on can change without flushing first, so this only needs to be done once per
+// batch.
+void VertexManagerBase::UpdateUsedXFMemory()
+{
+  static_assert(NUM_XF_MEMORY_ROWS * 4 == XFMEM_LIGHTS_END);
+
+  m_used_xf_memory.reset();
+  const auto mark_used = [this](u32 address, u32 size) {
+    for (u32 row = address / 4; row <= (address + size - 1) / 4; row++)
+      m_used_xf_memory.set(row);
+  };
+
+  const CPState& cp_state = g_main_cp_state;
+  const u32 num_tex_gens = xfmem.numTexGen.numTexGens;
+
+  // Vertices with their own matrix indices can use any of the position and normal matrices.
+  bool per_vertex_matrices = cp_state.vtx_desc.low.PosMatIdx;
+  for (const bool tex_matrix_index : cp_state.vtx_desc.low.TexMatIdx)
+    per_vertex_matrices |= tex_matrix_index;
+
+  if (per_vertex_matrices)
+  {
+    mark_used(XFMEM_POSMATRICES, XFMEM_POSMATRICES_END - XFMEM_POSMATRICES);
+    mark_used(XFMEM_NORMALMATRICES, XFMEM_NORMALMATRICES_END - XFMEM_NORMALMATRICES);
+  }
+  else
+  {
+    const u32 pos_normal_index = cp_state.matrix_index_a.PosNormalMtxIdx;
+    mark_used(XFMEM_POSMATRICES + pos_normal_index * 4, 12);
+    mark_used(XFMEM_NORMALMATRICES + (pos_normal_index & 31) * 3, 9);
+
+    const std::array<u32, 8> tex_matrix_indices = {
+        cp_state.matrix_index_a.Tex0MtxIdx, cp_state.matrix_index_a.Tex1MtxIdx,
+        cp_state.matrix_index_a.Tex2MtxIdx, cp_state.matrix_index_a.Tex3MtxIdx,
+        cp_state.matrix_index_b.Tex4MtxIdx, cp_state.matrix_index_b.Tex5MtxIdx,
+        cp_state.matrix_index_b.Tex6MtxIdx, cp_state.matrix_index_b.Tex7MtxIdx};
+    for (u32 i = 0; i < num_tex_gens && i < tex_matrix_indices.size(); i++)
+      mark_used(XFMEM_POSMATRICES + tex_matrix_indices[i] * 4, 12);
+  }
+
+  u32 light_mask = 0;
+  for (u32 i = 0; i < num_tex_gens && i < std::size(xfmem.texMtxInfo); i++)
+  {
+    if (xfmem.dualTexTrans.enabled)
+      mark_used(XFMEM_POSTMATRICES + xfmem.postMtxInfo[i].index * 4, 12);
+    if (xfmem.texMtxInfo[i].texgentype == TexGenType::EmbossMap)
+      light_mask |= 1u << xfmem.texMtxInfo[i].embosslightshift;
+  }
+  for (u32 chan = 0; chan < xfmem.numChan.numColorChans; chan++)
+    light_mask |= xfmem.color[chan].GetFullLightMask() | xfmem.alpha[chan].GetFullLightMask();
+
+  for (u32 light = 0; light < 8; light++)
+  {
+    if (light_mask & (1u << light))
+      mark_used(XFMEM_LIGHTS + light * 16, 16);
+  }
+}
+
 void VertexManagerBase::DoState(PointerWrap& p)
 {
   if (p.IsReadMode())
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <bitset>
 #include <memory>
 #include <vector>
 
@@ -105,6 +106,11 @@ public:
   void FlushData(u32 count, u32 stride);
 
   void Flush();
+  // Returns false if there are buffered vertices that the next Flush() would draw.
+  bool IsFlushed() const { return m_is_flushed; }
+  // Called before XF memory is written. Only flushes if the buffered vertices use the matrices or
+  // lights being written, as the constants are uploaded from XF memory when the batch is drawn.
+  void OnXFMemoryWrite(u32 address, u32 size);
 
   void DoState(PointerWrap& p);
 
@@ -208,8 +214,13 @@ private:
 
   void UpdatePipelineConfig();
   void UpdatePipelineObject();
+  void UpdateUsedXFMemory();
+
+  // XF memory is tracked in rows of four words, up to the end of the lights (XFMEM_LIGHTS_END).
+  static constexpr u32 NUM_XF_MEMORY_ROWS = 0x680 / 4;
 
   bool m_is_flushed = true;
+  std::bitset<NUM_XF_MEMORY_ROWS> m_used_xf_memory;
   FlushStatistics m_flush_statistics = {};
 
   // CPU access tracking
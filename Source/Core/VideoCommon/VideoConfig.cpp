@@ -70,6 +70,7 @@ void VideoConfig::Refresh()
   bShowGraphs = Config::Get(Config::GFX_SHOW_GRAPHS);
   bShowSpeed = Config::Get(Config::GFX_SHOW_SPEED);
   bShowSpeedColors = Config::Get(Config::GFX_SHOW_SPEED_COLORS);
+  bShowAudioLatency = Config::Get(Config::GFX_SHOW_AUDIO_LATENCY);
   iPerfSampleUSec = Config::Get(Config::GFX_PERF_SAMP_WINDOW) * 1000;
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
@@ -82,9 +83,15 @@ void VideoConfig::Refresh()
   bDumpBaseTextures = Config::Get(Config::GFX_DUMP_BASE_TEXTURES);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
+  bHiresTextureStreaming = Config::Get(Config::GFX_HIRES_TEXTURE_STREAMING);
+  iHiresTextureMemoryBudget = Config::Get(Config::GFX_HIRES_TEXTURE_MEMORY_BUDGET);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpXFBTarget = Config::Get(Config::GFX_DUMP_XFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
+  bDumpDropLateFrames = Config::Get(Config::GFX_DUMP_DROP_LATE_FRAMES);
+  bDumpFrameHashes = Config::Get(Config::GFX_DUMP_FRAME_HASHES);
+  bDumpEFBCopyHashes = Config::Get(Config::GFX_DUMP_EFB_COPY_HASHES);
+  sFrameHashPath = Config::Get(Config::GFX_FRAME_HASH_PATH);
   bUseFFV1 = Config::Get(Config::GFX_USE_FFV1);
   sDumpFormat = Config::Get(Config::GFX_DUMP_FORMAT);
   sDumpCodec = Config::Get(Config::GFX_DUMP_CODEC);
@@ -113,6 +120,7 @@ void VideoConfig::Refresh()
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iTextureDecoderThreads = Config::Get(Config::GFX_TEXTURE_DECODER_THREADS);
 
   texture_filtering_mode = Config::Get(Config::GFX_ENHANCE_FORCE_TEXTURE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -144,6 +152,7 @@ void VideoConfig::Refresh()
   bCopyEFBScaled = Config::Get(Config::GFX_HACK_COPY_EFB_SCALED);
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUNDING);
+  bBatchXFMemoryWrites = Config::Get(Config::GFX_HACK_BATCH_XF_MEMORY_WRITES);
   iEFBAccessTileSize = Config::Get(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE);
   iMissingColorValue = Config::Get(Config::GFX_HACK_MISSING_COLOR_VALUE);
   bFastTextureSampling = Config::Get(Config::GFX_HACK_FAST_TEXTURE_SAMPLING);
@@ -225,3 +234,13 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
   else
     return 1;
 }
+
+u32 VideoConfig::GetTextureDecoderThreads() const
+{
+  if (iTextureDecoderThreads >= 0)
+    return static_cast<u32>(iTextureDecoderThreads);
+
+  // Automatic number. Leave cores for the CPU and GPU threads, and don't bother splitting
+  // a single texture more than five ways.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 3, 0, 4));
+}
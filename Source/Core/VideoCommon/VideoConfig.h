@@ -95,6 +95,7 @@ struct VideoConfig final
   bool bShowGraphs = false;
   bool bShowSpeed = false;
   bool bShowSpeedColors = false;
+  bool bShowAudioLatency = false;
   int iPerfSampleUSec = 0;
   bool bShowNetPlayPing = false;
   bool bShowNetPlayMessages = false;
@@ -115,9 +116,15 @@ struct VideoConfig final
   bool bDumpBaseTextures = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  bool bHiresTextureStreaming = false;
+  int iHiresTextureMemoryBudget = 0;  // in MiB
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
+  bool bDumpDropLateFrames = false;
+  bool bDumpFrameHashes = false;
+  bool bDumpEFBCopyHashes = false;
+  std::string sFrameHashPath;
   bool bUseFFV1 = false;
   std::string sDumpCodec;
   std::string sDumpPixelFormat;
@@ -153,6 +160,7 @@ struct VideoConfig final
   bool bEnablePixelLighting = false;
   bool bFastDepthCalc = false;
   bool bVertexRounding = false;
+  bool bBatchXFMemoryWrites = false;
   int iEFBAccessTileSize = 0;
   int iSaveTargetId = 0;  // TODO: Should be dropped
   u32 iMissingColorValue = 0;
@@ -197,6 +205,11 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of worker threads used to split large software texture decodes.
+  // 0 decodes on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecoderThreads = 0;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -297,6 +310,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetTextureDecoderThreads() const;
 };
 
 extern VideoConfig g_Config;
@@ -16,6 +16,7 @@
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
@@ -24,10 +25,34 @@
 static void XFMemWritten(VertexShaderManager& vertex_shader_manager, u32 transferSize,
                          u32 baseAddress)
 {
-  g_vertex_manager->Flush();
+  g_vertex_manager->OnXFMemoryWrite(baseAddress, transferSize);
   vertex_shader_manager.InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Returns true if writing value to the register would change nothing. Games rewrite most of the
+// XF registers every draw, and many of them flush the vertex manager unconditionally.
+static bool IsRedundantXFRegWrite(u32 address, u32 value)
+{
+  // These also update the matrix indices in the CP state, which may differ from the XF ones.
+  if (address == XFMEM_SETMATRIXINDA || address == XFMEM_SETMATRIXINDB)
+    return false;
+
+  if (((u32*)&xfmem)[address] != value)
+    return false;
+
+  INCSTAT(g_stats.this_frame.num_redundant_xf_loads);
+
+  const bool always_flushes =
+      (address >= XFMEM_SETVIEWPORT && address < XFMEM_SETVIEWPORT + 6) ||
+      (address >= XFMEM_SETPROJECTION && address < XFMEM_SETPROJECTION + 7) ||
+      (address >= XFMEM_SETTEXMTXINFO && address < XFMEM_SETTEXMTXINFO + 8) ||
+      (address >= XFMEM_SETPOSTMTXINFO && address < XFMEM_SETPOSTMTXINFO + 8);
+  if (always_flushes && !g_vertex_manager->IsFlushed())
+    INCSTAT(g_stats.this_frame.num_flushes_avoided);
+
+  return true;
+}
+
 static void XFRegWritten(Core::System& system, VertexShaderManager& vertex_shader_manager,
                          u32 address, u32 value)
 {
@@ -232,12 +257,30 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(vertex_shader_manager, xf_mem_transfer_size, xf_mem_base);
+    const u32* const current_data = (u32*)&xfmem + xf_mem_base;
+    bool changed = false;
     for (u32 i = 0; i < xf_mem_transfer_size; i++)
     {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
+      if (current_data[i] != Common::swap32(data + i * 4))
+      {
+        changed = true;
+        break;
+      }
     }
+
+    if (changed)
+    {
+      XFMemWritten(vertex_shader_manager, xf_mem_transfer_size, xf_mem_base);
+      for (u32 i = 0; i < xf_mem_transfer_size; i++)
+        ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data + i * 4);
+    }
+    else
+    {
+      INCSTAT(g_stats.this_frame.num_redundant_xf_loads);
+      if (!g_vertex_manager->IsFlushed())
+        INCSTAT(g_stats.this_frame.num_flushes_avoided);
+    }
+    data += xf_mem_transfer_size * 4;
   }
 
   // write to XF regs
@@ -247,8 +290,11 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
     {
       const u32 value = Common::swap32(data);
 
-      XFRegWritten(system, vertex_shader_manager, address, value);
-      ((u32*)&xfmem)[address] = value;
+      if (!IsRedundantXFRegWrite(address, value))
+      {
+        XFRegWritten(system, vertex_shader_manager, address, value);
+        ((u32*)&xfmem)[address] = value;
+      }
 
       data += 4;
     }
@@ -0,0 +1,286 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/YUVConverter.h"
+
+#include <algorithm>
+
+#include "Common/Assert.h"
+#include "Common/Intrinsics.h"
+#include "Common/Thread.h"
+
+namespace VideoCommon
+{
+namespace
+{
+// Frames smaller than this (in pixels) are converted on the calling thread, as waking the
+// workers would cost more than it saves.
+constexpr u32 MIN_SPLIT_PIXELS = 320 * 240;
+
+// Number of bands queued per participating thread, so that a slow thread does not hold up
+// the whole frame.
+constexpr u32 BANDS_PER_THREAD = 2;
+
+u8 RGBToY(int r, int g, int b)
+{
+  return static_cast<u8>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+u8 RGBToU(int r, int g, int b)
+{
+  return static_cast<u8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+u8 RGBToV(int r, int g, int b)
+{
+  return static_cast<u8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+void ConvertLumaRow(const u8* src, u32 first_x, u32 width, u8* dst)
+{
+  for (u32 x = first_x; x < width; x++)
+  {
+    const u8* pixel = src + x * 4;
+    dst[x] = RGBToY(pixel[0], pixel[1], pixel[2]);
+  }
+}
+
+void ConvertChromaRow(const u8* row0, const u8* row1, u32 first_cx, u32 width, u8* u_dst,
+                      u8* v_dst)
+{
+  for (u32 cx = first_cx; cx < (width + 1) / 2; cx++)
+  {
+    const u32 x0 = cx * 2 * 4;
+    const u32 x1 = std::min(cx * 2 + 1, width - 1) * 4;
+
+    int average[3];
+    for (u32 c = 0; c < 3; c++)
+      average[c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2;
+
+    u_dst[cx] = RGBToU(average[0], average[1], average[2]);
+    v_dst[cx] = RGBToV(average[0], average[1], average[2]);
+  }
+}
+
+#ifdef _M_X86_64
+// Returns {a0 + a1, a2 + a3, b0 + b1, b2 + b3}.
+__m128i AddAdjacentPairs(__m128i a, __m128i b)
+{
+  const __m128 fa = _mm_castsi128_ps(a);
+  const __m128 fb = _mm_castsi128_ps(b);
+  return _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(2, 0, 2, 0))),
+                       _mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(3, 1, 3, 1))));
+}
+
+// Applies coeffs to four pixels with 16-bit components, two in lo and two in hi, and returns the
+// four 32-bit sums.
+__m128i WeightedSum(__m128i lo, __m128i hi, __m128i coeffs)
+{
+  return AddAdjacentPairs(_mm_madd_epi16(lo, coeffs), _mm_madd_epi16(hi, coeffs));
+}
+
+// Returns the number of pixels converted, which is a multiple of 16.
+u32 ConvertLumaRowSSE2(const u8* src, u32 width, u8* dst)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i coeffs = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+  const __m128i round = _mm_set1_epi32(128);
+  const __m128i offset = _mm_set1_epi16(16);
+
+  u32 x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m128i luma[4];
+    for (u32 i = 0; i < 4; i++)
+    {
+      const __m128i pixels =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (x + i * 4) * 4));
+      const __m128i sum = WeightedSum(_mm_unpacklo_epi8(pixels, zero),
+                                      _mm_unpackhi_epi8(pixels, zero), coeffs);
+      luma[i] = _mm_srai_epi32(_mm_add_epi32(sum, round), 8);
+    }
+
+    const __m128i lo = _mm_add_epi16(_mm_packs_epi32(luma[0], luma[1]), offset);
+    const __m128i hi = _mm_add_epi16(_mm_packs_epi32(luma[2], luma[3]), offset);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(lo, hi));
+  }
+  return x;
+}
+
+// Returns the number of chroma samples converted, which is a multiple of 8.
+u32 ConvertChromaRowSSE2(const u8* row0, const u8* row1, u32 width, u8* u_dst, u8* v_dst)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i two = _mm_set1_epi16(2);
+  const __m128i u_coeffs = _mm_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0);
+  const __m128i v_coeffs = _mm_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0);
+  const __m128i round = _mm_set1_epi32(128);
+  const __m128i offset = _mm_set1_epi16(128);
+
+  u32 cx = 0;
+  for (; (cx + 8) * 2 <= width; cx += 8)
+  {
+    __m128i u[2];
+    __m128i v[2];
+    for (u32 i = 0; i < 2; i++)
+    {
+      // Each iteration averages two 2x2 blocks.
+      __m128i averages[2];
+      for (u32 j = 0; j < 2; j++)
+      {
+        const u32 offset_bytes = (cx * 2 + (i * 2 + j) * 4) * 4;
+        const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + offset_bytes));
+        const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + offset_bytes));
+        const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(p0, zero), _mm_unpacklo_epi8(p1, zero));
+        const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(p0, zero), _mm_unpackhi_epi8(p1, zero));
+        const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+        averages[j] = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+      }
+
+      u[i] = _mm_srai_epi32(
+          _mm_add_epi32(WeightedSum(averages[0], averages[1], u_coeffs), round), 8);
+      v[i] = _mm_srai_epi32(
+          _mm_add_epi32(WeightedSum(averages[0], averages[1], v_coeffs), round), 8);
+    }
+
+    const __m128i u16 = _mm_add_epi16(_mm_packs_epi32(u[0], u[1]), offset);
+    const __m128i v16 = _mm_add_epi16(_mm_packs_epi32(v[0], v[1]), offset);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(u_dst + cx), _mm_packus_epi16(u16, u16));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(v_dst + cx), _mm_packus_epi16(v16, v16));
+  }
+  return cx;
+}
+#endif
+}  // namespace
+
+void ConvertRGBAToYUV420Rows(const u8* src, u32 src_stride, u32 width, u32 height, u32 first_row,
+                             u32 end_row, const YUV420Planes& dst)
+{
+  DEBUG_ASSERT(first_row % 2 == 0);
+
+  for (u32 y = first_row; y < end_row; y++)
+  {
+    const u8* row = src + y * src_stride;
+    u8* const y_dst = dst.y + y * dst.y_stride;
+    u32 x = 0;
+#ifdef _M_X86_64
+    x = ConvertLumaRowSSE2(row, width, y_dst);
+#endif
+    ConvertLumaRow(row, x, width, y_dst);
+
+    if (y % 2 != 0)
+      continue;
+
+    const u8* next_row = src + std::min(y + 1, height - 1) * src_stride;
+    u8* const u_dst = dst.u + y / 2 * dst.u_stride;
+    u8* const v_dst = dst.v + y / 2 * dst.v_stride;
+    u32 cx = 0;
+#ifdef _M_X86_64
+    cx = ConvertChromaRowSSE2(row, next_row, width, u_dst, v_dst);
+#endif
+    ConvertChromaRow(row, next_row, cx, width, u_dst, v_dst);
+  }
+}
+
+YUVConverter::~YUVConverter()
+{
+  StopWorkerThreads();
+}
+
+void YUVConverter::ResizeWorkerThreads(u32 num_worker_threads)
+{
+  if (m_worker_threads.size() == num_worker_threads)
+    return;
+
+  StopWorkerThreads();
+
+  for (u32 i = 0; i < num_worker_threads; i++)
+    m_worker_threads.emplace_back(&YUVConverter::WorkerThreadRun, this);
+}
+
+void YUVConverter::StopWorkerThreads()
+{
+  if (m_worker_threads.empty())
+    return;
+
+  {
+    std::lock_guard guard(m_lock);
+    m_exit_flag.Set();
+    m_worker_wake.notify_all();
+  }
+
+  for (std::thread& thr : m_worker_threads)
+    thr.join();
+  m_worker_threads.clear();
+  m_exit_flag.Clear();
+}
+
+void YUVConverter::ConvertRGBAToYUV420(const u8* src, u32 src_stride, u32 width, u32 height,
+                                       const YUV420Planes& dst)
+{
+  const u32 num_row_pairs = (height + 1) / 2;
+  if (m_worker_threads.empty() || width * height < MIN_SPLIT_PIXELS || num_row_pairs < 2)
+  {
+    ConvertRGBAToYUV420Rows(src, src_stride, width, height, 0, height, dst);
+    return;
+  }
+
+  const u32 num_threads = static_cast<u32>(m_worker_threads.size()) + 1;
+  const u32 num_bands = std::min(num_threads * BANDS_PER_THREAD, num_row_pairs);
+
+  std::unique_lock lock(m_lock);
+  m_job = {src, src_stride, width, height, dst};
+  m_bands.clear();
+
+  // Bands start on even rows, so that each chroma row is written by a single band.
+  u32 row_pair = 0;
+  for (u32 i = 0; i < num_bands; i++)
+  {
+    const u32 band_row_pairs = num_row_pairs / num_bands + (i < num_row_pairs % num_bands ? 1 : 0);
+    m_bands.push_back({row_pair * 2, std::min((row_pair + band_row_pairs) * 2, height)});
+    row_pair += band_row_pairs;
+  }
+
+  m_next_band = 0;
+  m_bands_remaining = m_bands.size();
+  m_worker_wake.notify_all();
+
+  // Convert on this thread as well, rather than just waiting for the workers.
+  RunBands(lock);
+  m_job_done.wait(lock, [this] { return m_bands_remaining == 0; });
+}
+
+void YUVConverter::RunBands(std::unique_lock<std::mutex>& lock)
+{
+  while (m_next_band < m_bands.size())
+  {
+    const Band band = m_bands[m_next_band++];
+    const Job job = m_job;
+    lock.unlock();
+
+    ConvertRGBAToYUV420Rows(job.src, job.src_stride, job.width, job.height, band.first_row,
+                            band.end_row, job.dst);
+
+    lock.lock();
+    if (--m_bands_remaining == 0)
+      m_job_done.notify_one();
+  }
+}
+
+void YUVConverter::WorkerThreadRun()
+{
+  Common::SetCurrentThreadName("Frame dump conversion worker");
+
+  std::unique_lock lock(m_lock);
+  while (true)
+  {
+    m_worker_wake.wait(lock, [this] {
+      return m_exit_flag.IsSet() || m_next_band < m_bands.size();
+    });
+    if (m_exit_flag.IsSet())
+      break;
+
+    RunBands(lock);
+  }
+}
+}  // namespace VideoCommon
@@ -0,0 +1,83 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+
+namespace VideoCommon
+{
+struct YUV420Planes
+{
+  u8* y;
+  u8* u;
+  u8* v;
+  u32 y_stride;
+  u32 u_stride;
+  u32 v_stride;
+};
+
+// Converts rows [first_row, end_row) of an RGBA8 image to planar YUV 4:2:0, using BT.601 limited
+// range coefficients. Each chroma sample is the average of a 2x2 block of pixels, so first_row must
+// be even. Pixels past the right and bottom edges of the image repeat the last column and row.
+// The SIMD and generic paths produce identical output.
+void ConvertRGBAToYUV420Rows(const u8* src, u32 src_stride, u32 width, u32 height, u32 first_row,
+                             u32 end_row, const YUV420Planes& dst);
+
+// Converts frames for the frame dumper. Large frames are split into bands of rows, which are
+// converted in parallel on a set of worker threads and the calling thread.
+class YUVConverter
+{
+public:
+  YUVConverter() = default;
+  ~YUVConverter();
+
+  YUVConverter(const YUVConverter&) = delete;
+  YUVConverter& operator=(const YUVConverter&) = delete;
+
+  void ResizeWorkerThreads(u32 num_worker_threads);
+  void StopWorkerThreads();
+
+  // Returns once the whole frame has been converted.
+  void ConvertRGBAToYUV420(const u8* src, u32 src_stride, u32 width, u32 height,
+                           const YUV420Planes& dst);
+
+private:
+  struct Band
+  {
+    u32 first_row;
+    u32 end_row;
+  };
+
+  struct Job
+  {
+    const u8* src;
+    u32 src_stride;
+    u32 width;
+    u32 height;
+    YUV420Planes dst;
+  };
+
+  void WorkerThreadRun();
+
+  // Converts bands of the current job until none are left. m_lock must be held by the caller.
+  void RunBands(std::unique_lock<std::mutex>& lock);
+
+  std::vector<std::thread> m_worker_threads;
+  Common::Flag m_exit_flag;
+
+  std::mutex m_lock;
+  std::condition_variable m_worker_wake;
+  std::condition_variable m_job_done;
+  Job m_job{};
+  std::vector<Band> m_bands;
+  size_t m_next_band = 0;
+  size_t m_bands_remaining = 0;
+};
+}  // namespace VideoCommon
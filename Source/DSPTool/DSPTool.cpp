@@ -52,6 +52,10 @@ void DSP::Host::InterruptRequest()
 void DSP::Host::UpdateDebugger()
 {
 }
+std::string DSP::Host::GetBlockCachePath(u32 iram_crc)
+{
+  return {};
+}
 
 static std::string CodeToHeader(const std::vector<u16>& code, const std::string& filename)
 {
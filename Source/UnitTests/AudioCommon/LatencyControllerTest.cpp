@@ -0,0 +1,99 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/LatencyController.h"
+#include "Common/CommonTypes.h"
+
+using AudioCommon::LatencyController;
+
+namespace
+{
+constexpr unsigned int SAMPLE_RATE = 48000;
+constexpr float MAX_LATENCY_MS = 40.0f;
+// 5 ms per callback.
+constexpr unsigned int CALLBACK_SAMPLES = 240;
+constexpr u64 CALLBACK_US = 5000;
+
+class LatencyControllerTest : public testing::Test
+{
+protected:
+  // Runs callbacks for the given time, with the buffer holding what the controller asks for.
+  void Run(u64 duration_us, u64 jitter_us = 0)
+  {
+    std::uniform_int_distribution<u64> jitter(0, jitter_us);
+    for (const u64 end = m_now_us + duration_us; m_now_us < end;)
+    {
+      const u64 interval_us = CALLBACK_US - jitter_us / 2 + jitter(m_random);
+      m_now_us += interval_us;
+      const float target_ms = m_controller.GetTargetLatency();
+      m_controller.Update(m_now_us, CALLBACK_SAMPLES,
+                          static_cast<unsigned int>(target_ms * SAMPLE_RATE / 1000), false);
+    }
+  }
+
+  void Underrun()
+  {
+    m_now_us += CALLBACK_US;
+    m_controller.Update(m_now_us, CALLBACK_SAMPLES, CALLBACK_SAMPLES / 2, true);
+  }
+
+  std::mt19937 m_random{0x4C41544E};
+  u64 m_now_us = 0;
+  LatencyController m_controller{SAMPLE_RATE, MAX_LATENCY_MS};
+};
+}  // namespace
+
+TEST_F(LatencyControllerTest, StartsAtMaximum)
+{
+  EXPECT_EQ(m_controller.GetTargetLatency(), MAX_LATENCY_MS);
+  EXPECT_EQ(m_controller.GetUnderrunCount(), 0u);
+}
+
+TEST_F(LatencyControllerTest, ShrinksWhenSteady)
+{
+  Run(30000000);
+
+  // One callback period, and a little headroom that isn't worth removing.
+  EXPECT_GE(m_controller.GetTargetLatency(), 5.0f);
+  EXPECT_LE(m_controller.GetTargetLatency(), 7.0f);
+  EXPECT_NEAR(m_controller.GetLatency(), m_controller.GetTargetLatency() + 5.0f, 0.5f);
+}
+
+TEST_F(LatencyControllerTest, KeepsMarginForJitter)
+{
+  Run(30000000, 4000);
+
+  // The mean deviation of a uniform jitter of 4 ms is 1 ms.
+  EXPECT_GE(m_controller.GetTargetLatency(), 8.0f);
+  EXPECT_LE(m_controller.GetTargetLatency(), MAX_LATENCY_MS);
+}
+
+TEST_F(LatencyControllerTest, GrowsOnUnderrun)
+{
+  Run(30000000);
+  const float steady_target = m_controller.GetTargetLatency();
+
+  Underrun();
+  EXPECT_GT(m_controller.GetTargetLatency(), steady_target * 1.4f);
+  EXPECT_EQ(m_controller.GetUnderrunCount(), 1u);
+
+  for (int i = 0; i < 10; i++)
+    Underrun();
+  EXPECT_EQ(m_controller.GetTargetLatency(), MAX_LATENCY_MS);
+  EXPECT_EQ(m_controller.GetUnderrunCount(), 11u);
+}
+
+TEST_F(LatencyControllerTest, FollowsMaximum)
+{
+  m_controller.SetMaxLatency(20.0f);
+  EXPECT_EQ(m_controller.GetTargetLatency(), 20.0f);
+
+  // The maximum wins over the margin needed for jitter.
+  m_controller.SetMaxLatency(LatencyController::MIN_LATENCY_MS);
+  Run(1000000, 4000);
+  EXPECT_EQ(m_controller.GetTargetLatency(), LatencyController::MIN_LATENCY_MS);
+}
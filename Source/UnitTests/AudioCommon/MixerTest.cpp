@@ -0,0 +1,353 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/NullSoundStream.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+constexpr u32 MAX_SAMPLES = 1024 * 4;
+constexpr u32 INDEX_MASK = MAX_SAMPLES * 2 - 1;
+
+// The mixer fifo as it was before it was vectorized: each fifo is resampled one sample at a time
+// and added to the output, which is clamped after every fifo.
+class ReferenceFifo
+{
+public:
+  ReferenceFifo(u32 sample_rate, u32 sample_rate_divisor, bool little_endian)
+      : m_sample_rate(sample_rate), m_input_sample_rate_divisor(sample_rate_divisor),
+        m_little_endian(little_endian)
+  {
+  }
+
+  void PushSamples(const short* samples, u32 num_samples)
+  {
+    if (num_samples * 2 + ((m_indexW - m_indexR) & INDEX_MASK) >= MAX_SAMPLES * 2)
+      return;
+    for (u32 i = 0; i < num_samples * 2; i++)
+      m_buffer[(m_indexW + i) & INDEX_MASK] = samples[i];
+    m_indexW += num_samples * 2;
+  }
+
+  void SetVolume(u32 lvolume, u32 rvolume)
+  {
+    m_LVolume = lvolume + (lvolume >> 7);
+    m_RVolume = rvolume + (rvolume >> 7);
+  }
+
+  void Mix(short* samples, u32 numSamples, int timing_variance)
+  {
+    constexpr u64 FIXED_SAMPLE_RATE_DIVIDEND = Mixer::FIXED_SAMPLE_RATE_DIVIDEND;
+    u32 currentSample = 0;
+    u32 indexR = m_indexR;
+    u32 indexW = m_indexW;
+
+    float aid_sample_rate =
+        FIXED_SAMPLE_RATE_DIVIDEND / static_cast<float>(m_input_sample_rate_divisor);
+    float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
+    u32 low_watermark = (FIXED_SAMPLE_RATE_DIVIDEND * timing_variance) /
+                        (static_cast<u64>(m_input_sample_rate_divisor) * 1000);
+    low_watermark = std::min(low_watermark, MAX_SAMPLES / 2);
+    m_numLeftI = (numLeft + m_numLeftI * (32 - 1)) / 32;
+    const float offset = std::clamp((m_numLeftI - low_watermark) * 0.2f, -200.0f, 200.0f);
+    aid_sample_rate = aid_sample_rate + offset;
+    const u32 ratio = (u32)(65536.0f * aid_sample_rate / (float)m_sample_rate);
+
+    const auto read_buffer = [this](u32 index) {
+      return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
+    };
+
+    for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2;
+         currentSample += 2)
+    {
+      u32 indexR2 = indexR + 2;
+
+      s16 l1 = read_buffer(indexR & INDEX_MASK);
+      s16 l2 = read_buffer(indexR2 & INDEX_MASK);
+      int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+      sampleL = (sampleL * m_LVolume) >> 8;
+      sampleL += samples[currentSample + 1];
+      samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
+
+      s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);
+      s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);
+      int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+      sampleR = (sampleR * m_RVolume) >> 8;
+      sampleR += samples[currentSample];
+      samples[currentSample] = std::clamp(sampleR, -32767, 32767);
+
+      m_frac += ratio;
+      indexR += 2 * (u16)(m_frac >> 16);
+      m_frac &= 0xffff;
+    }
+
+    short s[2];
+    s[0] = read_buffer((indexR - 1) & INDEX_MASK);
+    s[1] = read_buffer((indexR - 2) & INDEX_MASK);
+    s[0] = (s[0] * m_RVolume) >> 8;
+    s[1] = (s[1] * m_LVolume) >> 8;
+    for (; currentSample < numSamples * 2; currentSample += 2)
+    {
+      samples[currentSample + 0] = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
+      samples[currentSample + 1] = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
+    }
+
+    m_indexR = indexR;
+  }
+
+private:
+  u32 m_sample_rate;
+  u32 m_input_sample_rate_divisor;
+  bool m_little_endian;
+  std::array<short, MAX_SAMPLES * 2> m_buffer{};
+  u32 m_indexW = 0;
+  u32 m_indexR = 0;
+  s32 m_LVolume = 256;
+  s32 m_RVolume = 256;
+  float m_numLeftI = 0.0f;
+  u32 m_frac = 0;
+};
+
+constexpr u32 SAMPLE_RATE = 48000;
+constexpr int TIMING_VARIANCE = 40;
+
+class MixerTest : public testing::Test
+{
+protected:
+  // Big endian stereo samples, quiet enough that mixing two of them never clips.
+  std::vector<short> RandomSamples(u32 num_samples, int amplitude = 16000)
+  {
+    std::uniform_int_distribution<int> distribution(-amplitude, amplitude);
+    std::vector<short> samples(num_samples * 2);
+    for (short& sample : samples)
+      sample = Common::swap16(static_cast<u16>(distribution(m_random)));
+    return samples;
+  }
+
+  void PushDMA(u32 num_samples, int amplitude = 16000)
+  {
+    const std::vector<short> samples = RandomSamples(num_samples, amplitude);
+    m_mixer.PushSamples(samples.data(), num_samples);
+    m_dma.PushSamples(samples.data(), num_samples);
+  }
+
+  void PushStreaming(u32 num_samples, int amplitude = 16000)
+  {
+    const std::vector<short> samples = RandomSamples(num_samples, amplitude);
+    m_mixer.PushStreamingSamples(samples.data(), num_samples);
+    m_streaming.PushSamples(samples.data(), num_samples);
+  }
+
+  void ExpectSameMix(u32 num_samples)
+  {
+    std::vector<short> samples(num_samples * 2);
+    std::vector<short> expected(num_samples * 2);
+    m_mixer.Mix(samples.data(), num_samples);
+    m_dma.Mix(expected.data(), num_samples, TIMING_VARIANCE);
+    m_streaming.Mix(expected.data(), num_samples, TIMING_VARIANCE);
+    ASSERT_EQ(samples, expected) << num_samples << " samples";
+  }
+
+  std::mt19937 m_random{0x4D495846};
+  Mixer m_mixer{SAMPLE_RATE};
+  ReferenceFifo m_dma{SAMPLE_RATE, Mixer::FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
+  ReferenceFifo m_streaming{SAMPLE_RATE, Mixer::FIXED_SAMPLE_RATE_DIVIDEND / 48000, false};
+};
+}  // namespace
+
+TEST_F(MixerTest, MatchesReference)
+{
+  m_mixer.SetStreamingVolume(200, 100);
+  m_streaming.SetVolume(200, 100);
+
+  // Push and mix in uneven amounts, so that the fifos wrap around and sometimes run out.
+  for (u32 i = 0; i < 300; i++)
+  {
+    PushDMA(160 + i % 7);
+    if (i % 3 != 0)
+      PushStreaming(240 + i % 5);
+    ExpectSameMix(200 + (i * 37) % 400);
+  }
+
+  // Once the fifos have run out, the last sample is repeated.
+  ExpectSameMix(1000);
+}
+
+TEST_F(MixerTest, ClampsSum)
+{
+  for (u32 i = 0; i < 20; i++)
+  {
+    PushDMA(256, 32767);
+    PushStreaming(384, 32767);
+
+    std::vector<short> samples(256 * 2);
+    m_mixer.Mix(samples.data(), 256);
+    for (short sample : samples)
+      ASSERT_GE(sample, -32767);
+  }
+}
+
+TEST_F(MixerTest, OfflineIgnoresSettingsAndWallClockMixing)
+{
+  constexpr u32 NUM_ITERATIONS = 100;
+
+  // Render with the default settings first.
+  std::vector<std::vector<short>> dma_samples(NUM_ITERATIONS);
+  std::vector<std::vector<short>> expected(NUM_ITERATIONS);
+  for (u32 i = 0; i < NUM_ITERATIONS; i++)
+  {
+    dma_samples[i] = RandomSamples(256 + i % 11);
+    m_mixer.PushSamples(dma_samples[i].data(), static_cast<u32>(dma_samples[i].size() / 2));
+
+    const u32 num_samples = 384 + i % 13;
+    expected[i].resize(num_samples * 2);
+    EXPECT_EQ(m_mixer.MixOffline(expected[i].data(), num_samples), num_samples);
+  }
+
+  // Then render the same pushes again while changing every setting that affects wall clock mixing,
+  // and while an audio device pulls samples from the same mixer.
+  Config::Init();
+  {
+    Mixer mixer{SAMPLE_RATE};
+    std::vector<short> samples;
+    std::vector<short> wall_clock_samples(300 * 2);
+    for (u32 i = 0; i < NUM_ITERATIONS; i++)
+    {
+      Config::SetCurrent(Config::MAIN_EMULATION_SPEED, i % 2 == 0 ? 0.5f : 2.0f);
+      Config::SetCurrent(Config::MAIN_TIMING_VARIANCE, static_cast<int>(10 + (i * 37) % 190));
+      Config::SetCurrent(Config::MAIN_AUDIO_LOW_LATENCY, i % 3 == 0);
+
+      mixer.PushSamples(dma_samples[i].data(), static_cast<u32>(dma_samples[i].size() / 2));
+      // Until the first offline mix, the samples still go to the audio device.
+      if (i != 0)
+      {
+        EXPECT_EQ(mixer.Mix(wall_clock_samples.data(), 300), 300u);
+        EXPECT_TRUE(std::all_of(wall_clock_samples.begin(), wall_clock_samples.end(),
+                                [](short sample) { return sample == 0; }));
+      }
+
+      samples.resize(expected[i].size());
+      const u32 num_samples = static_cast<u32>(samples.size() / 2);
+      EXPECT_EQ(mixer.MixOffline(samples.data(), num_samples), num_samples);
+      ASSERT_EQ(samples, expected[i]) << "iteration " << i;
+    }
+  }
+  Config::Shutdown();
+}
+
+TEST(NullSound, RenderOfflineCarriesRemainder)
+{
+  const std::string user_directory = File::CreateTempDir();
+  ASSERT_FALSE(user_directory.empty());
+  UICommon::SetUserDirectory(user_directory);
+  Config::Init();
+  SConfig::Init();
+
+  // Emulated time advances in steps that are rarely a whole number of samples, and once goes back
+  // like it does when a savestate is loaded. Only whole samples are rendered, and the rest is
+  // carried over to the next call.
+  constexpr u32 TICKS_PER_SECOND = 486000000;
+  u64 forward_ticks = 0;
+  u32 sample_rate = 0;
+  {
+    NullSound stream(true);
+    ASSERT_TRUE(stream.Init());
+    sample_rate = stream.GetMixer()->GetSampleRate();
+    u64 ticks = 1000000;
+    stream.RenderOffline(ticks, TICKS_PER_SECOND);
+    for (u32 i = 0; i < 1000; i++)
+    {
+      const u64 step = (i * 7919) % 100000 + 1;
+      ticks += step;
+      forward_ticks += step;
+      stream.RenderOffline(ticks, TICKS_PER_SECOND);
+      if (i == 500)
+      {
+        ticks -= 50000;
+        stream.RenderOffline(ticks, TICKS_PER_SECOND);
+      }
+    }
+  }
+
+  const u64 expected_samples = forward_ticks * sample_rate / TICKS_PER_SECOND;
+  const std::string filename = File::GetUserPath(D_DUMPAUDIO_IDX) + "_mixdump.wav";
+  constexpr u64 WAVE_HEADER_SIZE = 44;
+  EXPECT_EQ(File::GetSize(filename), WAVE_HEADER_SIZE + expected_samples * 4);
+
+  SConfig::Shutdown();
+  Config::Shutdown();
+  File::DeleteDirRecursively(user_directory);
+}
+
+// Compares the time taken to mix a typical callback's worth of samples against the previous code,
+// with DMA and streaming audio playing and the other fifos idle. Run with
+// --gtest_also_run_disabled_tests.
+TEST_F(MixerTest, DISABLED_Throughput)
+{
+  constexpr u32 NUM_CALLBACKS = 100000;
+  constexpr u32 CALLBACK_SAMPLES = 512;
+
+  using Clock = std::chrono::steady_clock;
+  const auto to_ms = [](Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+
+  const std::vector<short> dma_samples = RandomSamples(CALLBACK_SAMPLES * 2 / 3);
+  const std::vector<short> streaming_samples = RandomSamples(CALLBACK_SAMPLES);
+  std::vector<short> samples(CALLBACK_SAMPLES * 2);
+  const u32 num_dma = static_cast<u32>(dma_samples.size() / 2);
+  const u32 num_streaming = static_cast<u32>(streaming_samples.size() / 2);
+
+  Clock::duration duration{};
+  for (u32 i = 0; i < NUM_CALLBACKS; i++)
+  {
+    m_mixer.PushSamples(dma_samples.data(), num_dma);
+    m_mixer.PushStreamingSamples(streaming_samples.data(), num_streaming);
+    const auto start = Clock::now();
+    m_mixer.Mix(samples.data(), CALLBACK_SAMPLES);
+    duration += Clock::now() - start;
+  }
+  const double mix_ms = to_ms(duration);
+
+  std::array<ReferenceFifo, 5> idle_fifos{
+      ReferenceFifo{SAMPLE_RATE, Mixer::FIXED_SAMPLE_RATE_DIVIDEND / 3000, true},
+      ReferenceFifo{SAMPLE_RATE, Mixer::FIXED_SAMPLE_RATE_DIVIDEND / 48000, true},
+      ReferenceFifo{SAMPLE_RATE, Mixer::FIXED_SAMPLE_RATE_DIVIDEND / 48000, true},
+      ReferenceFifo{SAMPLE_RATE, Mixer::FIXED_SAMPLE_RATE_DIVIDEND / 48000, true},
+      ReferenceFifo{SAMPLE_RATE, Mixer::FIXED_SAMPLE_RATE_DIVIDEND / 48000, true},
+  };
+  duration = {};
+  for (u32 i = 0; i < NUM_CALLBACKS; i++)
+  {
+    m_dma.PushSamples(dma_samples.data(), num_dma);
+    m_streaming.PushSamples(streaming_samples.data(), num_streaming);
+    const auto start = Clock::now();
+    std::fill(samples.begin(), samples.end(), 0);
+    m_dma.Mix(samples.data(), CALLBACK_SAMPLES, TIMING_VARIANCE);
+    m_streaming.Mix(samples.data(), CALLBACK_SAMPLES, TIMING_VARIANCE);
+    for (ReferenceFifo& fifo : idle_fifos)
+      fifo.Mix(samples.data(), CALLBACK_SAMPLES, TIMING_VARIANCE);
+    duration += Clock::now() - start;
+  }
+  const double reference_ms = to_ms(duration);
+
+  fmt::print("Mixing {} samples: {:.3f} us per callback, previously: {:.3f} us\n",
+             CALLBACK_SAMPLES, mix_ms * 1000 / NUM_CALLBACKS, reference_ms * 1000 / NUM_CALLBACKS);
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+static std::vector<u8> MakeHashInput(size_t size)
+{
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = static_cast<u8>(i * 97 + (i >> 8));
+  return data;
+}
+
+TEST(Hash, FullHash64KnownValues)
+{
+  // The SIMD and generic implementations must agree, as texture hashes are compared across runs.
+  static constexpr std::array<std::pair<size_t, u64>, 7> expected = {{
+      {0, 0xaa6873775cfc5e38},
+      {3, 0x3e27ca7904452163},
+      {64, 0xa71306667dadd5e9},
+      {100, 0x853e740a8a2b5d45},
+      {1024, 0x755c5cb652bbed38},
+      {1025, 0xe8310b9d7393b68e},
+      {5000, 0xcf903c2f664fba9b},
+  }};
+
+  const std::vector<u8> data = MakeHashInput(5000);
+  for (const auto& [len, hash] : expected)
+    EXPECT_EQ(hash, Common::GetFullHash64(data.data(), len)) << "len " << len;
+}
+
+TEST(Hash, FullHash64CoversEveryByte)
+{
+  for (size_t len : {5, 64, 200, 2100})
+  {
+    std::vector<u8> data = MakeHashInput(len);
+    const u64 original_hash = Common::GetFullHash64(data.data(), len);
+    for (size_t i = 0; i < len; i++)
+    {
+      data[i] ^= 0x10;
+      EXPECT_NE(original_hash, Common::GetFullHash64(data.data(), len))
+          << "len " << len << " byte " << i;
+      data[i] ^= 0x10;
+    }
+  }
+}
+
+TEST(Hash, FullHash64DependsOnLength)
+{
+  const std::vector<u8> data(128, 0);
+  EXPECT_NE(Common::GetFullHash64(data.data(), 7), Common::GetFullHash64(data.data(), 8));
+  EXPECT_NE(Common::GetFullHash64(data.data(), 64), Common::GetFullHash64(data.data(), 65));
+}
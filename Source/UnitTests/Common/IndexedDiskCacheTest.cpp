@@ -0,0 +1,260 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IndexedDiskCache.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+using Key = std::array<u32, 8>;
+
+Key MakeKey(u32 i)
+{
+  // Spread the keys out, so that they are not appended in sorted order.
+  return {i * 0x9E3779B1u, i, 0, 0, 0, 0, 0, ~i};
+}
+
+std::vector<u8> MakeValue(u32 i, size_t size)
+{
+  std::vector<u8> value(size);
+  for (size_t j = 0; j < size; j++)
+    value[j] = static_cast<u8>(i * 31 + j);
+  return value;
+}
+
+class IndexedDiskCacheTest : public testing::Test
+{
+protected:
+  IndexedDiskCacheTest()
+      : m_directory(File::CreateTempDir()), m_filename(m_directory + "/test.cache")
+  {
+  }
+
+  ~IndexedDiskCacheTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  void ExpectValue(const IndexedDiskCache<Key, u8>& cache, u32 i, size_t size)
+  {
+    u32 value_size = 0;
+    const u8* value = cache.Lookup(MakeKey(i), &value_size);
+    ASSERT_NE(value, nullptr) << "key " << i;
+    ASSERT_EQ(value_size, size);
+    EXPECT_EQ(std::vector<u8>(value, value + value_size), MakeValue(i, size));
+  }
+
+  const std::string m_directory;
+  const std::string m_filename;
+};
+}  // namespace
+
+TEST_F(IndexedDiskCacheTest, AppendedEntriesAreFoundAfterReopening)
+{
+  IndexedDiskCache<Key, u8> cache;
+  EXPECT_EQ(cache.Open(m_filename), 0u);
+  for (u32 i = 0; i < 100; i++)
+    cache.Append(MakeKey(i), MakeValue(i, i).data(), i);
+
+  // Entries appended since opening are known to exist, but can't be looked up yet.
+  EXPECT_TRUE(cache.Contains(MakeKey(5)));
+  u32 value_size;
+  EXPECT_EQ(cache.Lookup(MakeKey(5), &value_size), nullptr);
+
+  cache.Close();
+  EXPECT_EQ(cache.Open(m_filename), 100u);
+  for (u32 i = 0; i < 100; i++)
+    ExpectValue(cache, i, i);
+  EXPECT_FALSE(cache.Contains(MakeKey(100)));
+}
+
+TEST_F(IndexedDiskCacheTest, LogIsMergedWithIndex)
+{
+  IndexedDiskCache<Key, u8> cache;
+  cache.Open(m_filename);
+  for (u32 i = 0; i < 100; i++)
+    cache.Append(MakeKey(i), MakeValue(i, 16).data(), 16);
+  cache.Close();
+
+  // Few enough entries that the file is not compacted on close, so they stay in the log.
+  cache.Open(m_filename);
+  for (u32 i = 100; i < 110; i++)
+    cache.Append(MakeKey(i), MakeValue(i, 16).data(), 16);
+  cache.Close();
+
+  EXPECT_EQ(cache.Open(m_filename), 110u);
+  for (u32 i = 0; i < 110; i++)
+    ExpectValue(cache, i, 16);
+
+  ASSERT_TRUE(cache.Compact());
+  EXPECT_EQ(File::GetSize(m_filename + ".tmp"), 0u);
+  for (u32 i = 0; i < 110; i++)
+    ExpectValue(cache, i, 16);
+}
+
+TEST_F(IndexedDiskCacheTest, ReplacedValuesAreDroppedByCompaction)
+{
+  IndexedDiskCache<Key, u8> cache;
+  cache.Open(m_filename);
+  for (u32 i = 0; i < 10; i++)
+    cache.Append(MakeKey(i), MakeValue(i + 1000, 64).data(), 64);
+  for (u32 i = 0; i < 10; i++)
+    cache.Append(MakeKey(i), MakeValue(i, 32).data(), 32);
+  cache.Close();
+
+  const u64 compacted_size = File::GetSize(m_filename);
+  EXPECT_EQ(cache.Open(m_filename), 10u);
+  for (u32 i = 0; i < 10; i++)
+    ExpectValue(cache, i, 32);
+
+  // Nothing left to compact.
+  cache.Close();
+  EXPECT_EQ(File::GetSize(m_filename), compacted_size);
+}
+
+TEST_F(IndexedDiskCacheTest, IncompleteLogRecordIsIgnored)
+{
+  IndexedDiskCache<Key, u8> cache;
+  cache.Open(m_filename);
+  for (u32 i = 0; i < 100; i++)
+    cache.Append(MakeKey(i), MakeValue(i, 16).data(), 16);
+  cache.Close();
+  cache.Open(m_filename);
+  cache.Append(MakeKey(100), MakeValue(100, 16).data(), 16);
+  cache.Sync();
+  const u64 size = File::GetSize(m_filename);
+  cache.Close();
+
+  // Cut off the record number of the last record.
+  {
+    File::IOFile file(m_filename, "r+b");
+    file.Resize(size - 1);
+  }
+
+  EXPECT_EQ(cache.Open(m_filename), 100u);
+  EXPECT_FALSE(cache.Contains(MakeKey(100)));
+  cache.Append(MakeKey(101), MakeValue(101, 16).data(), 16);
+  cache.Close();
+
+  EXPECT_EQ(cache.Open(m_filename), 101u);
+  ExpectValue(cache, 101, 16);
+}
+
+TEST_F(IndexedDiskCacheTest, InvalidFileIsRecreated)
+{
+  {
+    File::IOFile file(m_filename, "wb");
+    file.WriteString("not a cache file");
+  }
+
+  IndexedDiskCache<Key, u8> cache;
+  EXPECT_EQ(cache.Open(m_filename), 0u);
+  cache.Append(MakeKey(1), MakeValue(1, 8).data(), 8);
+  cache.Close();
+  EXPECT_EQ(cache.Open(m_filename), 1u);
+  ExpectValue(cache, 1, 8);
+}
+
+TEST_F(IndexedDiskCacheTest, IndexEntryPastEndOfFileIsRejected)
+{
+  IndexedDiskCache<Key, u8> cache;
+  cache.Open(m_filename);
+  for (u32 i = 0; i < 10; i++)
+    cache.Append(MakeKey(i), MakeValue(i, 16).data(), 16);
+  ASSERT_TRUE(cache.Compact());
+  cache.Close();
+
+  // Point the first index entry at an offset where adding the value size wraps around. The 64 byte
+  // header is followed by the index entries, which are the key, the value size and the offset.
+  {
+    File::IOFile file(m_filename, "r+b");
+    const u64 value_offset = ~u64{0} - 7;
+    ASSERT_TRUE(file.Seek(64 + sizeof(Key) + sizeof(u32), File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteBytes(&value_offset, sizeof(value_offset)));
+  }
+
+  EXPECT_EQ(cache.Open(m_filename), 0u);
+}
+
+// Compares the time taken to open a cache of 100k entries in this format against
+// LinearDiskCache, which reads every value when opening. Run with
+// --gtest_also_run_disabled_tests.
+TEST_F(IndexedDiskCacheTest, DISABLED_OpenBenchmark)
+{
+  constexpr u32 NUM_ENTRIES = 100000;
+  constexpr size_t VALUE_SIZE = 512;
+  const std::string linear_filename = m_directory + "/linear.cache";
+
+  {
+    LinearDiskCache<Key, u8> linear_cache;
+    IndexedDiskCache<Key, u8> indexed_cache;
+    class NullReader : public LinearDiskCacheReader<Key, u8>
+    {
+    public:
+      void Read(const Key&, const u8*, u32) override {}
+    } null_reader;
+
+    linear_cache.OpenAndRead(linear_filename, null_reader);
+    indexed_cache.Open(m_filename);
+    for (u32 i = 0; i < NUM_ENTRIES; i++)
+    {
+      const std::vector<u8> value = MakeValue(i, VALUE_SIZE);
+      linear_cache.Append(MakeKey(i), value.data(), VALUE_SIZE);
+      indexed_cache.Append(MakeKey(i), value.data(), VALUE_SIZE);
+    }
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto to_ms = [](Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+
+  class CountingReader : public LinearDiskCacheReader<Key, u8>
+  {
+  public:
+    void Read(const Key&, const u8* value, u32 value_size) override { sum += value[value_size / 2]; }
+    u64 sum = 0;
+  } counting_reader;
+
+  auto start = Clock::now();
+  {
+    LinearDiskCache<Key, u8> linear_cache;
+    EXPECT_EQ(linear_cache.OpenAndRead(linear_filename, counting_reader), NUM_ENTRIES);
+  }
+  const double linear_ms = to_ms(Clock::now() - start);
+
+  start = Clock::now();
+  double indexed_open_ms;
+  {
+    IndexedDiskCache<Key, u8> indexed_cache;
+    EXPECT_EQ(indexed_cache.Open(m_filename), NUM_ENTRIES);
+    indexed_open_ms = to_ms(Clock::now() - start);
+
+    // Looking up a few entries, as a game would at startup, only touches their pages.
+    u32 value_size;
+    for (u32 i = 0; i < NUM_ENTRIES; i += NUM_ENTRIES / 100)
+      EXPECT_NE(indexed_cache.Lookup(MakeKey(i), &value_size), nullptr);
+  }
+  const double indexed_ms = to_ms(Clock::now() - start);
+
+  fmt::print("LinearDiskCache open and read: {:.2f} ms\n", linear_ms);
+  fmt::print("IndexedDiskCache open: {:.2f} ms, with 100 lookups and close: {:.2f} ms\n",
+             indexed_open_ms, indexed_ms);
+}
@@ -5,14 +5,21 @@
 
 #include <array>
 #include <bitset>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/NullSoundStream.h"
+#include "Common/ChunkFile.h"
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 #include "UICommon/UICommon.h"
@@ -126,6 +133,35 @@ TEST(CoreTiming, BasicOrder)
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
 
+TEST(CoreTiming, TicksUntilEvent)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& system = Core::System::GetInstance();
+  auto& core_timing = system.GetCoreTiming();
+
+  CoreTiming::EventType* cb_a = core_timing.RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = core_timing.RegisterEvent("callbackB", CallbackTemplate<1>);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  core_timing.ScheduleEvent(1000, cb_a, CB_IDS[0]);
+  EXPECT_FALSE(core_timing.GetTicksUntilEvent(cb_b).has_value());
+  std::optional<s64> ticks_left = core_timing.GetTicksUntilEvent(cb_a);
+  ASSERT_TRUE(ticks_left.has_value());
+  EXPECT_EQ(1000, *ticks_left);
+
+  PowerPC::ppcState.downcount = 700;  // Pretend we executed 300 cycles of instructions.
+  ticks_left = core_timing.GetTicksUntilEvent(cb_a);
+  ASSERT_TRUE(ticks_left.has_value());
+  EXPECT_EQ(700, *ticks_left);
+
+  core_timing.RemoveEvent(cb_a);
+  EXPECT_FALSE(core_timing.GetTicksUntilEvent(cb_a).has_value());
+}
+
 namespace SharedSlotTest
 {
 static unsigned int s_counter = 0;
@@ -391,3 +427,54 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, OfflineAudioRenderContinuesAfterStateLoad)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& system = Core::System::GetInstance();
+  auto& core_timing = system.GetCoreTiming();
+
+  // Make a savestate of the event queue while nothing is scheduled, like one made without
+  // rendering audio offline.
+  std::vector<u8> state;
+  {
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    core_timing.DoState(p_measure);
+    state.resize(reinterpret_cast<size_t>(ptr));
+    ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Write);
+    core_timing.DoState(p);
+    ASSERT_TRUE(p.IsWriteMode());
+  }
+
+  system.SetSoundStream(std::make_unique<NullSound>(true));
+  SystemTimers::Init();
+  const u32 sample_rate = system.GetSoundStream()->GetMixer()->GetSampleRate();
+
+  {
+    u8* ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Read);
+    core_timing.DoState(p);
+    ASSERT_TRUE(p.IsReadMode());
+  }
+  SystemTimers::AfterStateLoad();
+
+  // Run 20 ms of emulated time. Only the render event is scheduled.
+  const u64 end_ticks = core_timing.GetTicks() + SystemTimers::GetTicksPerSecond() / 50;
+  while (core_timing.GetTicks() < end_ticks)
+  {
+    PowerPC::ppcState.downcount = 0;
+    core_timing.Advance();
+  }
+
+  SystemTimers::Shutdown();
+  system.SetSoundStream(nullptr);
+
+  // The first millisecond only starts the render.
+  const std::string filename = File::GetUserPath(D_DUMPAUDIO_IDX) + "_mixdump.wav";
+  constexpr u64 WAVE_HEADER_SIZE = 44;
+  EXPECT_GE(File::GetSize(filename), WAVE_HEADER_SIZE + sample_rate / 1000 * 19 * 4);
+}
@@ -0,0 +1,238 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+
+#define AX_GC
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+constexpr u32 FRAME_SAMPLES = 32;
+
+// The mixing and resampling code as it was before it was vectorized, one sample at a time.
+void ReferenceMixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
+{
+  u16& volume = vd->volume;
+  const u16 volume_delta = ramp ? vd->volume_delta : 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+    *dpop = (s16)sample;
+  }
+}
+
+u32 ReferenceResample(std::function<s16(u32)> input_callback, s16* output, u32 count,
+                      s16* last_samples, u32 curr_pos, u32 ratio, const s16* coeffs)
+{
+  u32 read_samples_count = 0;
+  s16 temp[4];
+  u32 idx = 0;
+  for (u32 i = 0; i < 4; i++)
+    temp[idx++ & 3] = last_samples[i];
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    while (curr_pos >= 0x10000)
+    {
+      temp[idx++ & 3] = input_callback(read_samples_count++);
+      curr_pos -= 0x10000;
+    }
+
+    if (coeffs)
+    {
+      const s16* c = &coeffs[((curr_pos & 0xFFFF) >> 9) << 2];
+      s64 samp = 0;
+      for (u32 tap = 0; tap < 4; tap++)
+        samp += s64(temp[(idx + tap) & 3]) * c[tap];
+      output[i] = MathUtil::SaturatingCast<s16>(samp >> 15);
+      continue;
+    }
+
+    const u16 curr_frac = curr_pos & 0xFFFF;
+    const u16 inv_curr_frac = -curr_frac;
+    const s32 s0 = temp[idx & 3];
+    const s32 s1 = temp[(idx + 1) & 3];
+    output[i] = curr_frac ? s16(((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16) : s16(s0);
+  }
+
+  for (u32 i = 4; i > 0; i--)
+    last_samples[i - 1] = temp[--idx & 3];
+  return curr_pos;
+}
+
+class AXVoiceTest : public testing::Test
+{
+protected:
+  // Mostly random samples, with a few at the limits of the range.
+  std::vector<s16> RandomSamples(size_t count)
+  {
+    std::uniform_int_distribution<int> sample(-32768, 32767);
+    std::uniform_int_distribution<int> extreme(0, 15);
+    std::vector<s16> samples(count);
+    for (s16& s : samples)
+    {
+      const int kind = extreme(m_random);
+      s = kind == 0 ? -32768 : kind == 1 ? 32767 : static_cast<s16>(sample(m_random));
+    }
+    return samples;
+  }
+
+  u16 RandomU16() { return static_cast<u16>(m_random()); }
+
+  std::mt19937 m_random{0x41584158};
+};
+}  // namespace
+
+TEST_F(AXVoiceTest, MixAddMatchesReference)
+{
+  for (u32 count = 0; count <= FRAME_SAMPLES; count++)
+  {
+    for (int iteration = 0; iteration < 100; iteration++)
+    {
+      const std::vector<s16> input = RandomSamples(count);
+      std::vector<int> out(count);
+      for (int& value : out)
+        value = static_cast<s32>(m_random());
+      std::vector<int> expected_out = out;
+
+      VolumeData vd{RandomU16(), RandomU16()};
+      VolumeData expected_vd = vd;
+      s16 dpop = 123;
+      s16 expected_dpop = dpop;
+      const bool ramp = iteration % 2 == 0;
+
+      MixAdd(out.data(), input.data(), count, &vd, &dpop, ramp);
+      ReferenceMixAdd(expected_out.data(), input.data(), count, &expected_vd, &expected_dpop,
+                      ramp);
+
+      ASSERT_EQ(out, expected_out) << "count " << count;
+      ASSERT_EQ(vd.volume, expected_vd.volume);
+      ASSERT_EQ(dpop, expected_dpop);
+    }
+  }
+}
+
+TEST_F(AXVoiceTest, ResampleMatchesReference)
+{
+  const std::vector<s16> coeffs = RandomSamples(0x200);
+  std::uniform_int_distribution<u32> ratio_distribution(0x1000, 0x40000);
+
+  for (const s16* coeffs_ptr : {static_cast<const s16*>(nullptr), coeffs.data()})
+  {
+    for (int iteration = 0; iteration < 1000; iteration++)
+    {
+      const u32 ratio = ratio_distribution(m_random);
+      const std::vector<s16> input = RandomSamples(FRAME_SAMPLES * ((ratio >> 16) + 1) + 1);
+      const std::vector<s16> initial_last_samples = RandomSamples(4);
+      const u32 curr_pos = RandomU16();
+
+      std::array<s16, FRAME_SAMPLES> output;
+      std::array<s16, FRAME_SAMPLES> expected_output;
+      std::array<s16, 4> last_samples;
+      std::array<s16, 4> expected_last_samples;
+      std::copy_n(initial_last_samples.begin(), 4, last_samples.begin());
+      std::copy_n(initial_last_samples.begin(), 4, expected_last_samples.begin());
+
+      const int srctype = coeffs_ptr ? SRCTYPE_POLYPHASE : SRCTYPE_LINEAR;
+      const u32 pos = ResampleAudio([&input](u32 i) { return input[i]; }, output.data(),
+                                    FRAME_SAMPLES, last_samples.data(), curr_pos, ratio, srctype,
+                                    coeffs_ptr);
+      const u32 expected_pos = ReferenceResample(
+          [&input](u32 i) { return input[i]; }, expected_output.data(), FRAME_SAMPLES,
+          expected_last_samples.data(), curr_pos, ratio, coeffs_ptr);
+
+      ASSERT_EQ(output, expected_output) << "ratio " << ratio;
+      ASSERT_EQ(last_samples, expected_last_samples);
+      ASSERT_EQ(pos, expected_pos);
+    }
+  }
+}
+
+// Compares the time taken to mix and resample a frame of 64 voices against the previous scalar
+// code. Run with --gtest_also_run_disabled_tests.
+TEST_F(AXVoiceTest, DISABLED_Throughput)
+{
+  constexpr u32 NUM_VOICES = 64;
+  constexpr u32 NUM_CHANNELS = 9;
+  constexpr u32 NUM_FRAMES = 20000;
+
+  using Clock = std::chrono::steady_clock;
+  const auto to_ms = [](Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+
+  const std::vector<s16> input = RandomSamples(FRAME_SAMPLES * 4);
+  const std::vector<s16> coeffs = RandomSamples(0x200);
+  std::vector<int> out(NUM_CHANNELS * FRAME_SAMPLES);
+  std::array<s16, FRAME_SAMPLES> samples;
+  std::array<s16, 4> last_samples{};
+  VolumeData vd{0x4000, 3};
+  s16 dpop;
+
+  const auto mix_frame = [&](auto mix) {
+    for (u32 voice = 0; voice < NUM_VOICES; voice++)
+    {
+      for (u32 channel = 0; channel < NUM_CHANNELS; channel++)
+        mix(&out[channel * FRAME_SAMPLES], input.data(), FRAME_SAMPLES, &vd, &dpop, true);
+    }
+  };
+
+  auto start = Clock::now();
+  for (u32 frame = 0; frame < NUM_FRAMES; frame++)
+    mix_frame(MixAdd);
+  const double mix_ms = to_ms(Clock::now() - start);
+
+  start = Clock::now();
+  for (u32 frame = 0; frame < NUM_FRAMES; frame++)
+    mix_frame(ReferenceMixAdd);
+  const double reference_mix_ms = to_ms(Clock::now() - start);
+
+  fmt::print("Mixing {} voices to {} channels: {:.3f} us per frame, scalar: {:.3f} us\n",
+             NUM_VOICES, NUM_CHANNELS, mix_ms * 1000 / NUM_FRAMES,
+             reference_mix_ms * 1000 / NUM_FRAMES);
+
+  for (const s16* coeffs_ptr : {static_cast<const s16*>(nullptr), coeffs.data()})
+  {
+    const int srctype = coeffs_ptr ? SRCTYPE_POLYPHASE : SRCTYPE_LINEAR;
+    start = Clock::now();
+    for (u32 frame = 0; frame < NUM_FRAMES * NUM_VOICES; frame++)
+    {
+      ResampleAudio([&input](u32 i) { return input[i]; }, samples.data(), FRAME_SAMPLES,
+                    last_samples.data(), 0, 0x12345, srctype, coeffs_ptr);
+    }
+    const double resample_ms = to_ms(Clock::now() - start);
+
+    start = Clock::now();
+    for (u32 frame = 0; frame < NUM_FRAMES * NUM_VOICES; frame++)
+    {
+      ReferenceResample([&input](u32 i) { return input[i]; }, samples.data(), FRAME_SAMPLES,
+                        last_samples.data(), 0, 0x12345, coeffs_ptr);
+    }
+    const double reference_resample_ms = to_ms(Clock::now() - start);
+
+    fmt::print("{} resampling of {} voices: {:.3f} us per frame, scalar: {:.3f} us\n",
+               coeffs_ptr ? "Polyphase" : "Linear", NUM_VOICES, resample_ms * 1000 / NUM_FRAMES,
+               reference_resample_ms * 1000 / NUM_FRAMES);
+  }
+}
@@ -0,0 +1,281 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/DSPHLE/DSPHLE.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
+#include "Core/HW/DSPHLE/UCodes/AXWii.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+using DSP::HLE::AXVoiceWorkers;
+
+namespace
+{
+constexpr u32 NUM_BUFFERS = 3;
+constexpr std::array<u32, NUM_BUFFERS> BUFFER_SIZES = {160, 96, 18};
+
+using Buffers = std::array<std::vector<int>, NUM_BUFFERS>;
+
+Buffers MakeBuffers(u32 seed)
+{
+  std::mt19937 random(seed);
+  Buffers buffers;
+  for (u32 i = 0; i < NUM_BUFFERS; i++)
+  {
+    buffers[i].resize(BUFFER_SIZES[i]);
+    for (int& sample : buffers[i])
+      sample = static_cast<s16>(random());
+  }
+  return buffers;
+}
+
+// Mixes the voices to buffers holding some samples already, and returns the result.
+Buffers Mix(AXVoiceWorkers& workers, size_t num_voices)
+{
+  Buffers buffers = MakeBuffers(0);
+  std::array<AXVoiceWorkers::MixBuffer, NUM_BUFFERS> mix_buffers;
+  for (u32 i = 0; i < NUM_BUFFERS; i++)
+    mix_buffers[i] = {buffers[i].data(), BUFFER_SIZES[i]};
+
+  workers.Run(num_voices, mix_buffers, [](size_t voice, int* const* voice_buffers) {
+    const Buffers samples = MakeBuffers(static_cast<u32>(voice) + 1);
+    for (u32 i = 0; i < NUM_BUFFERS; i++)
+    {
+      // Voices don't always mix to every buffer.
+      if ((voice + i) % 3 == 0)
+        continue;
+      for (u32 j = 0; j < BUFFER_SIZES[i]; j++)
+        voice_buffers[i][j] += samples[i][j];
+    }
+  });
+  return buffers;
+}
+
+// Sets up a Wii with the memory and DSP state that AX HLE needs.
+class WiiScopeInit final
+{
+public:
+  WiiScopeInit() : m_profile_path(File::CreateTempDir())
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    SConfig::GetInstance().bWii = true;
+    auto& system = Core::System::GetInstance();
+    system.GetCoreTiming().Init();
+    system.GetMemory().Init();
+    DSP::Init(true);
+  }
+  ~WiiScopeInit()
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    auto& system = Core::System::GetInstance();
+    DSP::Shutdown();
+    system.GetMemory().Shutdown();
+    system.GetCoreTiming().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+  bool UserDirectoryExists() const { return !m_profile_path.empty(); }
+
+private:
+  std::string m_profile_path;
+};
+
+// A version of AXWii which still has updates in its PBs, and processes them one ms at a time.
+constexpr u32 OLD_AXWII_CRC = 0xfa450138;
+constexpr u32 MAIL_CMDLIST = 0xBABE0000;
+
+constexpr u32 NUM_VOICES = 16;
+constexpr u32 NUM_VOICE_SAMPLES = 0x400;
+constexpr u32 CMDLIST_ADDR = 0x00100000;
+constexpr u32 INIT_ADDR = 0x00101000;
+constexpr u32 UPDATES_ADDR = 0x00102000;
+constexpr u32 LR_ADDR = 0x00103000;
+constexpr u32 SURROUND_ADDR = 0x00104000;
+constexpr u32 WM_ADDR = 0x00105000;
+constexpr u32 WM_SIZE = 6 * 3 * sizeof(u16);
+constexpr u32 PB_ADDR = 0x00110000;
+constexpr u32 PB_SIZE = 0x200;
+constexpr u32 SAMPLES_ADDR = 0x00200000;
+
+// Writes a PB list of voices playing looped PCM16 samples to the main buffers and to all Wiimote
+// buffers, in the old AXWii layout with an (empty) update list after the initial time delay.
+void WriteOldAXWiiVoices(Memory::MemoryManager& memory)
+{
+  std::mt19937 random(0x41585749);
+  std::uniform_int_distribution<int> distribution(-2000, 2000);
+  for (u32 i = 0; i < NUM_VOICES * NUM_VOICE_SAMPLES; i++)
+    memory.Write_U16(static_cast<u16>(distribution(random)), SAMPLES_ADDR + i * sizeof(u16));
+
+  for (u32 voice = 0; voice < NUM_VOICES; voice++)
+  {
+    DSP::HLE::AXPBWii pb{};
+    const u32 addr = PB_ADDR + voice * PB_SIZE;
+    const u32 next_addr = voice + 1 < NUM_VOICES ? addr + PB_SIZE : 0;
+    pb.next_pb_hi = static_cast<u16>(next_addr >> 16);
+    pb.next_pb_lo = static_cast<u16>(next_addr);
+    pb.this_pb_hi = static_cast<u16>(addr >> 16);
+    pb.this_pb_lo = static_cast<u16>(addr);
+    pb.src_type = DSP::HLE::SRCTYPE_LINEAR;
+    pb.mixer_control_lo = 0x3;  // Main left and right
+    pb.running = 1;
+    pb.mixer.main_left.volume = 0x3000;
+    pb.mixer.main_right.volume = 0x2000;
+    pb.vol_env.cur_volume = 0x7000;
+
+    const u32 start = SAMPLES_ADDR / sizeof(u16) + voice * NUM_VOICE_SAMPLES;
+    const u32 end = start + NUM_VOICE_SAMPLES - 1;
+    pb.audio_addr.looping = 1;
+    pb.audio_addr.sample_format = DSP::HLE::AUDIOFORMAT_PCM16;
+    pb.audio_addr.loop_addr_hi = static_cast<u16>(start >> 16);
+    pb.audio_addr.loop_addr_lo = static_cast<u16>(start);
+    pb.audio_addr.end_addr_hi = static_cast<u16>(end >> 16);
+    pb.audio_addr.end_addr_lo = static_cast<u16>(end);
+    pb.audio_addr.cur_addr_hi = static_cast<u16>(start >> 16);
+    pb.audio_addr.cur_addr_lo = static_cast<u16>(start + voice * 7);
+    // Voices play at different rates.
+    pb.src.ratio_hi = 1;
+    pb.src.ratio_lo = static_cast<u16>(voice * 0x800);
+
+    pb.remote = 1;
+    pb.remote_mixer_control = 0x5555;  // All Wiimote buffers, without ramps
+    for (DSP::HLE::VolumeData* vd :
+         {&pb.remote_mixer.main0, &pb.remote_mixer.aux0, &pb.remote_mixer.main1,
+          &pb.remote_mixer.aux1, &pb.remote_mixer.main2, &pb.remote_mixer.aux2,
+          &pb.remote_mixer.main3, &pb.remote_mixer.aux3})
+    {
+      vd->volume = static_cast<u16>(0x1000 + voice * 0x100);
+    }
+
+    // Insert the update fields: three update counts and the address of the updates.
+    std::array<u16, sizeof(pb) / sizeof(u16)> pb_mem;
+    std::memcpy(pb_mem.data(), &pb, sizeof(pb));
+    std::array<u16, sizeof(pb) / sizeof(u16)> old_pb_mem{};
+    std::copy_n(pb_mem.begin(), 41, old_pb_mem.begin());
+    old_pb_mem[44] = static_cast<u16>(UPDATES_ADDR >> 16);
+    old_pb_mem[45] = static_cast<u16>(UPDATES_ADDR);
+    std::copy(pb_mem.begin() + 41, pb_mem.end() - 5, old_pb_mem.begin() + 46);
+    memory.CopyToEmuSwapped(addr, old_pb_mem.data(), sizeof(old_pb_mem));
+  }
+}
+
+struct AXWiiOutput
+{
+  std::vector<u8> main;
+  std::vector<u8> wiimote;
+  std::vector<u8> pbs;
+};
+
+// Runs a command list processing the voices through an old AXWii, and returns what it wrote.
+AXWiiOutput RunOldAXWii(u32 num_worker_threads)
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  memory.Memset(0, 0, SAMPLES_ADDR);
+  WriteOldAXWiiVoices(memory);
+
+  std::vector<u16> cmdlist;
+  const auto push_addr = [&cmdlist](u32 addr) {
+    cmdlist.push_back(static_cast<u16>(addr >> 16));
+    cmdlist.push_back(static_cast<u16>(addr));
+  };
+  cmdlist.push_back(0x00);  // Setup
+  push_addr(INIT_ADDR);
+  cmdlist.push_back(0x04);  // PB address
+  push_addr(PB_ADDR);
+  cmdlist.push_back(0x05);  // Process
+  cmdlist.push_back(0x0E);  // Wiimote output
+  for (u32 i = 0; i < 4; i++)
+    push_addr(WM_ADDR + i * WM_SIZE);
+  cmdlist.push_back(0x0C);  // Output
+  push_addr(SURROUND_ADDR);
+  push_addr(LR_ADDR);
+  cmdlist.push_back(0x0F);  // End
+  memory.CopyToEmuSwapped(CMDLIST_ADDR, cmdlist.data(), cmdlist.size() * sizeof(u16));
+
+  Config::SetCurrent(Config::MAIN_DSP_HLE_VOICE_THREADS, static_cast<int>(num_worker_threads));
+  auto* dsphle = static_cast<DSP::HLE::DSPHLE*>(DSP::GetDSPEmulator());
+  DSP::HLE::AXWiiUCode ucode(dsphle, OLD_AXWII_CRC);
+  ucode.HandleMail(MAIL_CMDLIST | static_cast<u32>(cmdlist.size()));
+  ucode.HandleMail(CMDLIST_ADDR);
+
+  AXWiiOutput output;
+  output.main.resize(WM_ADDR - LR_ADDR);
+  memory.CopyFromEmu(output.main.data(), LR_ADDR, output.main.size());
+  output.wiimote.resize(4 * WM_SIZE);
+  memory.CopyFromEmu(output.wiimote.data(), WM_ADDR, output.wiimote.size());
+  output.pbs.resize(NUM_VOICES * PB_SIZE);
+  memory.CopyFromEmu(output.pbs.data(), PB_ADDR, output.pbs.size());
+  return output;
+}
+}  // namespace
+
+TEST(AXVoiceWorkers, MatchesSerialMixing)
+{
+  AXVoiceWorkers serial;
+  AXVoiceWorkers parallel;
+  parallel.ResizeWorkerThreads(3);
+
+  for (size_t num_voices : {0, 1, 7, 8, 9, 64, 200})
+  {
+    const Buffers expected = Mix(serial, num_voices);
+    for (int run = 0; run < 10; run++)
+      EXPECT_EQ(Mix(parallel, num_voices), expected) << num_voices << " voices";
+  }
+}
+
+TEST(AXVoiceWorkers, Resize)
+{
+  AXVoiceWorkers workers;
+  const Buffers expected = Mix(workers, 64);
+
+  for (u32 num_threads : {1, 4, 0, 2})
+  {
+    workers.ResizeWorkerThreads(num_threads);
+    EXPECT_EQ(workers.HasWorkerThreads(), num_threads != 0);
+    EXPECT_EQ(Mix(workers, 64), expected) << num_threads << " threads";
+  }
+}
+
+TEST(AXVoiceWorkers, OldAXWiiMatchesSerialMixing)
+{
+  WiiScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  const AXWiiOutput expected = RunOldAXWii(0);
+  EXPECT_NE(expected.wiimote, std::vector<u8>(expected.wiimote.size()));
+
+  for (u32 num_threads : {1, 3})
+  {
+    const AXWiiOutput output = RunOldAXWii(num_threads);
+    EXPECT_EQ(output.main, expected.main) << num_threads << " threads";
+    EXPECT_EQ(output.wiimote, expected.wiimote) << num_threads << " threads";
+    EXPECT_EQ(output.pbs, expected.pbs) << num_threads << " threads";
+  }
+}
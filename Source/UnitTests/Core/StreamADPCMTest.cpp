@@ -0,0 +1,127 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/HW/StreamADPCM.h"
+
+using namespace StreamADPCM;
+
+namespace
+{
+// The decoder as it was before it decoded whole blocks, one sample and channel at a time.
+s16 ReferenceDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+{
+  s32 hist = 0;
+  switch (q >> 4)
+  {
+  case 0:
+    hist = 0;
+    break;
+  case 1:
+    hist = (hist1 * 0x3c);
+    break;
+  case 2:
+    hist = (hist1 * 0x73) - (hist2 * 0x34);
+    break;
+  case 3:
+    hist = (hist1 * 0x62) - (hist2 * 0x37);
+    break;
+  }
+  hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
+
+  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+
+  hist2 = hist1;
+  hist1 = cur;
+
+  cur >>= 6;
+  cur = std::clamp(cur, -0x8000, 0x7fff);
+
+  return (s16)cur;
+}
+
+class ReferenceDecoder
+{
+public:
+  void DecodeBlock(s16* pcm, const u8* adpcm)
+  {
+    for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+    {
+      pcm[i * 2] = ReferenceDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf,
+                                         adpcm[0], m_histl1, m_histl2);
+      pcm[i * 2 + 1] = ReferenceDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4,
+                                             adpcm[1], m_histr1, m_histr2);
+    }
+  }
+
+private:
+  s32 m_histl1 = 0;
+  s32 m_histl2 = 0;
+  s32 m_histr1 = 0;
+  s32 m_histr2 = 0;
+};
+
+// Random blocks, whose headers go through every value, including the unused filters 4-15.
+std::vector<u8> RandomBlocks(size_t num_blocks)
+{
+  std::mt19937 random(0x44544B00);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<u8> adpcm(num_blocks * ONE_BLOCK_SIZE);
+  for (u8& byte : adpcm)
+    byte = static_cast<u8>(distribution(random));
+  for (size_t i = 0; i < num_blocks; i++)
+  {
+    adpcm[i * ONE_BLOCK_SIZE] = static_cast<u8>(i);
+    adpcm[i * ONE_BLOCK_SIZE + 1] = static_cast<u8>(~i);
+  }
+  return adpcm;
+}
+}  // namespace
+
+TEST(StreamADPCM, DecodeBlockMatchesReference)
+{
+  constexpr size_t NUM_BLOCKS = 4096;
+  const std::vector<u8> adpcm = RandomBlocks(NUM_BLOCKS);
+
+  ADPCMDecoder decoder;
+  ReferenceDecoder reference;
+  for (size_t i = 0; i < NUM_BLOCKS; i++)
+  {
+    std::array<s16, SAMPLES_PER_BLOCK * 2> pcm;
+    std::array<s16, SAMPLES_PER_BLOCK * 2> expected;
+    decoder.DecodeBlock(pcm.data(), &adpcm[i * ONE_BLOCK_SIZE]);
+    reference.DecodeBlock(expected.data(), &adpcm[i * ONE_BLOCK_SIZE]);
+    ASSERT_EQ(pcm, expected) << "block " << i;
+  }
+}
+
+TEST(StreamADPCM, DecodeBlocksBE)
+{
+  constexpr size_t NUM_BLOCKS = 64;
+  const std::vector<u8> adpcm = RandomBlocks(NUM_BLOCKS);
+
+  ADPCMDecoder decoder;
+  ReferenceDecoder reference;
+  std::vector<s16> pcm(NUM_BLOCKS * SAMPLES_PER_BLOCK * 2);
+  std::vector<s16> expected(NUM_BLOCKS * SAMPLES_PER_BLOCK * 2);
+  // Decode in two parts, so that the filter has to carry over between calls.
+  decoder.DecodeBlocksBE(pcm.data(), adpcm.data(), NUM_BLOCKS / 2);
+  decoder.DecodeBlocksBE(&pcm[NUM_BLOCKS / 2 * SAMPLES_PER_BLOCK * 2],
+                         &adpcm[NUM_BLOCKS / 2 * ONE_BLOCK_SIZE], NUM_BLOCKS / 2);
+  for (size_t i = 0; i < NUM_BLOCKS; i++)
+  {
+    reference.DecodeBlock(&expected[i * SAMPLES_PER_BLOCK * 2], &adpcm[i * ONE_BLOCK_SIZE]);
+  }
+  for (s16& sample : expected)
+    sample = Common::swap16(sample);
+
+  EXPECT_EQ(pcm, expected);
+}
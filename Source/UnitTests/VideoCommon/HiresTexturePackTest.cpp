@@ -0,0 +1,95 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+
+namespace
+{
+class HiresTexturePackTest : public testing::Test
+{
+protected:
+  HiresTexturePackTest()
+      : m_directory(File::CreateTempDir()), m_textures(m_directory + "/textures"),
+        m_pack(m_directory + "/GALE01.texpack")
+  {
+  }
+
+  ~HiresTexturePackTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  void WriteTexture(const std::string& path, const std::string& contents)
+  {
+    ASSERT_TRUE(File::CreateFullPath(m_textures + "/" + path));
+    ASSERT_TRUE(File::WriteStringToFile(m_textures + "/" + path, contents));
+  }
+
+  const std::string m_directory;
+  const std::string m_textures;
+  const std::string m_pack;
+};
+
+std::string ToString(const HiresTexturePack::Entry& entry)
+{
+  return std::string(entry.data.begin(), entry.data.end());
+}
+}  // namespace
+
+TEST_F(HiresTexturePackTest, ContainsTexturesOfDirectory)
+{
+  WriteTexture("tex1_64x64_0123456789abcdef_5.png", "first");
+  WriteTexture("sub/tex1_64x64_0123456789abcdef_5_mip1.png", "second");
+  WriteTexture("sub/dir/tex1_32x32_fedcba9876543210_14_arb.dds", "third");
+  WriteTexture("not_a_texture.png", "ignored");
+  WriteTexture("tex1_readme.txt", "ignored");
+
+  ASSERT_TRUE(HiresTexturePack::Create(m_textures, m_pack));
+
+  HiresTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_pack));
+  const std::vector<HiresTexturePack::Entry>& entries = pack.GetEntries();
+  ASSERT_EQ(entries.size(), 3u);
+
+  // Entries are sorted by name.
+  EXPECT_EQ(entries[0].name, "tex1_32x32_fedcba9876543210_14");
+  EXPECT_TRUE(entries[0].has_arbitrary_mipmaps);
+  EXPECT_EQ(ToString(entries[0]), "third");
+
+  EXPECT_EQ(entries[1].name, "tex1_64x64_0123456789abcdef_5");
+  EXPECT_FALSE(entries[1].has_arbitrary_mipmaps);
+  EXPECT_EQ(ToString(entries[1]), "first");
+
+  EXPECT_EQ(entries[2].name, "tex1_64x64_0123456789abcdef_5_mip1");
+  EXPECT_FALSE(entries[2].has_arbitrary_mipmaps);
+  EXPECT_EQ(ToString(entries[2]), "second");
+}
+
+TEST_F(HiresTexturePackTest, RejectsTruncatedPack)
+{
+  WriteTexture("tex1_64x64_0123456789abcdef_5.png", "first");
+  ASSERT_TRUE(HiresTexturePack::Create(m_textures, m_pack));
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(m_pack, contents));
+  contents.resize(contents.size() - 1);
+  ASSERT_TRUE(File::WriteStringToFile(m_pack, contents));
+
+  HiresTexturePack pack;
+  EXPECT_FALSE(pack.Open(m_pack));
+  EXPECT_TRUE(pack.GetEntries().empty());
+}
@@ -0,0 +1,251 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr u16 RESTART = UINT16_MAX;
+
+struct PrimitiveType
+{
+  Primitive primitive;
+  std::string_view name;
+};
+
+constexpr std::array<PrimitiveType, 8> PRIMITIVES = {{
+    {Primitive::GX_DRAW_QUADS, "quads"},
+    {Primitive::GX_DRAW_QUADS_2, "quads 2"},
+    {Primitive::GX_DRAW_TRIANGLES, "triangles"},
+    {Primitive::GX_DRAW_TRIANGLE_STRIP, "triangle strip"},
+    {Primitive::GX_DRAW_TRIANGLE_FAN, "triangle fan"},
+    {Primitive::GX_DRAW_LINES, "lines"},
+    {Primitive::GX_DRAW_LINE_STRIP, "line strip"},
+    {Primitive::GX_DRAW_POINTS, "points"},
+}};
+
+// Generates the indices of a primitive one at a time, to check the generator against.
+class ReferenceIndices
+{
+public:
+  ReferenceIndices(u16* buffer, bool primitive_restart, bool vs_expand)
+      : m_buffer(buffer), m_current(buffer), m_primitive_restart(primitive_restart),
+        m_vs_expand(vs_expand)
+  {
+  }
+
+  void Add(Primitive primitive, u32 num_verts, u32 base)
+  {
+    switch (primitive)
+    {
+    case Primitive::GX_DRAW_QUADS:
+    case Primitive::GX_DRAW_QUADS_2:
+      for (u32 i = 0; i + 4 <= num_verts; i += 4)
+      {
+        if (m_primitive_restart)
+          Strip({base + i + 1, base + i + 2, base + i, base + i + 3});
+        else
+          Append({base + i, base + i + 1, base + i + 2, base + i, base + i + 2, base + i + 3});
+      }
+      if (num_verts % 4 == 3)
+        Triangle(base + num_verts - 3, base + num_verts - 2, base + num_verts - 1);
+      break;
+    case Primitive::GX_DRAW_TRIANGLES:
+      for (u32 i = 0; i + 3 <= num_verts; i += 3)
+        Triangle(base + i, base + i + 1, base + i + 2);
+      break;
+    case Primitive::GX_DRAW_TRIANGLE_STRIP:
+      if (m_primitive_restart)
+      {
+        for (u32 i = 0; i < num_verts; i++)
+          Append({base + i});
+        Append({RESTART});
+        break;
+      }
+      for (u32 i = 2; i < num_verts; i++)
+      {
+        if (i % 2 == 0)
+          Triangle(base + i - 2, base + i - 1, base + i);
+        else
+          Triangle(base + i - 2, base + i, base + i - 1);
+      }
+      break;
+    case Primitive::GX_DRAW_TRIANGLE_FAN:
+    {
+      u32 i = 2;
+      if (m_primitive_restart)
+      {
+        for (; i + 3 <= num_verts; i += 3)
+          Strip({base + i - 1, base + i, base, base + i + 1, base + i + 2});
+        for (; i + 2 <= num_verts; i += 2)
+          Strip({base + i - 1, base + i, base, base + i + 1});
+      }
+      for (; i < num_verts; i++)
+        Triangle(base, base + i - 1, base + i);
+      break;
+    }
+    case Primitive::GX_DRAW_LINES:
+    case Primitive::GX_DRAW_LINE_STRIP:
+    {
+      const u32 advance = primitive == Primitive::GX_DRAW_LINES ? 2 : 1;
+      for (u32 i = 1; i < num_verts; i += advance)
+      {
+        const u32 p0 = (base + i - 1) << 2;
+        const u32 p1 = (base + i) << 2;
+        if (!m_vs_expand)
+          Append({base + i - 1, base + i});
+        else if (m_primitive_restart)
+          Strip({p0, p0 + 1, p1 + 2, p1 + 3});
+        else
+          Append({p0, p0 + 1, p1 + 2, p0 + 1, p1 + 2, p1 + 3});
+      }
+      break;
+    }
+    case Primitive::GX_DRAW_POINTS:
+      for (u32 i = 0; i < num_verts; i++)
+      {
+        const u32 p = (base + i) << 2;
+        if (!m_vs_expand)
+          Append({base + i});
+        else if (m_primitive_restart)
+          Strip({p, p + 1, p + 2, p + 3});
+        else
+          Append({p, p + 1, p + 2, p + 1, p + 2, p + 3});
+      }
+      break;
+    }
+  }
+
+  u32 GetIndexLen() const { return static_cast<u32>(m_current - m_buffer); }
+
+private:
+  void Append(std::initializer_list<u32> indices)
+  {
+    for (u32 index : indices)
+      *m_current++ = static_cast<u16>(index);
+  }
+
+  void Triangle(u32 a, u32 b, u32 c)
+  {
+    Append({a, b, c});
+    if (m_primitive_restart)
+      Append({RESTART});
+  }
+
+  void Strip(std::initializer_list<u32> indices)
+  {
+    Append(indices);
+    Append({RESTART});
+  }
+
+  u16* m_buffer;
+  u16* m_current;
+  bool m_primitive_restart;
+  bool m_vs_expand;
+};
+
+class IndexGeneratorTest : public testing::TestWithParam<std::tuple<bool, bool>>
+{
+protected:
+  void SetUp() override
+  {
+    const auto [primitive_restart, vs_expand] = GetParam();
+    g_Config.backend_info.bSupportsPrimitiveRestart = primitive_restart;
+    g_Config.backend_info.bSupportsVSLinePointExpand = vs_expand;
+    g_Config.backend_info.bSupportsGeometryShaders = false;
+    m_generator.Init();
+  }
+
+  // Each vertex can make at most 6 indices, plus a primitive restart per primitive.
+  static constexpr size_t MaxIndices(u32 num_verts) { return num_verts * 7 + 8; }
+
+  IndexGenerator m_generator;
+};
+}  // namespace
+
+TEST_P(IndexGeneratorTest, MatchesReference)
+{
+  const auto [primitive_restart, vs_expand] = GetParam();
+
+  for (const PrimitiveType& type : PRIMITIVES)
+  {
+    // Draw several primitives into the same buffer, so that they don't start at index 0.
+    for (u32 num_verts = 0; num_verts <= 100; num_verts++)
+    {
+      std::vector<u16> buffer(MaxIndices(num_verts + 2) * 3);
+      std::vector<u16> expected(buffer.size());
+      m_generator.Start(buffer.data());
+      ReferenceIndices reference(expected.data(), primitive_restart, vs_expand);
+      for (u32 draw = 0; draw < 3; draw++)
+      {
+        reference.Add(type.primitive, num_verts + draw, m_generator.GetNumVerts());
+        m_generator.AddIndices(type.primitive, num_verts + draw);
+      }
+
+      buffer.resize(m_generator.GetIndexLen());
+      expected.resize(reference.GetIndexLen());
+      EXPECT_EQ(buffer, expected) << type.name << " with " << num_verts << " vertices";
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllConfigs, IndexGeneratorTest,
+                         testing::Combine(testing::Bool(), testing::Bool()));
+
+// Compares the throughput of the generator against generating the indices one at a time, for each
+// primitive type. Run with --gtest_also_run_disabled_tests.
+TEST_P(IndexGeneratorTest, DISABLED_Throughput)
+{
+  const auto [primitive_restart, vs_expand] = GetParam();
+  constexpr u32 NUM_VERTS = 1020;
+  constexpr u32 NUM_DRAWS = 10000;
+
+  using Clock = std::chrono::steady_clock;
+  const auto to_ms = [](Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+
+  fmt::print("primitive restart: {}, VS expand: {}\n", primitive_restart, vs_expand);
+  std::vector<u16> buffer(MaxIndices(NUM_VERTS));
+  for (const PrimitiveType& type : PRIMITIVES)
+  {
+    if (type.primitive == Primitive::GX_DRAW_QUADS_2)
+      continue;
+
+    auto start = Clock::now();
+    for (u32 draw = 0; draw < NUM_DRAWS; draw++)
+    {
+      m_generator.Start(buffer.data());
+      m_generator.AddIndices(type.primitive, NUM_VERTS);
+    }
+    const double generator_ms = to_ms(Clock::now() - start);
+    const u32 num_indices = m_generator.GetIndexLen();
+
+    start = Clock::now();
+    for (u32 draw = 0; draw < NUM_DRAWS; draw++)
+    {
+      ReferenceIndices reference(buffer.data(), primitive_restart, vs_expand);
+      reference.Add(type.primitive, NUM_VERTS, 0);
+      EXPECT_EQ(reference.GetIndexLen(), num_indices);
+    }
+    const double reference_ms = to_ms(Clock::now() - start);
+
+    const double million_indices = static_cast<double>(num_indices) * NUM_DRAWS / 1e6;
+    fmt::print("  {:<15} {:8.1f} M indices/s, one at a time: {:8.1f} M indices/s\n", type.name,
+               million_indices / (generator_ms / 1000), million_indices / (reference_ms / 1000));
+  }
+}
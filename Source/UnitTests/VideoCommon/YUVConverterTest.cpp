@@ -0,0 +1,130 @@
+// Copyright 2026 Dolphin Triforce Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/YUVConverter.h"
+
+namespace
+{
+struct Image
+{
+  u32 width;
+  u32 height;
+  std::vector<u8> rgba;
+};
+
+struct YUVImage
+{
+  YUVImage(u32 width, u32 height)
+      : y(width * height), u((width + 1) / 2 * ((height + 1) / 2)), v(u.size()),
+        planes{y.data(), u.data(), v.data(), width, (width + 1) / 2, (width + 1) / 2}
+  {
+  }
+
+  std::vector<u8> y;
+  std::vector<u8> u;
+  std::vector<u8> v;
+  VideoCommon::YUV420Planes planes;
+};
+
+Image MakeImage(u32 width, u32 height)
+{
+  Image image{width, height, std::vector<u8>(width * height * 4)};
+  u32 state = 12345;
+  for (u8& value : image.rgba)
+  {
+    state = state * 1103515245 + 12345;
+    value = static_cast<u8>(state >> 16);
+  }
+
+  // Include the extremes of every component.
+  for (u32 i = 0; i < std::min<size_t>(image.rgba.size(), 64); i++)
+    image.rgba[i] = (i / 4) % 2 == 0 ? 0 : 255;
+  return image;
+}
+
+// Straightforward per-sample version of the conversion, to compare the optimized paths against.
+void ReferenceConvert(const Image& image, YUVImage* out)
+{
+  const auto pixel = [&](u32 x, u32 y, u32 c) {
+    x = std::min(x, image.width - 1);
+    y = std::min(y, image.height - 1);
+    return static_cast<int>(image.rgba[(y * image.width + x) * 4 + c]);
+  };
+
+  for (u32 y = 0; y < image.height; y++)
+  {
+    for (u32 x = 0; x < image.width; x++)
+    {
+      const int r = pixel(x, y, 0), g = pixel(x, y, 1), b = pixel(x, y, 2);
+      out->y[y * image.width + x] = static_cast<u8>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    }
+  }
+
+  const u32 chroma_width = (image.width + 1) / 2;
+  for (u32 cy = 0; cy < (image.height + 1) / 2; cy++)
+  {
+    for (u32 cx = 0; cx < chroma_width; cx++)
+    {
+      int average[3];
+      for (u32 c = 0; c < 3; c++)
+      {
+        average[c] = (pixel(cx * 2, cy * 2, c) + pixel(cx * 2 + 1, cy * 2, c) +
+                      pixel(cx * 2, cy * 2 + 1, c) + pixel(cx * 2 + 1, cy * 2 + 1, c) + 2) >>
+                     2;
+      }
+      const int r = average[0], g = average[1], b = average[2];
+      out->u[cy * chroma_width + cx] =
+          static_cast<u8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      out->v[cy * chroma_width + cx] =
+          static_cast<u8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+  }
+}
+
+void ExpectEqual(const YUVImage& a, const YUVImage& b)
+{
+  EXPECT_EQ(a.y, b.y);
+  EXPECT_EQ(a.u, b.u);
+  EXPECT_EQ(a.v, b.v);
+}
+}  // namespace
+
+TEST(YUVConverter, MatchesReference)
+{
+  // Odd sizes and widths that aren't a multiple of the SIMD width cover the edge handling.
+  for (const auto& [width, height] : {std::pair<u32, u32>{64, 32}, {37, 21}, {1, 1}, {17, 2}})
+  {
+    const Image image = MakeImage(width, height);
+    YUVImage expected(width, height);
+    ReferenceConvert(image, &expected);
+
+    YUVImage actual(width, height);
+    VideoCommon::ConvertRGBAToYUV420Rows(image.rgba.data(), width * 4, width, height, 0, height,
+                                         actual.planes);
+    ExpectEqual(actual, expected);
+  }
+}
+
+TEST(YUVConverter, SplitConversionMatchesReference)
+{
+  constexpr u32 WIDTH = 643;
+  constexpr u32 HEIGHT = 481;
+  const Image image = MakeImage(WIDTH, HEIGHT);
+  YUVImage expected(WIDTH, HEIGHT);
+  ReferenceConvert(image, &expected);
+
+  VideoCommon::YUVConverter converter;
+  converter.ResizeWorkerThreads(3);
+  for (u32 i = 0; i < 4; i++)
+  {
+    YUVImage actual(WIDTH, HEIGHT);
+    converter.ConvertRGBAToYUV420(image.rgba.data(), WIDTH * 4, WIDTH, HEIGHT, actual.planes);
+    ExpectEqual(actual, expected);
+  }
+}